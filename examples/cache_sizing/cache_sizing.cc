@@ -0,0 +1,109 @@
+// Measure the hit rate of the cache of homomorphisms against its memory footprint.
+//
+// Usage: cache_sizing [nb_rings] [nb_poles]
+//
+// The state space of the Hanoi towers is computed several times, with caches of increasing sizes.
+// For each size, the footprint of the cache, its hit rate and the time are reported. The smallest
+// size after which the hit rate stops improving is a good choice for this kind of model.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include "sdd/sdd.hh"
+
+#include "examples/hanoi/hanoi.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using conf   = sdd::conf2;
+using SDD    = sdd::SDD<conf>;
+using hom    = sdd::homomorphism<conf>;
+using Values = conf::Values;
+
+using sdd::fixpoint;
+using sdd::id;
+using sdd::inductive;
+using sdd::sum;
+
+/*------------------------------------------------------------------------------------------------*/
+
+int
+main(int argc, char** argv)
+{
+  // The default number of rings
+  unsigned int nb_rings = 10;
+  if (argc >= 2)
+  {
+    nb_rings = atoi(argv[1]);
+  }
+
+  // The default number of poles
+  unsigned int nb_poles = 3;
+  if (argc >= 3)
+  {
+    nb_poles = atoi(argv[2]);
+  }
+
+  std::cout << std::setw(10) << "size" << std::setw(10) << "bytes" << std::setw(12) << "footprint"
+            << std::setw(10) << "hit rate" << std::setw(12) << "discarded"
+            << std::setw(10) << "time" << '\n';
+
+  for (std::size_t size = 1000; size <= 10'000'000; size *= 10)
+  {
+    auto configuration = conf();
+    configuration.hom_cache_size = size;
+    auto manager = sdd::init(configuration);
+
+    /// Order
+    sdd::order_builder<conf> ob;
+    for (unsigned int i = 0; i < nb_rings; ++i)
+    {
+      ob.push(i);
+    }
+    sdd::order<conf> o(ob);
+
+    /// Initial state
+    SDD m0(o, [](unsigned int){return Values {0};});
+
+    /// Events
+    std::set<hom> union_swap_pole;
+    for (unsigned int i = 0; i < nb_rings; ++i)
+    {
+      for (unsigned int source = 0; source < nb_poles; ++source)
+      {
+        for (unsigned int destination = 0; destination < nb_poles; ++destination)
+        {
+          if (source != destination)
+          {
+            union_swap_pole.insert(inductive<conf>(swap_pole<conf>(i, source, destination)));
+          }
+        }
+      }
+    }
+
+    union_swap_pole.insert(id<conf>());
+    hom events = fixpoint(sum(o, union_swap_pole.begin(), union_swap_pole.end()));
+    events = sdd::rewrite(o, events);
+
+    const auto start = std::chrono::system_clock::now();
+    SDD sat_final = events(o, m0);
+    const auto end = std::chrono::system_clock::now();
+
+    const auto& stats = manager.hom_cache_stats();
+    const auto lookups = stats.hits + stats.misses;
+    std::cout << std::setw(10) << size
+              << std::setw(10) << stats.bytes_per_entry
+              << std::setw(10) << stats.footprint / 1024 << "KB"
+              << std::setw(9) << std::fixed << std::setprecision(1)
+              << (lookups == 0 ? 0. : 100. * stats.hits / lookups) << '%'
+              << std::setw(12) << stats.discarded
+              << std::setw(8)
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms"
+              << '\n';
+  }
+
+  return 0;
+}
@@ -4,6 +4,8 @@
 
 #include "sdd/sdd.hh"
 
+#include "hanoi.hh"
+
 /*------------------------------------------------------------------------------------------------*/
 
 using conf   = sdd::conf2;
@@ -11,8 +13,6 @@ using SDD    = sdd::SDD<conf>;
 using hom    = sdd::homomorphism<conf>;
 using Values = conf::Values;
 
-using sdd::cons;
-using sdd::constant;
 using sdd::fixpoint;
 using sdd::id;
 using sdd::inductive;
@@ -20,163 +20,6 @@ using sdd::sum;
 
 /*------------------------------------------------------------------------------------------------*/
 
-struct no_ring_above
-{
-  const unsigned int i;
-  const unsigned int j;
-
-  no_ring_above(int _i, int _j)
-    : i(_i<_j?_i:_j)
-    , j(_i<_j?_j:_i)
-  {}
-
-  bool
-  skip(unsigned char)
-  const noexcept
-  {
-    return false;
-  }
-
-  hom
-  operator()(const sdd::order<conf>&, const SDD&)
-  const noexcept
-  {
-    // no hierarchy
-    assert(false);
-    __builtin_unreachable();
-  }
-
-  hom
-  operator()(const sdd::order<conf>& o, const Values& val)
-  const
-  {
-    Values v(val);
-    v.erase(i);
-    v.erase(j);
-    return cons<conf>(o, std::move(v), inductive<conf>(*this));
-  }
-
-  SDD
-  operator()()
-  const noexcept
-  {
-    return sdd::one<conf>();
-  }
-
-  bool
-  operator==(const no_ring_above& other)
-  const noexcept
-  {
-    return i == other.i and j == other.j;
-  }
-};
-
-std::ostream&
-operator<<(std::ostream& os, const no_ring_above& x)
-{
-  return os << "nra(" << x.i << "," << x.j << ")";
-}
-
-/*------------------------------------------------------------------------------------------------*/
-
-struct swap_pole
-{
-
-  const unsigned int ring;
-  const unsigned int source;
-  const unsigned int destination;
-
-  swap_pole(int ring, int source, int destination)
-    : ring(ring)
-    , source(source)
-    , destination(destination)
-  {}
-
-  bool
-  skip(unsigned int var)
-  const noexcept
-  {
-    return var != ring;
-  }
-
-  hom
-  operator()(const sdd::order<conf>&, const SDD&)
-  const noexcept
-  {
-    // no hierarchy
-    assert(false);
-    __builtin_unreachable();
-  }
-
-  hom
-  operator()(const sdd::order<conf>& o, const Values& val)
-  const
-  {
-    if (val.find(source) == val.cend())
-    {
-      return constant<conf>(sdd::zero<conf>());
-    }
-    else
-    {
-      return cons<conf>( o
-                       , Values {destination}
-                       , inductive<conf>(no_ring_above(source,destination)));
-    }
-  }
-
-  SDD
-  operator()()
-  const noexcept
-  {
-    return sdd::one<conf>();
-  }
-
-  bool
-  operator==(const swap_pole& other)
-  const noexcept
-  {
-    return ring == other.ring and source == other.source and destination == other.destination;
-  }
-};
-
-std::ostream&
-operator<<(std::ostream& os, const swap_pole& x)
-{
-  return os << "swap_pole(" << x.ring << "," << x.source << "," << x.destination << ")";
-}
-
-/*------------------------------------------------------------------------------------------------*/
-
-namespace std {
-
-template <>
-struct hash<no_ring_above>
-{
-  std::size_t
-  operator()(const no_ring_above& x)
-  const noexcept
-  {
-    using namespace sdd::hash;
-    return seed() (val(x.i)) (val(x.j));
-  }
-};
-
-template <>
-struct hash<swap_pole>
-{
-  std::size_t
-  operator()(const swap_pole& x)
-  const noexcept
-  {
-    using namespace sdd::hash;
-    return seed() (val(x.ring)) (val(x.source)) (val(x.destination));
-  }
-};
-
-} // namespace std
-
-/*------------------------------------------------------------------------------------------------*/
-
 int
 main(int argc, char** argv)
 {
@@ -217,7 +60,7 @@ main(int argc, char** argv)
       {
         if (source != destination)
         {
-          union_swap_pole.insert(inductive<conf>(swap_pole(i, source, destination)));
+          union_swap_pole.insert(inductive<conf>(swap_pole<conf>(i, source, destination)));
         }
       }
     }
@@ -234,8 +77,8 @@ main(int argc, char** argv)
   start = std::chrono::system_clock::now();
   SDD sat_final = events(o, m0);
   end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::seconds>(end-start).count();
-  std::cout << "Time: " << elapsed << "s" << std::endl;
+  elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
+  std::cout << "Time: " << elapsed << "ms" << std::endl;
   // Number of distinct paths
   std::cout << "Number of states : " << sat_final.size() << std::endl;
 
@@ -0,0 +1,175 @@
+// The inductive homomorphisms of the Hanoi towers, shared by the examples which compute their state
+// space.
+//
+// A variable is a ring, its values are the poles it may be on.
+
+#pragma once
+
+#include <cassert>
+#include <ostream>
+#include <utility> // move
+
+#include "sdd/sdd.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct no_ring_above
+{
+  const unsigned int i;
+  const unsigned int j;
+
+  no_ring_above(int _i, int _j)
+    : i(_i<_j?_i:_j)
+    , j(_i<_j?_j:_i)
+  {}
+
+  bool
+  skip(unsigned char)
+  const noexcept
+  {
+    return false;
+  }
+
+  sdd::homomorphism<C>
+  operator()(const sdd::order<C>&, const sdd::SDD<C>&)
+  const noexcept
+  {
+    // no hierarchy
+    assert(false);
+    __builtin_unreachable();
+  }
+
+  sdd::homomorphism<C>
+  operator()(const sdd::order<C>& o, const typename C::Values& val)
+  const
+  {
+    typename C::Values v(val);
+    v.erase(i);
+    v.erase(j);
+    return sdd::cons<C>(o, std::move(v), sdd::inductive<C>(*this));
+  }
+
+  sdd::SDD<C>
+  operator()()
+  const noexcept
+  {
+    return sdd::one<C>();
+  }
+
+  bool
+  operator==(const no_ring_above& other)
+  const noexcept
+  {
+    return i == other.i and j == other.j;
+  }
+};
+
+template <typename C>
+std::ostream&
+operator<<(std::ostream& os, const no_ring_above<C>& x)
+{
+  return os << "nra(" << x.i << "," << x.j << ")";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct swap_pole
+{
+
+  const unsigned int ring;
+  const unsigned int source;
+  const unsigned int destination;
+
+  swap_pole(int ring, int source, int destination)
+    : ring(ring)
+    , source(source)
+    , destination(destination)
+  {}
+
+  bool
+  skip(unsigned int var)
+  const noexcept
+  {
+    return var != ring;
+  }
+
+  sdd::homomorphism<C>
+  operator()(const sdd::order<C>&, const sdd::SDD<C>&)
+  const noexcept
+  {
+    // no hierarchy
+    assert(false);
+    __builtin_unreachable();
+  }
+
+  sdd::homomorphism<C>
+  operator()(const sdd::order<C>& o, const typename C::Values& val)
+  const
+  {
+    if (val.find(source) == val.cend())
+    {
+      return sdd::constant<C>(sdd::zero<C>());
+    }
+    else
+    {
+      return sdd::cons<C>( o
+                         , typename C::Values {destination}
+                         , sdd::inductive<C>(no_ring_above<C>(source,destination)));
+    }
+  }
+
+  sdd::SDD<C>
+  operator()()
+  const noexcept
+  {
+    return sdd::one<C>();
+  }
+
+  bool
+  operator==(const swap_pole& other)
+  const noexcept
+  {
+    return ring == other.ring and source == other.source and destination == other.destination;
+  }
+};
+
+template <typename C>
+std::ostream&
+operator<<(std::ostream& os, const swap_pole<C>& x)
+{
+  return os << "swap_pole(" << x.ring << "," << x.source << "," << x.destination << ")";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace std {
+
+template <typename C>
+struct hash<no_ring_above<C>>
+{
+  std::size_t
+  operator()(const no_ring_above<C>& x)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed() (val(x.i)) (val(x.j));
+  }
+};
+
+template <typename C>
+struct hash<swap_pole<C>>
+{
+  std::size_t
+  operator()(const swap_pole<C>& x)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed() (val(x.ring)) (val(x.source)) (val(x.destination));
+  }
+};
+
+} // namespace std
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,148 @@
+// Compare the SDD obtained with different ordering strategies.
+//
+// Usage: ordering [nb_groups] [group_size] [nb_values]
+//
+// Variables are split in groups whose variables always have the same value, and groups are linked
+// in a chain by the first and last variables of consecutive groups, which must differ. Identifiers
+// are shuffled before being given to the strategies. The set of all such assignments is built
+// with each order, and the number of nodes of the resulting SDD is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sdd/sdd.hh"
+#include "sdd/order/strategies/flatten.hh"
+#include "sdd/order/strategies/force.hh"
+#include "sdd/order/strategies/identifiers_per_hierarchy.hh"
+#include "sdd/order/strategies/multilevel_partitioning.hh"
+#include "sdd/order/strategies/reverse_cuthill_mckee.hh"
+#include "sdd/order/strategies/simulated_annealing.hh"
+#include "sdd/order/strategies/sloan.hh"
+#include "sdd/tools/nodes.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using conf   = sdd::conf1;
+using SDD    = sdd::SDD<conf>;
+using Values = conf::Values;
+
+/*------------------------------------------------------------------------------------------------*/
+
+std::string
+name(unsigned int group, unsigned int i)
+{
+  return "g" + std::to_string(group) + "_" + std::to_string(i);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Build the set of all valid assignments, group by group.
+SDD
+model(const sdd::order<conf>& o, unsigned int nb_groups, unsigned int nb_values)
+{
+  SDD res = sdd::zero<conf>();
+  std::vector<unsigned int> values(nb_groups, 0);
+  while (true)
+  {
+    bool valid = true;
+    for (unsigned int g = 1; g < nb_groups and valid; ++g)
+    {
+      valid = values[g] != values[g - 1];
+    }
+    if (valid)
+    {
+      res += SDD(o, [&](const std::string& id)
+                    {
+                      return Values {values[std::stoul(id.substr(1, id.find('_') - 1))]};
+                    });
+    }
+    // Next assignment of groups.
+    unsigned int g = 0;
+    while (g < nb_groups and ++values[g] == nb_values)
+    {
+      values[g++] = 0;
+    }
+    if (g == nb_groups)
+    {
+      break;
+    }
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+int
+main(int argc, char** argv)
+{
+  auto manager = sdd::init<conf>();
+
+  const unsigned int nb_groups = argc >= 2 ? std::stoul(argv[1]) : 7;
+  const unsigned int group_size = argc >= 3 ? std::stoul(argv[2]) : 4;
+  const unsigned int nb_values = argc >= 4 ? std::stoul(argv[3]) : 3;
+
+  std::vector<std::string> identifiers;
+  for (unsigned int g = 0; g < nb_groups; ++g)
+  {
+    for (unsigned int i = 0; i < group_size; ++i)
+    {
+      identifiers.push_back(name(g, i));
+    }
+  }
+  std::mt19937 gen(0);
+  std::shuffle(identifiers.begin(), identifiers.end(), gen);
+
+  sdd::force::hypergraph<conf> graph(identifiers.begin(), identifiers.end());
+  for (unsigned int g = 0; g < nb_groups; ++g)
+  {
+    std::vector<std::string> group;
+    for (unsigned int i = 0; i < group_size; ++i)
+    {
+      group.push_back(name(g, i));
+    }
+    graph.add_hyperedge(group.begin(), group.end());
+    if (g + 1 < nb_groups)
+    {
+      const std::vector<std::string> link {name(g, group_size - 1), name(g + 1, 0)};
+      graph.add_hyperedge(link.begin(), link.end());
+    }
+  }
+
+  std::map<std::string, sdd::order_builder<conf>> strategies;
+  strategies["shuffled"] = sdd::order_builder<conf>(identifiers.begin(), identifiers.end());
+  {
+    auto g = graph;
+    strategies["force"] = sdd::force::worker<conf>(g)(200);
+  }
+  strategies["force + identifiers_per_hierarchy"]
+    = sdd::identifiers_per_hierarchy<conf>(group_size)(strategies["force"]);
+  strategies["multilevel_partitioning"] = sdd::multilevel_partitioning<conf>(graph, group_size)();
+  strategies["reverse_cuthill_mckee"] = sdd::reverse_cuthill_mckee<conf>(graph)();
+  strategies["sloan"] = sdd::sloan<conf>(graph)();
+  strategies["simulated_annealing"] = sdd::simulated_annealing<conf>(graph)();
+
+  for (const auto& strategy : strategies)
+  {
+    const sdd::order<conf> o(strategy.second);
+    const auto start = std::chrono::system_clock::now();
+    const auto x = model(o, nb_groups, nb_values);
+    const auto end = std::chrono::system_clock::now();
+    const auto nodes = sdd::tools::nodes(x);
+    std::cout << strategy.first << '\n'
+              << "  Time: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << "ms\n"
+              << "  Number of states: " << x.size() << '\n'
+              << "  Flat nodes: " << nodes.first << '\n'
+              << "  Hierarchical nodes: " << nodes.second << '\n';
+  }
+
+  return 0;
+}
+
+/*------------------------------------------------------------------------------------------------*/
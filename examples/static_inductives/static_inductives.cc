@@ -0,0 +1,141 @@
+// Compare dynamic inductive homomorphisms with static ones (see static_inductives in
+// sdd::default_configuration).
+//
+// Usage: static_inductives [dynamic|static] [nb_rings] [nb_poles]
+//
+// The state space of the Hanoi towers is computed with a plain fixpoint, which applies the
+// inductive homomorphisms on many more nodes than a saturated one. The creation of inductive
+// homomorphisms, which happens at each arc they are applied on, is also measured on its own.
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "sdd/sdd.hh"
+
+#include "examples/hanoi/hanoi.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using sdd::fixpoint;
+using sdd::id;
+using sdd::inductive;
+using sdd::sum;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Inductive homomorphisms are wrapped behind virtual functions.
+struct dynamic_conf
+  : public sdd::conf2
+{};
+
+/// @brief Inductive homomorphisms are alternatives of homomorphisms.
+struct static_conf
+  : public sdd::conf2
+{
+  using static_inductives
+    = sdd::util::list<no_ring_above<static_conf>, swap_pole<static_conf>>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+void
+run(unsigned int nb_rings, unsigned int nb_poles)
+{
+  using SDD    = sdd::SDD<C>;
+  using hom    = sdd::homomorphism<C>;
+  using Values = typename C::Values;
+
+  auto manager = sdd::init<C>();
+
+  /// Order
+  sdd::order_builder<C> ob;
+  for (unsigned int i = 0; i < nb_rings; ++i)
+  {
+    ob.push(i);
+  }
+  sdd::order<C> o(ob);
+
+  /// Initial state
+  SDD m0(o, [](unsigned int){return Values {0};});
+
+  /// Events
+  std::set<hom> union_swap_pole;
+  for (unsigned int i = 0; i < nb_rings; ++i)
+  {
+    for (unsigned int source = 0; source < nb_poles; ++source)
+    {
+      for (unsigned int destination = 0; destination < nb_poles; ++destination)
+      {
+        if (source != destination)
+        {
+          union_swap_pole.insert(inductive<C>(swap_pole<C>(i, source, destination)));
+        }
+      }
+    }
+  }
+
+  union_swap_pole.insert(id<C>());
+  const hom events = fixpoint(sum(o, union_swap_pole.begin(), union_swap_pole.end()));
+
+  auto start = std::chrono::steady_clock::now();
+  const SDD states = events(o, m0);
+  auto end = std::chrono::steady_clock::now();
+  std::cout << "Time: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms\n"
+            << "Number of states: " << states.size() << '\n';
+
+  // The homomorphisms already exist, only their lookup in the unique table is measured.
+  start = std::chrono::steady_clock::now();
+  for (unsigned int n = 0; n < 1000; ++n)
+  {
+    for (unsigned int i = 0; i < nb_poles; ++i)
+    {
+      for (unsigned int j = 0; j < nb_poles; ++j)
+      {
+        inductive<C>(no_ring_above<C>(i, j));
+      }
+    }
+  }
+  end = std::chrono::steady_clock::now();
+  std::cout << "Creation of " << 1000 * nb_poles * nb_poles << " inductives: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+            << "us\n";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+int
+main(int argc, char** argv)
+{
+  const bool static_inductives = argc >= 2 and std::strcmp(argv[1], "static") == 0;
+
+  // The default number of rings
+  unsigned int nb_rings = 8;
+  if (argc >= 3)
+  {
+    nb_rings = atoi(argv[2]);
+  }
+
+  // The default number of poles
+  unsigned int nb_poles = 4;
+  if (argc >= 4)
+  {
+    nb_poles = atoi(argv[3]);
+  }
+
+  std::cout << "Inductives: " << (static_inductives ? "static" : "dynamic") << '\n';
+  if (static_inductives)
+  {
+    run<static_conf>(nb_rings, nb_poles);
+  }
+  else
+  {
+    run<dynamic_conf>(nb_rings, nb_poles);
+  }
+
+  return 0;
+}
@@ -0,0 +1,260 @@
+// Compare the monolithic unique table of SDD with the one partitioned by variables.
+//
+// Usage: unique_table [monolithic|partitioned] [nb_rings] [nb_poles]
+//
+// The state space of the Hanoi towers is computed with the requested unique table. On Linux, the
+// hardware cache references and misses of the computation are read with perf_event_open(2), when
+// the kernel exposes these counters.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "sdd/sdd.hh"
+
+#include "examples/hanoi/hanoi.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using conf   = sdd::conf2;
+using SDD    = sdd::SDD<conf>;
+using hom    = sdd::homomorphism<conf>;
+using Values = conf::Values;
+
+using sdd::fixpoint;
+using sdd::id;
+using sdd::inductive;
+using sdd::sum;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Count an hardware event of the current thread, in user space.
+class hardware_counter
+{
+  // Can't copy a hardware_counter.
+  hardware_counter(const hardware_counter&) = delete;
+  hardware_counter& operator=(const hardware_counter&) = delete;
+
+  /// @brief The file descriptor of the counter, -1 if unavailable.
+  int fd_;
+
+  /// @brief Why the counter is unavailable.
+  std::string error_;
+
+public:
+
+  /// @brief Open a disabled counter.
+  hardware_counter(std::uint64_t config)
+    : fd_(-1), error_("not supported on this system")
+  {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    if (fd_ < 0)
+    {
+      error_ = std::strerror(errno);
+    }
+#else
+    (void)config;
+#endif
+  }
+
+  ~hardware_counter()
+  {
+#ifdef __linux__
+    if (fd_ >= 0)
+    {
+      close(fd_);
+    }
+#endif
+  }
+
+  /// @brief Tell if the counter could be opened.
+  bool
+  available()
+  const noexcept
+  {
+    return fd_ >= 0;
+  }
+
+  /// @brief Why the counter could not be opened.
+  const std::string&
+  error()
+  const noexcept
+  {
+    return error_;
+  }
+
+  void
+  start()
+  {
+#ifdef __linux__
+    if (fd_ >= 0)
+    {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  void
+  stop()
+  {
+#ifdef __linux__
+    if (fd_ >= 0)
+    {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+  }
+
+  /// @brief Get the number of events counted between start() and stop().
+  std::uint64_t
+  value()
+  const
+  {
+    std::uint64_t res = 0;
+#ifdef __linux__
+    if (fd_ >= 0 and read(fd_, &res, sizeof(res)) != sizeof(res))
+    {
+      res = 0;
+    }
+#endif
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+int
+main(int argc, char** argv)
+{
+  auto configuration = conf();
+  if (argc >= 2 and std::strcmp(argv[1], "partitioned") == 0)
+  {
+    configuration.sdd_unique_table_partitioned = true;
+  }
+  auto manager = sdd::init(configuration);
+
+  // The default number of rings
+  unsigned int nb_rings = 10;
+  if (argc >= 3)
+  {
+    nb_rings = atoi(argv[2]);
+  }
+
+  // The default number of poles
+  unsigned int nb_poles = 3;
+  if (argc >= 4)
+  {
+    nb_poles = atoi(argv[3]);
+  }
+
+  /// Order
+  sdd::order_builder<conf> ob;
+  for (unsigned int i = 0; i < nb_rings; ++i)
+  {
+    ob.push(i);
+  }
+  sdd::order<conf> o(ob);
+
+  /// Initial state
+  SDD m0(o, [](unsigned int){return Values {0};});
+
+  /// Events
+  std::set<hom> union_swap_pole;
+  for (unsigned int i = 0; i < nb_rings; ++i)
+  {
+    for (unsigned int source = 0; source < nb_poles; ++source)
+    {
+      for (unsigned int destination = 0; destination < nb_poles; ++destination)
+      {
+        if (source != destination)
+        {
+          union_swap_pole.insert(inductive<conf>(swap_pole<conf>(i, source, destination)));
+        }
+      }
+    }
+  }
+
+  union_swap_pole.insert(id<conf>());
+  hom events = fixpoint(sum(o, union_swap_pole.begin(), union_swap_pole.end()));
+  events = sdd::rewrite(o, events);
+
+#ifdef __linux__
+  hardware_counter references(PERF_COUNT_HW_CACHE_REFERENCES);
+  hardware_counter misses(PERF_COUNT_HW_CACHE_MISSES);
+#else
+  hardware_counter references(0);
+  hardware_counter misses(0);
+#endif
+
+  references.start();
+  misses.start();
+  const auto start = std::chrono::system_clock::now();
+  SDD sat_final = events(o, m0);
+  const auto end = std::chrono::system_clock::now();
+  misses.stop();
+  references.stop();
+
+  const auto& stats = manager.sdd_stats();
+  std::cout << "Unique table: "
+            << (configuration.sdd_unique_table_partitioned ? "partitioned" : "monolithic") << '\n'
+            << "Time: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms\n"
+            << "Number of states: " << sat_final.size() << '\n'
+            << "Peak nodes: " << stats.peak << '\n'
+            << "Live nodes: " << stats.size << '\n'
+            << "Buckets: " << stats.buckets << '\n'
+            << "Load factor: " << stats.load_factor << '\n'
+            << "Collisions: " << stats.collisions << '\n'
+            << "Hits: " << stats.hits << '\n'
+            << "Misses: " << stats.misses << '\n';
+
+  if (references.available() and misses.available())
+  {
+    const auto nb_references = references.value();
+    const auto nb_misses = misses.value();
+    std::cout << "Hardware cache references: " << nb_references << '\n'
+              << "Hardware cache misses: " << nb_misses << '\n'
+              << "Hardware cache miss rate: "
+              << (nb_references == 0 ? 0 : 100.0 * nb_misses / nb_references) << "%\n";
+  }
+  else
+  {
+    std::cout << "Hardware cache misses: unavailable ("
+              << (misses.available() ? references.error() : misses.error()) << ")\n";
+  }
+
+  const auto partitions = manager.sdd_partitions_stats();
+  if (partitions.size() > 1)
+  {
+    std::cout << "Partitions (nodes/buckets/rehash/hits/misses):\n";
+    for (std::size_t i = 0; i < partitions.size(); ++i)
+    {
+      std::cout << "  " << i << ": " << partitions[i].size << '/' << partitions[i].buckets << '/'
+                << partitions[i].rehash << '/' << partitions[i].hits << '/'
+                << partitions[i].misses << '\n';
+    }
+  }
+
+  return 0;
+}
@@ -9,6 +9,7 @@
 #include <cstdint> // uint16_t, uint32_t
 #include <string>
 
+#include "sdd/util/typelist.hh"
 #include "sdd/values/bitset.hh"
 #include "sdd/values/flat_set.hh"
 
@@ -31,9 +32,32 @@ struct default_configuration
   /// @brief The type to store the number of elements in an operation.
   using operands_size_type = std::uint32_t;
 
+  /// @brief The user's inductive homomorphisms which are dispatched at compile-time.
+  ///
+  /// Types listed here, as in util::list<swap_pole, no_ring_above>, are stored inline in
+  /// homomorphisms and called without virtual functions nor heap allocation (see sdd::inductive()).
+  /// As they become alternatives of homomorphisms, they must be complete wherever an homomorphism
+  /// is created or applied. A derived configuration can be declared before them:
+  /// struct swap_pole; struct conf : conf2 {using static_inductives = util::list<swap_pole>;};
+  using static_inductives = util::list<>;
+
   /// @brief The initial size of the hash table that stores SDD.
   std::size_t sdd_unique_table_size;
 
+  /// @brief Tell if the table that stores SDD is partitioned by variables.
+  ///
+  /// Each variable then has its own hash table, which improves locality of operations that work
+  /// level by level and makes per-variable statistics and sweeping possible.
+  bool sdd_unique_table_partitioned;
+
+  /// @brief The initial size of each partition, when the table that stores SDD is partitioned.
+  ///
+  /// Partitions are created on demand, one per variable and one for terminals. Each one allocates
+  /// its buckets upfront: the size is rounded up to a power of 2 buckets of one pointer each, thus
+  /// the default size costs 8KB per partition on 64-bit platforms. A partition then grows with its
+  /// content, so a large initial size only wastes memory when there are many variables.
+  std::size_t sdd_unique_table_partition_size;
+
   /// @brief The size of the cache of SDD difference operations.
   std::size_t sdd_difference_cache_size;
 
@@ -50,19 +74,100 @@ struct default_configuration
   std::size_t hom_unique_table_size;
 
   /// @brief The size of the cache of homomorphism applications.
+  ///
+  /// All caches allocate their buckets upfront: the size is rounded up to a power of 2 buckets of
+  /// one pointer each, and 85% of it gives the number of entries, allocated at the first insertion.
+  /// An entry of this cache takes about 60 bytes on 64-bit platforms, thus the default size costs
+  /// about 60MB. Use the statistics of the cache (hits, misses, discarded, footprint) to choose a
+  /// size: when discarded entries are a small fraction of misses, a larger cache won't improve the
+  /// hit rate. See the cache_sizing example to measure this trade-off on a model.
   std::size_t hom_cache_size;
 
+  /// @brief The size of the cache of applications of user's functions (see sdd::function()), 0 to
+  /// disable it.
+  ///
+  /// A function is applied on each valuation of the arcs of its target. When it's expensive and
+  /// when the same valuations appear on many nodes, this cache makes it be applied once per
+  /// distinct valuation. Valuations are compared with ==, which is O(1) for unified values like
+  /// flat_set. This cache has its own entries, even if unified_cache is set.
+  std::size_t hom_function_cache_size;
+
+  /// @brief The size of the cache of splits of SDD by selectors.
+  ///
+  /// The predicate of an if_then_else() splits its operand in the parts it accepts and rejects.
+  /// When it supports it, both parts are computed in a single traversal, which is cached as a pair.
+  /// This cache has its own entries, even if unified_cache is set.
+  std::size_t hom_split_cache_size;
+
+  /// @brief Tell if the caches of SDD operations and of homomorphisms share their entries.
+  ///
+  /// All caches then store their entries in a single computed table of unified_cache_size entries:
+  /// when it's full, the least recently used entry is discarded, whatever its operation. Thus the
+  /// memory shifts to the operations which are the most used in the current phase of a computation,
+  /// rather than being split upfront. The sizes of the caches then only give the number of buckets
+  /// of each operation.
+  bool unified_cache;
+
+  /// @brief The number of entries of the computed table shared by all caches, if unified_cache.
+  std::size_t unified_cache_size;
+
+  /// @brief Tell if caches adapt their capacity during a computation.
+  ///
+  /// The sizes of the caches then only give their initial capacity. After a number of misses at
+  /// least equal to its capacity, a cache doubles when most misses discarded an entry, and halves
+  /// when its hit rate is under 5% or when it's mostly empty. Decisions are reported by the grown,
+  /// shrunk and denied fields of the statistics of caches.
+  ///
+  /// As resizing a cache costs O(capacity), it's not done during a lookup: caches adapt when an
+  /// operation started by the user returns, and between iterations of the outermost Fixpoint.
+  bool adaptive_caches;
+
+  /// @brief The number of bytes that caches entries can use altogether, if adaptive_caches.
+  ///
+  /// A cache never grows beyond this ceiling, but it's not enforced on initial capacities.
+  std::size_t cache_memory_ceiling;
+
+  /// @brief Tell if Saturation Fixpoints apply the most productive operands of G first.
+  ///
+  /// Operands are sorted by the number of times they produced new states, after 4, 8, 16, ...
+  /// evaluations. It may save some applications, but a new order also produces new intermediate
+  /// sets, which makes cached results useless: measure it on a model before enabling it.
+  bool saturation_reordering;
+
+  /// @brief Store one out of hom_skip_cache_period consecutive levels skipped by an homomorphism
+  /// in the cache of homomorphisms.
+  ///
+  /// An homomorphism which skips a level is applied on all the successors of this level. When the
+  /// next level is also skipped, its evaluation can go straight to the successors without storing
+  /// a pass-through operation in the cache, thus a long chain of skipped levels no longer fills the
+  /// cache. Levels which are not skipped are always cached. The results of the levels evaluated
+  /// without the cache are memoized for the time of the evaluation of the cached level above them
+  /// (see hom::evaluation::jump()): a node reached by several paths from this level is evaluated
+  /// once. It's evaluated again by each other cached evaluation that reaches it, as this
+  /// memoization is not shared: 1 caches all levels.
+  std::size_t hom_skip_cache_period;
+
   /// @brief Default constructor.
   ///
   /// Initialize all parameters to their default values.
   default_configuration()
     : sdd_unique_table_size(10'000'000)
+    , sdd_unique_table_partitioned(false)
+    , sdd_unique_table_partition_size(1024)
     , sdd_difference_cache_size(500'000)
     , sdd_intersection_cache_size(500'000)
     , sdd_sum_cache_size(1'000'000)
     , sdd_arena_size(1024*1024*16)
     , hom_unique_table_size(1'000'000)
     , hom_cache_size(1'000'000)
+    , hom_function_cache_size(0)
+    , hom_split_cache_size(100'000)
+    , unified_cache(false)
+    , unified_cache_size(3'000'000)
+    , adaptive_caches(false)
+    , cache_memory_ceiling(1024ul*1024*1024)
+    , saturation_reordering(false)
+    , hom_skip_cache_period(1)
   {}
 };
 
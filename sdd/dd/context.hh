@@ -15,6 +15,7 @@
 #include "sdd/dd/sum.hh"
 #include "sdd/mem/cache.hh"
 #include "sdd/mem/linear_alloc.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd { namespace dd {
 
@@ -57,11 +58,16 @@ private:
 public:
 
   /// @brief Create a new empty context.
+  /// @param table If not nullptr, all caches store their entries in this computed table.
+  /// @param budget If not nullptr and table is nullptr, caches adapt their capacity within it.
   context( std::size_t difference_size, std::size_t intersection_size, std::size_t sum_size
-         , std::size_t arena_size)
-    : difference_cache_{std::make_shared<difference_cache_type>(*this, difference_size)}
-    , intersection_cache_{std::make_shared<intersection_cache_type>( *this, intersection_size)}
-    , sum_cache_{std::make_shared<sum_cache_type>(*this, sum_size)}
+         , std::size_t arena_size, std::shared_ptr<mem::computed_table> table = nullptr
+         , std::shared_ptr<mem::cache_budget> budget = nullptr)
+    : difference_cache_{std::make_shared<difference_cache_type>( *this, difference_size, table
+                                                               , "difference", budget)}
+    , intersection_cache_{std::make_shared<intersection_cache_type>( *this, intersection_size, table
+                                                                   , "intersection", budget)}
+    , sum_cache_{std::make_shared<sum_cache_type>(*this, sum_size, table, "sum", budget)}
     , arena_{std::make_shared<mem::arena>(arena_size)}
   {}
 
@@ -100,11 +106,23 @@ public:
     return *arena_;
   }
 
+  /// @brief Let the caches of this context adapt their capacity, if they decided to.
+  ///
+  /// See hom::context::adapt_caches() for when it's called.
+  void
+  adapt_caches()
+  {
+    difference_cache_->adapt();
+    intersection_cache_->adapt();
+    sum_cache_->adapt();
+  }
+
   /// @brief Remove all entries from all this context's caches.
   void
   clear()
   noexcept
   {
+    trace::instant("SDD caches flush");
     difference_cache_->clear();
     intersection_cache_->clear();
     sum_cache_->clear();
@@ -10,6 +10,7 @@
 
 #include "sdd/dd/count_combinations_fwd.hh"
 #include "sdd/dd/definition.hh"
+#include "sdd/util/deep_call.hh"
 #include "sdd/values/size.hh"
 
 namespace sdd { namespace dd {
@@ -55,7 +56,7 @@ struct count_combinations_visitor
     {
       for (const auto& arc : n)
       {
-        insertion.first->second += size(arc.valuation()) * visit(*this, arc.successor());
+        insertion.first->second += size(arc.valuation()) * deep_visit(arc.successor());
       }
     }
     return insertion.first->second;
@@ -70,11 +71,20 @@ struct count_combinations_visitor
     {
       for (const auto& arc : n)
       {
-        insertion.first->second += visit(*this, arc.valuation()) * visit(*this, arc.successor());
+        insertion.first->second += visit(*this, arc.valuation()) * deep_visit(arc.successor());
       }
     }
     return insertion.first->second;
   }
+
+private:
+
+  /// @brief Visit a successor, the recursion may be as deep as the order.
+  boost::multiprecision::cpp_int
+  deep_visit(const SDD<C>& x)
+  {
+    return util::deep_call([&]{return visit(*this, x);});
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -22,6 +22,7 @@
 #include "sdd/mem/unique.hh"
 #include "sdd/mem/variant.hh"
 #include "sdd/order/order.hh"
+#include "sdd/util/deep_call.hh"
 #include "sdd/values/empty.hh"
 
 // Include for forwards at the end of the file.
@@ -192,11 +193,11 @@ public:
       // We can safely pass the order_identifier as a user one because only hierarchical levels
       // can be artificial.
       assert(not o.identifier().artificial());
-      ptr_ = create_node(cxt, o.variable(), init(o.identifier().user()), SDD(cxt, o.next(), init));
+      ptr_ = create_node(cxt, o.variable(), init(o.identifier().user()), next(cxt, o, init));
     }
     else // hierarchical
     {
-      ptr_ = create_node(cxt, o.variable(), SDD(cxt, o.nested(), init), SDD(cxt, o.next(), init));
+      ptr_ = create_node(cxt, o.variable(), SDD(cxt, o.nested(), init), next(cxt, o, init));
     }
   }
 
@@ -405,6 +406,18 @@ public:
 
 private:
 
+  /// @internal
+  /// @brief Construct the SDD of the levels following the head of an order.
+  ///
+  /// Flat orders may be longer than the stack can hold recursive calls.
+  template <typename Initializer>
+  static
+  SDD
+  next(dd::context<C>& cxt, const order<C>& o, const Initializer& init)
+  {
+    return util::deep_call([&]{return SDD(cxt, o.next(), init);});
+  }
+
   /// @internal
   /// @brief Helper function to create a node, flat or hierarchical, with only one arc.
   ///
@@ -480,7 +493,7 @@ private:
     // Note that the alpha function is allocated right behind the node, thus extra care must be
     // taken.
     auto& ut = global<C>().sdd_unique_table;
-    char* addr = ut.allocate(builder.size_to_allocate());
+    char* addr = ut.allocate(builder.size_to_allocate(), ut.partitioner().partition(var));
     unique_type* u =
       new (addr) unique_type(mem::construct<node<C, Valuation>>(), var, builder);
     return ut(u, builder.size_to_allocate());
@@ -15,7 +15,9 @@
 #include "sdd/dd/operations_fwd.hh"
 #include "sdd/dd/square_union.hh"
 #include "sdd/dd/top.hh"
+#include "sdd/util/deep_call.hh"
 #include "sdd/util/hash.hh"
+#include "sdd/util/trace.hh"
 #include "sdd/values/empty.hh"
 
 namespace sdd {
@@ -148,7 +150,13 @@ struct difference_op
   operator()(context<C>& cxt)
   const
   {
-    return binary_visit(difference_visitor<C>{cxt}, left, right, left, right);
+    trace::scope _("difference");
+    // The difference recurses once per level.
+    return util::deep_call([&]
+                           {
+                             return binary_visit( difference_visitor<C>{cxt}, left, right
+                                                , left, right);
+                           });
   }
 
   friend
@@ -214,7 +222,9 @@ inline
 SDD<C>
 operator-(const SDD<C>& lhs, const SDD<C>& rhs)
 {
-  return dd::difference(global<C>().sdd_context, lhs, rhs);
+  SDD<C> res = dd::difference(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
+  return res;
 }
 
 /// @brief Perform the difference of two SDD.
@@ -225,6 +235,7 @@ SDD<C>&
 operator-=(SDD<C>& lhs, const SDD<C>& rhs)
 {
   SDD<C> tmp = dd::difference(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
   using std::swap;
   swap(tmp, lhs);
   return lhs;
@@ -69,16 +69,11 @@ struct LIBSDD_ATTRIBUTE_PACKED intersection_op_impl
       {
         for (auto& rhs_arc : rhs)
         {
-          intersection_builder<C, valuation_type> valuation_builder(cxt);
-          valuation_builder.add(lhs_arc.valuation());
-          valuation_builder.add(rhs_arc.valuation());
-          valuation_type inter_val = intersection(cxt, std::move(valuation_builder));
+          valuation_type inter_val = intersection(cxt, lhs_arc.valuation(), rhs_arc.valuation());
 
           if (not values::empty_values(inter_val))
           {
-            SDD<C> inter_succ
-              = intersection(cxt, intersection_builder<C, SDD<C>>(cxt, { lhs_arc.successor()
-                                                                       , rhs_arc.successor()}));
+            SDD<C> inter_succ = intersection(cxt, lhs_arc.successor(), rhs_arc.successor());
 
             if (not values::empty_values(inter_succ))
             {
@@ -147,7 +142,44 @@ intersection(context<C>& cxt, intersection_builder<C, SDD<C>>&& builder)
   {
     return *builder.begin();
   }
-  return cxt.intersection_cache()({builder});
+  return cxt.intersection_cache()(builder, [&]{return intersection_op<C>(builder);});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The intersection operation of two SDD.
+///
+/// Trivial cases (equal operands or |0|) are handled before the cache is looked up. Otherwise, the
+/// operation is only built when it's not in the cache, and it shares its cache entry with the
+/// n-ary intersection of the same operands.
+template <typename C>
+inline
+SDD<C>
+intersection(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs)
+{
+  if (lhs == rhs or lhs.empty())
+  {
+    return lhs;
+  }
+  else if (rhs.empty())
+  {
+    return rhs;
+  }
+  const binary_operands<C> operands(lhs, rhs);
+  return cxt.intersection_cache()(operands, [&]{return intersection_op<C>(operands);});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The intersection operation of two sets of values.
+template <typename C, typename Values>
+inline
+Values
+intersection(context<C>&, const Values& lhs, const Values& rhs)
+{
+  return intersection(lhs, rhs);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -193,9 +225,9 @@ inline
 SDD<C>
 operator&(const SDD<C>& lhs, const SDD<C>& rhs)
 {
-  auto& sdd_context = global<C>().sdd_context;
-  return dd::intersection( sdd_context
-                         , dd::intersection_builder<C, SDD<C>>(sdd_context,{lhs, rhs}));
+  SDD<C> res = dd::intersection(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
+  return res;
 }
 
 /// @brief Perform the intersection of two SDD.
@@ -205,9 +237,8 @@ inline
 SDD<C>&
 operator&=(SDD<C>& lhs, const SDD<C>& rhs)
 {
-  auto& sdd_context = global<C>().sdd_context;
-  SDD<C> tmp = dd::intersection( sdd_context
-                               , dd::intersection_builder<C, SDD<C>>(sdd_context,{lhs, rhs}));
+  SDD<C> tmp = dd::intersection(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
   using std::swap;
   swap(tmp, lhs);
   return lhs;
@@ -225,7 +256,9 @@ intersection(InputIterator begin, InputIterator end)
   {
     builder.add(*begin);
   }
-  return dd::intersection(global<C>().sdd_context, std::move(builder));
+  SDD<C> res = dd::intersection(global<C>().sdd_context, std::move(builder));
+  global<C>().hom_context.adapt_caches();
+  return res;
 }
 
 /// @brief Perform the intersection of an initializer list of SDD.
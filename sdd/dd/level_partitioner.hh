@@ -0,0 +1,54 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include "sdd/dd/definition.hh"
+
+namespace sdd { namespace dd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Dispatch SDD nodes in partitions of the unique table according to their variable.
+///
+/// Terminals are stored in the partition 0, nodes of variable v in the partition v + 1. As
+/// variables generated by an order are dense, so are partitions.
+template <typename C>
+struct level_partitioner
+{
+  /// @brief The type of a unified SDD.
+  using unique_type = typename SDD<C>::unique_type;
+
+  /// @brief Get the partition of a variable.
+  static
+  std::size_t
+  partition(typename C::variable_type var)
+  noexcept
+  {
+    return static_cast<std::size_t>(var) + 1;
+  }
+
+  /// @brief Get the partition of a unified SDD.
+  std::size_t
+  operator()(const unique_type& u)
+  const noexcept
+  {
+    if (mem::is<flat_node<C>>(u.data()))
+    {
+      return partition(mem::variant_cast<flat_node<C>>(u.data()).variable());
+    }
+    else if (mem::is<hierarchical_node<C>>(u.data()))
+    {
+      return partition(mem::variant_cast<hierarchical_node<C>>(u.data()).variable());
+    }
+    return 0; // terminals
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::dd
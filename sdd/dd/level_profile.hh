@@ -0,0 +1,157 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <vector>
+
+#include "sdd/dd/definition.hh"
+
+namespace sdd { namespace dd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Statistics of the live nodes of a variable number.
+struct level_statistics
+{
+  /// @brief The number of live nodes.
+  std::size_t nodes;
+
+  /// @brief The number of arcs of all live nodes.
+  std::size_t arcs;
+
+  /// @brief The number of bytes used by all live nodes.
+  std::size_t bytes;
+
+  /// @brief The number of times an already existing node was requested again.
+  std::size_t hits;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Maintain per-variable statistics of the SDD unique table.
+///
+/// It's an observer of the SDD unique table: statistics are updated at each insertion and erasure
+/// rather than computed by a traversal. Terminals are not accounted for.
+///
+/// Statistics are kept per variable number, not per position in the order. As variables are
+/// numbered independently in each hierarchical level, the nodes of a nested level and of the top
+/// level which have the same variable number are accounted together: a node doesn't know the level
+/// of the order it belongs to.
+template <typename C>
+class level_profile
+{
+public:
+
+  /// @brief Statistics indexed by variable numbers, all hierarchical levels merged.
+  using levels_type = std::vector<level_statistics>;
+
+private:
+
+  /// @brief The type of a unified SDD.
+  using unique_type = typename SDD<C>::unique_type;
+
+  /// @brief Statistics indexed by variables.
+  levels_type levels_;
+
+public:
+
+  /// @brief Default constructor.
+  level_profile()
+    : levels_()
+  {}
+
+  /// @brief Called when a node is inserted in the unique table.
+  void
+  on_insert(const unique_type& u)
+  {
+    if (mem::is<flat_node<C>>(u.data()))
+    {
+      update(mem::variant_cast<flat_node<C>>(u.data()), +1);
+    }
+    else if (mem::is<hierarchical_node<C>>(u.data()))
+    {
+      update(mem::variant_cast<hierarchical_node<C>>(u.data()), +1);
+    }
+  }
+
+  /// @brief Called when an existing node is requested again.
+  void
+  on_hit(const unique_type& u)
+  {
+    if (mem::is<flat_node<C>>(u.data()))
+    {
+      level(mem::variant_cast<flat_node<C>>(u.data()).variable()).hits += 1;
+    }
+    else if (mem::is<hierarchical_node<C>>(u.data()))
+    {
+      level(mem::variant_cast<hierarchical_node<C>>(u.data()).variable()).hits += 1;
+    }
+  }
+
+  /// @brief Called when a node is erased from the unique table.
+  void
+  on_erase(const unique_type& u)
+  {
+    if (mem::is<flat_node<C>>(u.data()))
+    {
+      update(mem::variant_cast<flat_node<C>>(u.data()), -1);
+    }
+    else if (mem::is<hierarchical_node<C>>(u.data()))
+    {
+      update(mem::variant_cast<hierarchical_node<C>>(u.data()), -1);
+    }
+  }
+
+  /// @brief Get the statistics of all variable numbers.
+  ///
+  /// O(1). Index v gathers the nodes of variable v of all hierarchical levels.
+  const levels_type&
+  levels()
+  const noexcept
+  {
+    return levels_;
+  }
+
+private:
+
+  /// @brief Get the statistics of a variable, create them if needed.
+  level_statistics&
+  level(typename C::variable_type var)
+  {
+    if (var >= levels_.size())
+    {
+      levels_.resize(var + 1, level_statistics{0, 0, 0, 0});
+    }
+    return levels_[var];
+  }
+
+  /// @brief Add or remove a node from the statistics of its variable.
+  template <typename Node>
+  void
+  update(const Node& n, int direction)
+  {
+    auto& l = level(n.variable());
+    const std::size_t bytes = sizeof(unique_type) + n.size() * sizeof(typename Node::arc_type);
+    if (direction > 0)
+    {
+      l.nodes += 1;
+      l.arcs += n.size();
+      l.bytes += bytes;
+    }
+    else
+    {
+      l.nodes -= 1;
+      l.arcs -= n.size();
+      l.bytes -= bytes;
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::dd
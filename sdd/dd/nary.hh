@@ -7,20 +7,80 @@
 #pragma once
 
 #include <algorithm> // copy, equal
+#include <cstdint>   // uintptr_t
 #include <initializer_list>
 #include <iosfwd>
+#include <utility>   // move
 
 #include <boost/container/flat_set.hpp>
 
 #include "sdd/dd/context_fwd.hh"
 #include "sdd/dd/definition.hh"
 #include "sdd/mem/linear_alloc.hh"
+#include "sdd/util/deep_call.hh"
 #include "sdd/util/hash.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd { namespace dd {
 
 /*------------------------------------------------------------------------------------------------*/
 
+// Forward declaration.
+template <typename C, typename Valuation, typename Builder>
+struct nary_builder;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The two operands of a binary sum or intersection.
+///
+/// Operands are sorted the same way as in nary_builder: an operation and its commutated version
+/// share the same cache entry, which is also the one of the n-ary operation on the same operands.
+/// It can also be given to nary_op in place of a builder.
+template <typename C>
+struct binary_operands
+{
+  /// @brief The smallest operand.
+  const SDD<C>& first;
+
+  /// @brief The greatest operand.
+  const SDD<C>& second;
+
+  /// @brief Constructor.
+  binary_operands(const SDD<C>& lhs, const SDD<C>& rhs)
+  noexcept
+    : first(lhs < rhs ? lhs : rhs), second(lhs < rhs ? rhs : lhs)
+  {}
+
+  /// @brief Get the number of operands.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return 2;
+  }
+
+  /// @brief Compute the size needed to store both operands.
+  std::size_t
+  size_to_allocate()
+  const noexcept
+  {
+    return 2 * sizeof(SDD<C>);
+  }
+
+  /// @brief Copy operands to a given memory location.
+  void
+  consolidate(char* addr)
+  const noexcept
+  {
+    SDD<C>* base = reinterpret_cast<SDD<C>*>(addr);
+    new (base) SDD<C>(first);
+    new (base + 1) SDD<C>(second);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Base class for sum and intersection operations, used by the cache.
 /// @tparam Operation The implementation of the sum or intersection algorithm.
@@ -28,7 +88,7 @@ namespace sdd { namespace dd {
 /// It manages the allocation and deallocation of operands, as well as the dispatch on the
 /// correct type (flat or hierarchical node).
 template <typename C, typename Operation>
-struct LIBSDD_ATTRIBUTE_PACKED nary_op
+struct nary_op
 {
   // Can't copy a nary_op.
   nary_op(const nary_op&) = delete;
@@ -37,56 +97,114 @@ struct LIBSDD_ATTRIBUTE_PACKED nary_op
   /// @brief Define an iterator on operands.
   using const_iterator = const SDD<C>*;
 
-  /// @brief The dynamically allocated array of operands.
+  /// @brief The number of operands stored within the operation itself.
+  ///
+  /// Most operations have two operands, they don't need any allocation.
+  static constexpr std::size_t inline_size = 2;
+
+private:
+
+  /// @brief Tag the address of operands allocated on the heap.
+  static constexpr std::uintptr_t heap_tag = 1;
+
+  /// @brief Precede operands allocated on the heap.
+  struct alignas(SDD<C>) heap_header
+  {
+    /// @brief The number of operands.
+    typename C::operands_size_type size;
+  };
+
+  /// @brief The storage of operands.
   ///
   /// The concrete type will always be an SDD<C>. We use a raw memory storage as we don't want to
   /// build useless default SDD (the |0| terminal). This storage will be filled by the constructor.
-  /// Also, as an operation is moved by the cache, we stick to a pointer (contrary to SDD nodes or
-  /// homomorphisms n-ary operations) to avoid to move all operands.
-  char* operands;
+  /// Operations of inline_size operands store them in local_. Otherwise, as an operation is moved
+  /// by the cache, we stick to a dynamically allocated array (contrary to SDD nodes or
+  /// homomorphisms n-ary operations) to avoid to move all operands. heap_ then points to a
+  /// heap_header, followed by the operands, and its lowest bit is set to heap_tag. SDD point to
+  /// aligned data, thus this bit is never set in local_, and an operation is as large as two
+  /// pointers, whatever the number of its operands.
+  union
+  {
+    std::uintptr_t heap_;
+    alignas(SDD<C>) char local_[inline_size * sizeof(SDD<C>)];
+  };
 
-  /// @brief The number of operands.
-  const typename C::operands_size_type size;
+  static_assert(sizeof(SDD<C>) == sizeof(std::uintptr_t), "An SDD should be a single pointer");
 
-  /// @brief Constructor from an nary_builder.
+public:
+
+  /// @brief Constructor from an nary_builder or from binary_operands.
   template <typename Builder>
   nary_op(Builder& builder)
-    : operands(new char[builder.size_to_allocate()])
-    , size(static_cast<typename C::operands_size_type>(builder.size()))
   {
-    assert(size > 1);
-    // Will place (with a placement new combined with a move) operands in the raw storage.
-    builder.consolidate(operands);
+    assert(builder.size() > 1);
+    if (builder.size() == inline_size)
+    {
+      // Will place (with a placement new combined with a move) operands in the raw storage.
+      builder.consolidate(local_);
+    }
+    else
+    {
+      char* addr = new char[sizeof(heap_header) + builder.size_to_allocate()];
+      new (addr) heap_header{static_cast<typename C::operands_size_type>(builder.size())};
+      heap_ = reinterpret_cast<std::uintptr_t>(addr) | heap_tag;
+      builder.consolidate(addr + sizeof(heap_header));
+    }
   }
 
   /// @brief Move constructor.
   nary_op(nary_op&& other)
   noexcept
-    : operands(other.operands)
-    , size(other.size)
   {
-    other.operands = nullptr;
+    if (other.is_inline())
+    {
+      auto* dst = reinterpret_cast<SDD<C>*>(local_);
+      for (auto& operand : other)
+      {
+        new (dst++) SDD<C>(std::move(const_cast<SDD<C>&>(operand)));
+      }
+    }
+    else
+    {
+      heap_ = other.heap_;
+      other.heap_ = heap_tag; // no operands
+    }
   }
 
   /// @brief Destructor.
   ~nary_op()
   {
-    if (operands != nullptr)
+    if (is_inline() or header() != nullptr)
     {
       for (auto& operand : *this)
       {
         operand.~SDD<C>();
       }
-      delete[] operands;
+    }
+    if (not is_inline())
+    {
+      delete[] reinterpret_cast<char*>(header());
     }
   }
 
+  /// @brief Get the number of operands.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return is_inline() ? inline_size : header()->size;
+  }
+
   /// @brief Get an iterator to the first operand.
   const_iterator
   begin()
   const noexcept
   {
-    return reinterpret_cast<const SDD<C>*>(operands);
+    return reinterpret_cast<const SDD<C>*>( is_inline()
+                                          ? local_
+                                          : reinterpret_cast<const char*>(header())
+                                            + sizeof(heap_header));
   }
 
   /// @brief Get an iterator to the end.
@@ -94,7 +212,7 @@ struct LIBSDD_ATTRIBUTE_PACKED nary_op
   end()
   const noexcept
   {
-    return reinterpret_cast<const SDD<C>*>(operands) + size;
+    return begin() + size();
   }
 
   /// @brief Apply the operation.
@@ -104,20 +222,9 @@ struct LIBSDD_ATTRIBUTE_PACKED nary_op
   operator()(context<C>& cxt)
   const
   {
-    // Compatibility of nodes is checked on the fly by operations.
-    // It avoids to perform an iteration only for this task.
-    if (mem::is<flat_node<C>>(*begin()))
-    {
-      return Operation::template work<const_iterator, flat_node<C>>(begin(), end(), cxt);
-    }
-    else if (mem::is<hierarchical_node<C>>(*begin()))
-    {
-      return Operation::template work<const_iterator, hierarchical_node<C>>(begin(), end(), cxt);
-    }
-    else
-    {
-      throw top<C>(*begin(), *(begin() + 1));
-    }
+    trace::scope _(Operation::symbol == '+' ? "sum" : "intersection", true, "operands", size());
+    // The operation recurses once per level.
+    return util::deep_call([&]{return work(cxt);});
   }
 
   friend
@@ -125,7 +232,30 @@ struct LIBSDD_ATTRIBUTE_PACKED nary_op
   operator==(const nary_op& lhs, const nary_op& rhs)
   noexcept
   {
-    return lhs.size == rhs.size and std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  /// @brief Compare two operands with the ones of an operation.
+  ///
+  /// Used by the cache to look for a binary operation without building it.
+  friend
+  bool
+  operator==(const binary_operands<C>& lhs, const nary_op& rhs)
+  noexcept
+  {
+    return rhs.size() == 2 and lhs.first == *rhs.begin() and lhs.second == *(rhs.begin() + 1);
+  }
+
+  /// @brief Compare the operands of a builder with the ones of an operation.
+  ///
+  /// Used by the cache to look for an operation without building it.
+  template <typename Builder>
+  friend
+  bool
+  operator==(const nary_builder<C, SDD<C>, Builder>& lhs, const nary_op& rhs)
+  noexcept
+  {
+    return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
   friend
@@ -136,6 +266,45 @@ struct LIBSDD_ATTRIBUTE_PACKED nary_op
     std::copy(x.begin(), std::prev(x.end()), std::ostream_iterator<SDD<C>>(os, ", "));
     return os << *std::prev(x.end()) << ")";
   }
+
+private:
+
+  /// @brief Tell if operands are stored in the operation itself.
+  bool
+  is_inline()
+  const noexcept
+  {
+    return (heap_ & heap_tag) == 0;
+  }
+
+  /// @brief Get the header of operands allocated on the heap, nullptr if they were moved.
+  heap_header*
+  header()
+  const noexcept
+  {
+    return reinterpret_cast<heap_header*>(heap_ & ~heap_tag);
+  }
+
+  /// @brief Dispatch the operation on the type of nodes of operands.
+  SDD<C>
+  work(context<C>& cxt)
+  const
+  {
+    // Compatibility of nodes is checked on the fly by operations.
+    // It avoids to perform an iteration only for this task.
+    if (mem::is<flat_node<C>>(*begin()))
+    {
+      return Operation::template work<const_iterator, flat_node<C>>(begin(), end(), cxt);
+    }
+    else if (mem::is<hierarchical_node<C>>(*begin()))
+    {
+      return Operation::template work<const_iterator, hierarchical_node<C>>(begin(), end(), cxt);
+    }
+    else
+    {
+      throw top<C>(*begin(), *(begin() + 1));
+    }
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -277,6 +446,39 @@ struct hash<sdd::dd::nary_op<C, Operation>>
   }
 };
 
+/// @internal
+/// @brief Hash specialization for sdd::dd::binary_operands
+///
+/// It must be the same as the one of the operation built from these operands.
+template <typename C>
+struct hash<sdd::dd::binary_operands<C>>
+{
+  std::size_t
+  operator()(const sdd::dd::binary_operands<C>& operands)
+  const
+  {
+    using namespace sdd::hash;
+    return seed() (val(operands.first)) (val(operands.second));
+  }
+};
+
+/// @internal
+/// @brief Hash specialization for sdd::dd::nary_builder
+///
+/// It must be the same as the one of the operation built from this builder, as builders are used to
+/// look for operations in the cache.
+template <typename C, typename Valuation, typename Builder>
+struct hash<sdd::dd::nary_builder<C, Valuation, Builder>>
+{
+  std::size_t
+  operator()(const sdd::dd::nary_builder<C, Valuation, Builder>& builder)
+  const
+  {
+    using namespace sdd::hash;
+    return seed() (range(builder));
+  }
+};
+
 /*------------------------------------------------------------------------------------------------*/
 
 } // namespace std
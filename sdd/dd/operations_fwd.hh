@@ -54,6 +54,16 @@ template <typename C, typename Values>
 Values
 intersection(context<C>&, const intersection_builder<C, Values>&);
 
+// Forward declaration of the binary SDD intersection operation.
+template <typename C>
+SDD<C>
+intersection(context<C>&, const SDD<C>&, const SDD<C>&);
+
+// Forward declaration of the binary Values intersection operation.
+template <typename C, typename Values>
+Values
+intersection(context<C>&, const Values&, const Values&);
+
 /*------------------------------------------------------------------------------------------------*/
 
 // Forward declaration of the sum builder policy.
@@ -82,6 +92,16 @@ template <typename C, typename Values>
 Values
 sum(context<C>&, const sum_builder<C, Values>&);
 
+// Forward declaration of the binary SDD sum operation.
+template <typename C>
+SDD<C>
+sum(context<C>&, const SDD<C>&, const SDD<C>&);
+
+// Forward declaration of the binary Values sum operation.
+template <typename C, typename Values>
+Values
+sum(context<C>&, const Values&, const Values&);
+
 /*------------------------------------------------------------------------------------------------*/
 
 }} // namespace sdd::dd
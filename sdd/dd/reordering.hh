@@ -0,0 +1,680 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // find_if, max, remove, stable_sort
+#include <cassert>
+#include <cstdint>   // uint32_t
+#include <iterator>  // next
+#include <stdexcept> // invalid_argument, logic_error
+#include <utility>   // pair, swap
+#include <vector>
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/sum.hh"
+#include "sdd/internal_manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/tools/visited.hh"
+
+namespace sdd {
+
+namespace dd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Exchange the valuations of two adjacent levels, for all arcs of a node of the lower one.
+template <typename C>
+struct swap_lower_visitor
+{
+  template <typename Valuation>
+  void
+  operator()( const zero_terminal<C>&, sum_builder<C, SDD<C>>&, typename C::variable_type
+            , const Valuation&)
+  const noexcept
+  {
+    assert(false && "Can't swap the last variable of an order.");
+  }
+
+  template <typename Valuation>
+  void
+  operator()( const one_terminal<C>&, sum_builder<C, SDD<C>>&, typename C::variable_type
+            , const Valuation&)
+  const noexcept
+  {
+    assert(false && "Can't swap the last variable of an order.");
+  }
+
+  /// @param n A node of the lower variable.
+  /// @param upper_var The upper variable.
+  /// @param upper_valuation The valuation of the arc of the upper node leading to n.
+  template <typename Node, typename Valuation>
+  void
+  operator()( const Node& n, sum_builder<C, SDD<C>>& operands, typename C::variable_type upper_var
+            , const Valuation& upper_valuation)
+  const
+  {
+    for (const auto& arc : n)
+    {
+      operands.add(SDD<C>( upper_var, arc.valuation()
+                         , SDD<C>(n.variable(), upper_valuation, arc.successor())));
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Swap a variable with the one just below it in an SDD.
+///
+/// Let x be the swapped variable and y the variable below. A node of x with arcs a_i -> n_i, where
+/// each n_i is a node of y with arcs b_ij -> g_ij, becomes the sum of all SDD x -b_ij-> y -a_i->
+/// g_ij. Nodes above x are rebuilt with their new successors, nodes below y are left untouched.
+/// Variables denote positions, thus x and y keep their numbers: only the valuations move.
+template <typename C>
+struct swap_visitor
+{
+  /// @brief The type of a variable.
+  using variable_type = typename C::variable_type;
+
+  /// @brief The context of SDD operations.
+  context<C>& cxt_;
+
+  /// @brief The upper variable to swap.
+  const variable_type var_;
+
+  /// @brief Already rebuilt nodes, indexed by identifiers.
+  std::vector<SDD<C>> memo_;
+
+  /// @brief Tell which entries of memo_ are valid.
+  tools::visited_set<C> done_;
+
+  swap_visitor(context<C>& cxt, variable_type var)
+    : cxt_(cxt), var_(var), memo_(), done_()
+  {}
+
+  /// @brief |0|.
+  SDD<C>
+  operator()(const zero_terminal<C>&, const SDD<C>& x)
+  noexcept
+  {
+    return x;
+  }
+
+  /// @brief |1|.
+  SDD<C>
+  operator()(const one_terminal<C>&, const SDD<C>& x)
+  noexcept
+  {
+    return x;
+  }
+
+  /// @brief Flat or hierarchical node.
+  template <typename Node>
+  SDD<C>
+  operator()(const Node& n, const SDD<C>& x)
+  {
+    if (n.variable() < var_)
+    {
+      return x;
+    }
+    if (done_.contains(x))
+    {
+      return memo_[x.ptr()->id()];
+    }
+
+    sum_builder<C, SDD<C>> operands(cxt_);
+    if (n.variable() == var_)
+    {
+      for (const auto& arc : n)
+      {
+        visit(swap_lower_visitor<C>(), arc.successor(), operands, var_, arc.valuation());
+      }
+    }
+    else
+    {
+      operands.reserve(n.size());
+      for (const auto& arc : n)
+      {
+        operands.add(SDD<C>( n.variable(), arc.valuation()
+                           , visit(*this, arc.successor(), arc.successor())));
+      }
+    }
+    auto res = sum(cxt_, std::move(operands));
+
+    const auto id = x.ptr()->id();
+    done_.insert(x);
+    if (id >= memo_.size())
+    {
+      memo_.resize(id + 1);
+    }
+    memo_[id] = res;
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace dd
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Dynamic reordering of the variables of a set of SDD.
+///
+/// SDD are immutable and shared, thus they can't be modified in place. Instead, the SDD to keep
+/// are registered as roots: each reordering rebuilds them and assigns the result to the
+/// registered handles. The order is updated the same way. Only the top level of the order is
+/// reordered, hierarchical levels are moved as opaque blocks.
+///
+/// All caches are cleared by a reordering, as they reference SDD of the previous order.
+/// Homomorphisms built with the previous order must be built again. An SDD which is not registered
+/// would silently keep the previous order: a reordering thus throws std::logic_error, before
+/// modifying anything, if nodes are referenced elsewhere than by the registered roots.
+///
+/// A reordering must not happen while an operation is evaluated, thus the library never triggers
+/// one by itself: it must be requested by the user between operations, e.g. by calling
+/// maybe_sift() between two iterations of a user's loop.
+template <typename C>
+class reordering
+{
+  // Can't copy a reordering.
+  reordering(const reordering&) = delete;
+  reordering& operator=(const reordering&) = delete;
+
+public:
+
+  /// @brief A user's identifier type.
+  using identifier_type = typename C::Identifier;
+
+private:
+
+  /// @brief The type of a variable.
+  using variable_type = typename C::variable_type;
+
+  /// @brief The identifiers of the top level, with their nested orders, from top to bottom.
+  using identifiers_type = std::vector<std::pair<order_identifier<C>, order_builder<C>>>;
+
+  /// @brief The size of the caches of the context used by swaps during sifting.
+  static constexpr std::size_t swap_cache_size = 16'384;
+
+  /// @brief The size of the memory arena of the context used by swaps during sifting.
+  static constexpr std::size_t swap_arena_size = 1024 * 1024;
+
+  /// @brief The order of all roots, updated by each reordering.
+  order<C>& order_;
+
+  /// @brief The SDD to rebuild at each reordering.
+  std::vector<SDD<C>*> roots_;
+
+  /// @brief The number of nodes in the unique table above which maybe_sift() triggers.
+  std::size_t threshold_;
+
+  /// @brief Stop moving a variable in a direction when the size grows beyond this factor.
+  double max_growth_;
+
+  /// @brief The number of performed swaps.
+  std::size_t nb_swaps_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param o The order of all roots. It must outlive this reordering.
+  /// @param threshold The number of nodes in the unique table above which maybe_sift() triggers.
+  /// @param max_growth The maximal size growth tolerated when moving a variable during sifting.
+  reordering(order<C>& o, std::size_t threshold = 1'000'000, double max_growth = 1.2)
+    : order_(o), roots_(), threshold_(threshold), max_growth_(max_growth), nb_swaps_(0)
+  {}
+
+  /// @brief Register an SDD to rebuild at each reordering.
+  ///
+  /// The SDD must be built with the order given to this reordering. It must stay alive as long
+  /// as it's registered.
+  void
+  add_root(SDD<C>& x)
+  {
+    roots_.push_back(&x);
+  }
+
+  /// @brief Unregister an SDD.
+  void
+  remove_root(SDD<C>& x)
+  {
+    roots_.erase(std::remove(roots_.begin(), roots_.end(), &x), roots_.end());
+  }
+
+  /// @brief Swap an identifier of the top level of the order with the one just below it.
+  /// @throw std::invalid_argument if the identifier is not at the top level or if it's the last
+  /// one of the order.
+  /// @throw std::logic_error if SDD which are not registered are alive.
+  void
+  swap(const identifier_type& id)
+  {
+    clear_caches();
+    check_roots();
+    auto ids = top_level();
+    const auto search = std::find_if( ids.begin(), ids.end()
+                                    , [&](const auto& i)
+                                         {
+                                           return not i.first.is_artificial()
+                                              and i.first.user() == id;
+                                         });
+    if (search == ids.end() or std::next(search) == ids.end())
+    {
+      throw std::invalid_argument("Can't swap this identifier with the one below.");
+    }
+    swap_position(ids, static_cast<std::size_t>(search - ids.begin()), global<C>().sdd_context);
+    set_order(ids);
+    clear_caches();
+  }
+
+  /// @brief Reorder the top level of the order using Rudell's sifting.
+  ///
+  /// Each identifier, starting with the ones which levels have the most nodes, is moved to all
+  /// positions of the order and then put back at the position which minimizes the number of
+  /// live nodes. A swap only rebuilds the levels above the swapped ones, thus its effect is
+  /// measured with the live nodes of these levels given by the profile of the unique table, rather
+  /// than by traversing all roots. Caches are cleared once, swaps use their own small caches which
+  /// are flushed after each swap, and the order is rebuilt once at the end.
+  /// @throw std::logic_error if SDD which are not registered are alive.
+  void
+  sift()
+  {
+    // Caches would keep SDD of previous orders alive, thus skew the number of live nodes.
+    clear_caches();
+    check_roots();
+
+    auto ids = top_level();
+
+    // Get identifiers in decreasing number of nodes.
+    std::vector<std::pair<std::size_t /*nodes*/, order_identifier<C>>> candidates;
+    {
+      const auto levels = nodes_per_position();
+      for (std::size_t i = 0; i < ids.size(); ++i)
+      {
+        candidates.emplace_back(levels[i], ids[i].first);
+      }
+      std::stable_sort( candidates.begin(), candidates.end()
+                      , [](const auto& lhs, const auto& rhs){return lhs.first > rhs.first;});
+    }
+
+    {
+      dd::context<C> cxt(swap_cache_size, swap_cache_size, swap_cache_size, swap_arena_size);
+      std::size_t current = live_nodes(0);
+      for (const auto& candidate : candidates)
+      {
+        sift_identifier(ids, candidate.second, cxt, current);
+      }
+    }
+    set_order(ids);
+  }
+
+  /// @brief Perform sifting if the unique table has grown beyond the threshold.
+  /// @return true if a sifting was performed.
+  /// @throw std::logic_error if SDD which are not registered are alive.
+  ///
+  /// The threshold is then set to twice the number of nodes after sifting. It's meant to be called
+  /// regularly by the user, at points where all live SDD are registered.
+  bool
+  maybe_sift()
+  {
+    if (global<C>().sdd_unique_table.size() <= threshold_)
+    {
+      return false;
+    }
+    sift();
+    threshold_ = std::max(threshold_, 2 * global<C>().sdd_unique_table.size());
+    return true;
+  }
+
+  /// @brief Get the number of nodes above which maybe_sift() triggers.
+  std::size_t
+  threshold()
+  const noexcept
+  {
+    return threshold_;
+  }
+
+  /// @brief Get the number of adjacent swaps performed so far.
+  std::size_t
+  nb_swaps()
+  const noexcept
+  {
+    return nb_swaps_;
+  }
+
+  /// @brief Get the number of distinct nodes of all roots.
+  std::size_t
+  size()
+  const
+  {
+    tools::visited_set<C> visited(global<C>().sdd_unique_table.identifiers_bound());
+    std::size_t res = 0;
+    std::vector<SDD<C>> stack;
+    for (const auto root : roots_)
+    {
+      stack.push_back(*root);
+    }
+    while (not stack.empty())
+    {
+      const auto x = std::move(stack.back());
+      stack.pop_back();
+      if (x.empty() or x == one<C>() or not visited.insert(x))
+      {
+        continue;
+      }
+      ++res;
+      visit(for_each_successor(), x, [&](const SDD<C>& s){stack.push_back(s);});
+    }
+    return res;
+  }
+
+private:
+
+  /// @brief Call a function on the successors, and the nested SDD, of a node.
+  struct for_each_successor
+  {
+    template <typename T, typename Function>
+    void
+    operator()(const T&, Function&&)
+    const noexcept
+    {}
+
+    template <typename Function>
+    void
+    operator()(const flat_node<C>& n, Function&& f)
+    const
+    {
+      for (const auto& arc : n)
+      {
+        f(arc.successor());
+      }
+    }
+
+    template <typename Function>
+    void
+    operator()(const hierarchical_node<C>& n, Function&& f)
+    const
+    {
+      for (const auto& arc : n)
+      {
+        f(arc.valuation());
+        f(arc.successor());
+      }
+    }
+  };
+
+  /// @brief Check that all live nodes belong to the roots and are only referenced by them.
+  /// @throw std::logic_error otherwise.
+  ///
+  /// The references to each node of the roots, from registered handles and from other nodes of
+  /// the roots, are counted and compared to its reference counter. Caches must be cleared.
+  void
+  check_roots()
+  const
+  {
+    using unique_type = typename SDD<C>::unique_type;
+
+    // Also tell if a node was already reached.
+    std::vector<std::uint32_t> references(global<C>().sdd_unique_table.identifiers_bound(), 0);
+    std::vector<const unique_type*> reached;
+    {
+      std::vector<SDD<C>> stack;
+      const auto reference = [&](const SDD<C>& x)
+      {
+        if (x.empty() or x == one<C>())
+        {
+          return;
+        }
+        if (references[x.ptr()->id()]++ == 0)
+        {
+          reached.push_back(x.ptr().operator->());
+          stack.push_back(x);
+        }
+      };
+      for (const auto root : roots_)
+      {
+        reference(*root);
+      }
+      while (not stack.empty())
+      {
+        const auto x = std::move(stack.back());
+        stack.pop_back();
+        visit(for_each_successor(), x, reference);
+      }
+    } // No more temporary references.
+
+    if (reached.size() != live_nodes(0))
+    {
+      throw std::logic_error("Can't reorder SDD which are not registered.");
+    }
+    for (const auto u : reached)
+    {
+      if (u->reference_counter() != references[u->id()])
+      {
+        throw std::logic_error("Can't reorder SDD which are not registered.");
+      }
+    }
+  }
+
+  /// @brief Get the identifiers of the top level, with their nested orders, from top to bottom.
+  identifiers_type
+  top_level()
+  const
+  {
+    identifiers_type res;
+    for (auto o = order_; not o.empty(); o = o.next())
+    {
+      res.emplace_back(o.identifier(), to_builder(o.nested()));
+    }
+    return res;
+  }
+
+  /// @brief Convert an order back to a builder.
+  static
+  order_builder<C>
+  to_builder(const order<C>& o)
+  {
+    if (o.empty())
+    {
+      return order_builder<C>();
+    }
+    auto res = to_builder(o.next());
+    res.push(o.identifier(), to_builder(o.nested()));
+    return res;
+  }
+
+  /// @brief Get the number of nodes of all roots for each position of the top level.
+  std::vector<std::size_t>
+  nodes_per_position()
+  const
+  {
+    std::vector<std::size_t> res(top_level().size(), 0);
+    tools::visited_set<C> visited(global<C>().sdd_unique_table.identifiers_bound());
+    std::vector<SDD<C>> stack;
+    for (const auto root : roots_)
+    {
+      stack.push_back(*root);
+    }
+    while (not stack.empty())
+    {
+      const auto x = std::move(stack.back());
+      stack.pop_back();
+      if (x.empty() or x == one<C>() or not visited.insert(x))
+      {
+        continue;
+      }
+      // Only the top level is of interest.
+      visit(count_flat_node(), x, stack, res);
+    }
+    return res;
+  }
+
+  /// @brief Count a node at its position and push its successors, ignoring nested SDD.
+  struct count_flat_node
+  {
+    template <typename T>
+    void
+    operator()(const T&, std::vector<SDD<C>>&, std::vector<std::size_t>&)
+    const noexcept
+    {}
+
+    template <typename Valuation>
+    void
+    operator()( const node<C, Valuation>& n, std::vector<SDD<C>>& stack
+              , std::vector<std::size_t>& positions)
+    const
+    {
+      // Variables are numbered from the bottom, positions from the top.
+      if (n.variable() < positions.size())
+      {
+        positions[positions.size() - n.variable() - 1] += 1;
+      }
+      for (const auto& arc : n)
+      {
+        stack.push_back(arc.successor());
+      }
+    }
+  };
+
+  /// @brief Swap the identifier at a position, from the top, with the one just below.
+  ///
+  /// Only the roots and the identifiers are updated, not the order.
+  void
+  swap_position(identifiers_type& ids, std::size_t pos, dd::context<C>& cxt)
+  {
+    assert(pos + 1 < ids.size());
+    const auto var = static_cast<variable_type>(ids.size() - pos - 1);
+    dd::swap_visitor<C> swapper(cxt, var);
+    for (auto root : roots_)
+    {
+      *root = visit(swapper, *root, *root);
+    }
+    std::swap(ids[pos], ids[pos + 1]);
+    ++nb_swaps_;
+  }
+
+  /// @brief Swap the identifier at a position with the one just below, and update the number of
+  /// live nodes.
+  ///
+  /// Levels below the swapped ones are untouched, thus only the live nodes of the swapped levels
+  /// and of the ones above are counted before and after the swap.
+  void
+  measured_swap( identifiers_type& ids, std::size_t pos, dd::context<C>& cxt
+               , std::size_t& current)
+  {
+    const auto lower = static_cast<variable_type>(ids.size() - pos - 2);
+    const auto before = live_nodes(lower);
+    swap_position(ids, pos, cxt);
+    // Release the intermediate SDD kept alive by the caches.
+    cxt.clear();
+    current = current - before + live_nodes(lower);
+  }
+
+  /// @brief Get the number of live nodes of the variables from a given one to the top.
+  ///
+  /// Nodes of nested levels which have the same variables are counted too, but they are never
+  /// modified by swaps of the top level.
+  static
+  std::size_t
+  live_nodes(variable_type from)
+  {
+    const auto& levels = global<C>().sdd_unique_table.observer().levels();
+    std::size_t res = 0;
+    for (auto var = static_cast<std::size_t>(from); var < levels.size(); ++var)
+    {
+      res += levels[var].nodes;
+    }
+    return res;
+  }
+
+  /// @brief Replace the order by the one given by identifiers of the top level.
+  void
+  set_order(const identifiers_type& ids)
+  {
+    order_builder<C> ob;
+    for (auto rcit = ids.rbegin(); rcit != ids.rend(); ++rcit)
+    {
+      ob.push(rcit->first, rcit->second);
+    }
+    order_ = order<C>(ob);
+  }
+
+  /// @brief Clear the caches of SDD operations and of homomorphisms.
+  ///
+  /// Cached operations reference SDD which are no longer needed.
+  static
+  void
+  clear_caches()
+  {
+    global<C>().sdd_context.clear();
+    global<C>().hom_context.clear();
+  }
+
+  /// @brief Move an identifier to the position which minimizes the number of live nodes.
+  /// @param current The number of live nodes, updated by each swap.
+  void
+  sift_identifier( identifiers_type& ids, const order_identifier<C>& id, dd::context<C>& cxt
+                 , std::size_t& current)
+  {
+    const std::size_t height = ids.size();
+    const std::size_t start = static_cast<std::size_t>(
+      std::find_if(ids.begin(), ids.end(), [&](const auto& i){return i.first == id;})
+      - ids.begin());
+    std::size_t pos = start;
+    std::size_t best_pos = pos;
+    std::size_t best_size = current;
+
+    // Move down.
+    while (pos + 1 < height)
+    {
+      measured_swap(ids, pos, cxt, current);
+      ++pos;
+      if (current < best_size)
+      {
+        best_size = current;
+        best_pos = pos;
+      }
+      else if (current > max_growth_ * best_size)
+      {
+        break;
+      }
+    }
+
+    // Move up.
+    while (pos > 0)
+    {
+      measured_swap(ids, pos - 1, cxt, current);
+      --pos;
+      if (current < best_size)
+      {
+        best_size = current;
+        best_pos = pos;
+      }
+      else if (pos < start and current > max_growth_ * best_size)
+      {
+        break;
+      }
+    }
+
+    // Go back to the best position.
+    while (pos < best_pos)
+    {
+      measured_swap(ids, pos, cxt, current);
+      ++pos;
+    }
+    while (pos > best_pos)
+    {
+      measured_swap(ids, pos - 1, cxt, current);
+      --pos;
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
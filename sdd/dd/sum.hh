@@ -7,6 +7,7 @@
 #pragma once
 
 #include <initializer_list>
+#include <iterator>    // distance, next
 #include <type_traits> // enable_if, is_same
 #include <unordered_map>
 #include <vector>
@@ -49,6 +50,11 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
                   , SDD<C>>
   work(InputIterator begin, InputIterator end, context<C>& cxt)
   {
+    if (std::distance(begin, end) == 2)
+    {
+      return binary_work<NodeType>(*begin, *std::next(begin), cxt);
+    }
+
     using node_type = NodeType;
     using valuation_type = typename node_type::valuation_type;
 
@@ -133,10 +139,7 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
             goto equality;
           }
 
-          intersection_builder<C, valuation_type> inter_builder(cxt);
-          inter_builder.add(current_val);
-          inter_builder.add(res_val);
-          const valuation_type inter = intersection(cxt, std::move(inter_builder));
+          const valuation_type inter = intersection(cxt, current_val, res_val);
 
           // (E). The current valuation and the current arc from res have a common part.
           if (not values::empty_values(inter))
@@ -217,6 +220,84 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
     return SDD<C>(head.variable(), su());
   }
 
+  /// @brief Perform the SDD union algorithm on two operands.
+  ///
+  /// Valuations of an alpha are disjoint. Thus, each arc of lhs is split against what remains of
+  /// the arcs of rhs: common parts lead to the union of both successors, while the parts found in
+  /// only one operand keep their successor. It avoids the bookkeeping of the n-ary algorithm.
+  template <typename NodeType>
+  static
+  SDD<C>
+  binary_work(const SDD<C>& lhs, const SDD<C>& rhs, context<C>& cxt)
+  {
+    using node_type = NodeType;
+    using valuation_type = typename node_type::valuation_type;
+
+    // Throw a Top if operands are incompatible (different types or different variables).
+    check_compatibility(lhs, rhs);
+
+    mem::rewinder _(cxt.arena());
+
+    const node_type& lhs_node = mem::variant_cast<node_type>(*lhs);
+    const node_type& rhs_node = mem::variant_cast<node_type>(*rhs);
+
+    // What remains of the valuations of rhs, not yet found in lhs.
+    std::vector<valuation_type, mem::linear_alloc<valuation_type>>
+      rhs_remainders(mem::linear_alloc<valuation_type>(cxt.arena()));
+    rhs_remainders.reserve(rhs_node.size());
+    for (const auto& arc : rhs_node)
+    {
+      rhs_remainders.push_back(arc.valuation());
+    }
+
+    square_union<C, valuation_type> su(cxt);
+    su.reserve(lhs_node.size() + rhs_node.size());
+    for (const auto& lhs_arc : lhs_node)
+    {
+      valuation_type lhs_remainder = lhs_arc.valuation();
+      auto rhs_arc = rhs_node.begin();
+      for ( auto rhs_cit = rhs_remainders.begin()
+          ; rhs_cit != rhs_remainders.end() and not values::empty_values(lhs_remainder)
+          ; ++rhs_cit, ++rhs_arc)
+      {
+        auto& rhs_remainder = *rhs_cit;
+        if (values::empty_values(rhs_remainder))
+        {
+          continue;
+        }
+        if (lhs_remainder == rhs_remainder)
+        {
+          su.add(sum(cxt, lhs_arc.successor(), rhs_arc->successor()), std::move(lhs_remainder));
+          lhs_remainder = valuation_type();
+          rhs_remainder = valuation_type();
+          break;
+        }
+        valuation_type inter = intersection(cxt, lhs_remainder, rhs_remainder);
+        if (not values::empty_values(inter))
+        {
+          lhs_remainder = difference(cxt, lhs_remainder, inter);
+          rhs_remainder = difference(cxt, rhs_remainder, inter);
+          su.add(sum(cxt, lhs_arc.successor(), rhs_arc->successor()), std::move(inter));
+        }
+      }
+      if (not values::empty_values(lhs_remainder))
+      {
+        su.add(lhs_arc.successor(), std::move(lhs_remainder));
+      }
+    }
+    auto rhs_arc = rhs_node.begin();
+    for (auto& rhs_remainder : rhs_remainders)
+    {
+      if (not values::empty_values(rhs_remainder))
+      {
+        su.add(rhs_arc->successor(), std::move(rhs_remainder));
+      }
+      ++rhs_arc;
+    }
+
+    return SDD<C>(lhs_node.variable(), su());
+  }
+
   /// @brief Linear union of flat SDDs whose valuation are "fast iterable".
   template <typename InputIterator, typename NodeType>
   static
@@ -331,7 +412,44 @@ sum(context<C>& cxt, sum_builder<C, SDD<C>>&& builder)
   {
     return *builder.begin();
   }
-  return cxt.sum_cache()({builder});
+  return cxt.sum_cache()(builder, [&]{return sum_op<C>(builder);});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The sum operation of two SDD.
+///
+/// Trivial cases (equal operands or |0|) are handled before the cache is looked up. Otherwise, the
+/// operation is only built when it's not in the cache, and it shares its cache entry with the
+/// n-ary sum of the same operands.
+template <typename C>
+inline
+SDD<C>
+sum(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs)
+{
+  if (lhs == rhs or lhs.empty())
+  {
+    return rhs;
+  }
+  else if (rhs.empty())
+  {
+    return lhs;
+  }
+  const binary_operands<C> operands(lhs, rhs);
+  return cxt.sum_cache()(operands, [&]{return sum_op<C>(operands);});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The sum operation of two sets of values.
+template <typename C, typename Values>
+inline
+Values
+sum(context<C>&, const Values& lhs, const Values& rhs)
+{
+  return sum(lhs, rhs);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -378,8 +496,9 @@ inline
 SDD<C>
 operator+(const SDD<C>& lhs, const SDD<C>& rhs)
 {
-  return dd::sum( global<C>().sdd_context
-                , dd::sum_builder<C, SDD<C>>(global<C>().sdd_context, {lhs, rhs}));
+  SDD<C> res = dd::sum(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
+  return res;
 }
 
 /// @brief Perform the union of two SDD.
@@ -389,8 +508,8 @@ inline
 SDD<C>&
 operator+=(SDD<C>& lhs, const SDD<C>& rhs)
 {
-  SDD<C> tmp = dd::sum( global<C>().sdd_context
-                      , dd::sum_builder<C, SDD<C>>(global<C>().sdd_context, {lhs, rhs}));
+  SDD<C> tmp = dd::sum(global<C>().sdd_context, lhs, rhs);
+  global<C>().hom_context.adapt_caches();
   using std::swap;
   swap(tmp, lhs);
   return lhs;
@@ -408,7 +527,9 @@ sum(InputIterator begin, InputIterator end)
   {
     builder.add(*begin);
   }
-  return dd::sum(global<C>().sdd_context, std::move(builder));
+  SDD<C> res = dd::sum(global<C>().sdd_context, std::move(builder));
+  global<C>().hom_context.adapt_caches();
+  return res;
 }
 
 /// @brief Perform the union of an initializer list of SDD.
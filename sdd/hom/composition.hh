@@ -13,6 +13,7 @@
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/order/order.hh"
 
 namespace sdd { namespace hom {
@@ -38,6 +39,19 @@ struct _composition
     return left(cxt, o, right(cxt, o, x));
   }
 
+  /// @brief Split, when both operands are selectors.
+  ///
+  /// The left operand only splits the part accepted by the right one.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    auto right_parts = hom::split(cxt, right, o, x);
+    auto left_parts = hom::split(cxt, left, o, right_parts.accepted);
+    return { std::move(left_parts.accepted)
+           , dd::sum(cxt.sdd_context(), right_parts.rejected, left_parts.rejected)};
+  }
+
   /// @brief Skip predicate.
   bool
   skip(const order<C>& o)
@@ -13,6 +13,7 @@
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/traits.hh"
 #include "sdd/order/order.hh"
+#include "sdd/util/deep_call.hh"
 
 namespace sdd { namespace hom {
 
@@ -23,7 +24,7 @@ namespace sdd { namespace hom {
 template <typename C, typename Valuation>
 struct _cons
 {
-  /// @brief
+  /// @brief A cursor on the order of the level to create.
   const order<C> o;
 
   /// @brief The valuation of the SDD to create.
@@ -37,7 +38,8 @@ struct _cons
   operator()(context<C>& cxt, const order<C>&, const SDD<C>& x)
   const
   {
-    return {o.variable(), valuation, next(cxt, o.next(), x)};
+    // Nested cons create a level each, thus they may be deeper than the stack.
+    return {o.variable(), valuation, util::deep_call([&]{return next(cxt, o.next(), x);})};
   }
 
   /// @brief Skip predicate.
@@ -61,7 +63,7 @@ struct _cons
   operator==(const _cons& lhs, const _cons& rhs)
   noexcept
   {
-    return lhs.valuation == rhs.valuation and lhs.next == rhs.next and lhs.o == rhs.o;
+    return lhs.o == rhs.o and lhs.next == rhs.next and lhs.valuation == rhs.valuation;
   }
 
   friend
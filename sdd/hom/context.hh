@@ -12,8 +12,14 @@
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/evaluation.hh"
+#include "sdd/hom/function.hh"
+#include "sdd/hom/interrupt.hh"
+#include "sdd/hom/profiler.hh"
 #include "sdd/hom/rewrite.hh"
+#include "sdd/hom/saturation_state.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/mem/cache.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd { namespace hom {
 
@@ -32,6 +38,12 @@ public:
   /// @brief Homomorphism evaluation cache type.
   using cache_type = mem::cache< context, cached_homomorphism<C>, should_cache<C>>;
 
+  /// @brief Applications of user's functions cache type.
+  using function_cache_type = mem::cache<context, cached_function<C>>;
+
+  /// @brief Splits of SDD by selectors cache type.
+  using split_cache_type = mem::cache<context, cached_split<C>>;
+
   /// @brief SDD operation context type.
   using sdd_context_type = sdd::dd::context<C>;
 
@@ -40,17 +52,56 @@ private:
   /// @brief Cache homomorphisms evaluation.
   std::shared_ptr<cache_type> cache_;
 
+  /// @brief Cache applications of user's functions, nullptr if it's disabled.
+  std::shared_ptr<function_cache_type> function_cache_;
+
+  /// @brief Cache splits of SDD by selectors.
+  std::shared_ptr<split_cache_type> split_cache_;
+
   /// @brief Context of SDD operations.
   ///
   /// It already implements cheap-copy, we don't need to use a shared_ptr.
   sdd_context_type sdd_context_;
 
+  /// @brief Tell when evaluations should stop.
+  std::shared_ptr<hom::interruption<C>> interruption_;
+
+  /// @brief What evaluations of Saturation Fixpoints learned about their operands.
+  std::shared_ptr<hom::saturation_states<C>> saturations_;
+
+  /// @brief The number of Fixpoints being evaluated, nested ones included.
+  std::size_t fixpoints_;
+
+#ifdef LIBSDD_PROFILE
+  /// @brief Record applications of homomorphisms.
+  std::shared_ptr<hom::profiler<C>> profiler_;
+#endif
+
 public:
 
   /// @brief Construct a new context.
-  context(std::size_t size, sdd_context_type& sdd_cxt)
-   	: cache_(std::make_shared<cache_type>(*this, size))
+  /// @param table If not nullptr, the cache stores its entries in this computed table.
+  /// @param budget If not nullptr and table is nullptr, the cache adapts its capacity within it.
+  /// @param function_size The size of the cache of user's functions, 0 to disable it.
+  /// @param split_size The size of the cache of splits by selectors.
+  context( std::size_t size, sdd_context_type& sdd_cxt
+         , std::shared_ptr<mem::computed_table> table = nullptr
+         , std::shared_ptr<mem::cache_budget> budget = nullptr
+         , std::size_t function_size = 0, std::size_t split_size = 1000)
+   	: cache_(std::make_shared<cache_type>( *this, size, std::move(table), "homomorphism"
+                                         , std::move(budget)))
+    , function_cache_( function_size == 0
+                     ? nullptr
+                     : std::make_shared<function_cache_type>(*this, function_size, nullptr
+                                                            , "function"))
+    , split_cache_(std::make_shared<split_cache_type>(*this, split_size, nullptr, "split"))
     , sdd_context_(sdd_cxt)
+    , interruption_(std::make_shared<hom::interruption<C>>())
+    , saturations_(std::make_shared<hom::saturation_states<C>>())
+    , fixpoints_(0)
+#ifdef LIBSDD_PROFILE
+    , profiler_(std::make_shared<hom::profiler<C>>())
+#endif
   {}
 
   /// @brief Copy constructor.
@@ -64,6 +115,32 @@ public:
     return *cache_;
   }
 
+  /// @brief Tell if applications of user's functions are cached.
+  bool
+  has_function_cache()
+  const noexcept
+  {
+    return function_cache_ != nullptr;
+  }
+
+  /// @brief Return the cache of applications of user's functions.
+  ///
+  /// Only valid if has_function_cache().
+  function_cache_type&
+  function_cache()
+  noexcept
+  {
+    return *function_cache_;
+  }
+
+  /// @brief Return the cache of splits by selectors.
+  split_cache_type&
+  split_cache()
+  noexcept
+  {
+    return *split_cache_;
+  }
+
   /// @brief Return the context of SDD operations.
   sdd_context_type&
   sdd_context()
@@ -72,12 +149,117 @@ public:
     return sdd_context_;
   }
 
+  /// @brief Return the control of the interruption of evaluations.
+  hom::interruption<C>&
+  interruption()
+  noexcept
+  {
+    return *interruption_;
+  }
+
+  /// @brief Return the states of the evaluated Saturation Fixpoints.
+  hom::saturation_states<C>&
+  saturations()
+  noexcept
+  {
+    return *saturations_;
+  }
+
+#ifdef LIBSDD_PROFILE
+  /// @brief Return the profiler of homomorphisms applications.
+  hom::profiler<C>&
+  profiler()
+  noexcept
+  {
+    return *profiler_;
+  }
+#endif
+
+  /// @brief Count a Fixpoint as being evaluated as long as it lives.
+  class fixpoint_scope
+  {
+    // Can't copy a fixpoint_scope.
+    fixpoint_scope(const fixpoint_scope&) = delete;
+    fixpoint_scope& operator=(const fixpoint_scope&) = delete;
+
+    /// @brief The context of the Fixpoint.
+    context& cxt_;
+
+  public:
+
+    /// @brief Constructor.
+    fixpoint_scope(context& cxt)
+    noexcept
+      : cxt_(cxt)
+    {
+      ++cxt_.fixpoints_;
+    }
+
+    /// @brief Destructor.
+    ~fixpoint_scope()
+    {
+      --cxt_.fixpoints_;
+    }
+  };
+
+  /// @brief Called at each iteration of a Fixpoint, which must be in a fixpoint_scope.
+  ///
+  /// Caches adapt their capacity between two iterations of the outermost Fixpoint.
+  void
+  iteration(const SDD<C>& current)
+  {
+    interruption_->iteration(current);
+    if (fixpoints_ == 1)
+    {
+      adapt();
+    }
+  }
+
+  /// @brief Let caches adapt their capacity, if they decided to and no Fixpoint is being evaluated.
+  ///
+  /// Resizing a cache costs O(capacity). To avoid this stall deep in a recursive evaluation, caches
+  /// only record that they should adapt. It's then done at quiescent points, where no cache entry
+  /// is being read: when an operation started by the user returns, which calls this method, and
+  /// between two iterations of the outermost Fixpoint, see iteration().
+  void
+  adapt_caches()
+  {
+    if (fixpoints_ == 0)
+    {
+      adapt();
+    }
+  }
+
   /// @brief Remove all cache entries of this context.
+  ///
+  /// The states of Saturation Fixpoints which are no longer referenced are also removed.
   void
   clear()
   noexcept
   {
+    trace::instant("homomorphisms cache flush");
     cache_->clear();
+    if (function_cache_)
+    {
+      function_cache_->clear();
+    }
+    split_cache_->clear();
+    saturations_->sweep();
+  }
+
+private:
+
+  /// @brief Let all caches adapt their capacity, if they decided to.
+  void
+  adapt()
+  {
+    cache_->adapt();
+    if (function_cache_)
+    {
+      function_cache_->adapt();
+    }
+    split_cache_->adapt();
+    sdd_context_.adapt_caches();
   }
 };
 
@@ -42,21 +42,24 @@ class homomorphism final
 private:
 
   /// @brief A canonized homomorphism.
-  using data_type =  mem::variant< hom::_composition<C>
-                                 , hom::_cons<C, SDD<C>>
-                                 , hom::_cons<C, typename C::Values>
-                                 , hom::_constant<C>
-                                 , hom::_fixpoint<C>
-                                 , hom::_function<C>
-                                 , hom::_identity<C>
-                                 , hom::_if_then_else<C>
-                                 , hom::_inductive<C>
-                                 , hom::_intersection<C>
-                                 , hom::_local<C>
-                                 , hom::_saturation_fixpoint<C>
-                                 , hom::_saturation_intersection<C>
-                                 , hom::_saturation_sum<C>
-                                 , hom::_sum<C>>;
+  ///
+  /// The static inductives of the configuration are appended to the built-in operations.
+  using data_type = typename hom::static_inductives_variant< C, typename C::static_inductives
+                                                           , hom::_composition<C>
+                                                           , hom::_cons<C, SDD<C>>
+                                                           , hom::_cons<C, typename C::Values>
+                                                           , hom::_constant<C>
+                                                           , hom::_fixpoint<C>
+                                                           , hom::_function<C>
+                                                           , hom::_identity<C>
+                                                           , hom::_if_then_else<C>
+                                                           , hom::_inductive<C>
+                                                           , hom::_intersection<C>
+                                                           , hom::_local<C>
+                                                           , hom::_saturation_fixpoint<C>
+                                                           , hom::_saturation_intersection<C>
+                                                           , hom::_saturation_sum<C>
+                                                           , hom::_sum<C>>::type;
 
 public:
 
@@ -107,7 +110,10 @@ public:
   operator()(const order<C>& o, const SDD<C>& x)
   const
   {
-    return this->operator()(global<C>().hom_context, o, x);
+    auto& cxt = global<C>().hom_context;
+    auto res = this->operator()(cxt, o, x);
+    cxt.adapt_caches();
+    return res;
   }
 
   /// @brief Apply this homomorphism on an SDD.
@@ -115,27 +121,33 @@ public:
   operator()(const order<C>& o, SDD<C>&& x)
   const
   {
-    return this->operator()(global<C>().hom_context, o, std::move(x));
+    auto& cxt = global<C>().hom_context;
+    auto res = this->operator()(cxt, o, std::move(x));
+    cxt.adapt_caches();
+    return res;
   }
 
   /// @internal
   /// @brief Tell if this homomorphism skips a given identifier.
   ///
-  /// The identifier considered is the head of the given order (order::identifier()).
+  /// The identifier considered is the head of the given order (order::identifier()). The result
+  /// is computed once per position of the order.
   bool
   skip(const order<C>& o)
   const noexcept
   {
-    return visit([&](const auto& h){return h.skip(o);}, *this);
+    return global<C>().hom_unique_table.observer().skip(*ptr_, o);
   }
 
   /// @internal
   /// @brief Tell if this homomorphism returns only subsets.
+  ///
+  /// O(1), it's computed when the homomorphism is unified.
   bool
   selector()
   const noexcept
   {
-    return visit([](const auto& h){return h.selector();}, *this);
+    return global<C>().hom_unique_table.observer().selector(*ptr_);
   }
 
   /// @internal
@@ -191,17 +203,25 @@ public:
 
   /// @internal
   /// @brief Apply this homomorphism on an SDD, in a given context.
-  template <typename SDD_>
   SDD<C>
-  operator()(hom::context<C>& cxt, const order<C>& o, SDD_&& x)
+  operator()(hom::context<C>& cxt, const order<C>& o, const SDD<C>& x)
   const
   {
     // hard-wired cases:
     // - if the current homomorphism is Id, then directly return the operand
     // - if the current operand is |0|, then directly return it
-    return *this == id<C>() or x.empty()
-         ? x
-         : cxt.cache()({o, *this, std::forward<SDD_>(x)});
+    if (*this == id<C>() or x.empty())
+    {
+      return x;
+    }
+    // The key borrows the operands, they are copied in the cache only on a miss.
+    const hom::cached_homomorphism_key<C> key{o, *this, x};
+#ifdef LIBSDD_PROFILE
+    typename hom::profiler<C>::scope profile(cxt.profiler(), *this, x);
+    return profile(cxt.cache().evaluate(key, [&]{return key.operation();}));
+#else
+    return cxt.cache().evaluate(key, [&]{return key.operation();});
+#endif
   }
 
   /// @brief Equality.
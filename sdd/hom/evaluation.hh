@@ -8,20 +8,62 @@
 
 #include <cassert>
 #include <iosfwd>
+#include <unordered_map>
 
+#include "sdd/internal_manager_fwd.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/traits.hh"
 #include "sdd/order/order.hh"
+#include "sdd/util/deep_call.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd { namespace hom {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Apply a concrete homomorphism which needs the homomorphism it's the content of.
+///
+/// Compile-time dispatch.
+template <typename C, typename H>
+auto
+apply_concrete( const H& h, const homomorphism<C>& hom, context<C>& cxt, const order<C>& o
+              , const SDD<C>& x, int)
+-> decltype(h(cxt, o, x, hom))
+{
+  return h(cxt, o, x, hom);
+}
+
+/// @internal
+/// @brief Apply a concrete homomorphism.
+///
+/// Compile-time dispatch.
+template <typename C, typename H>
+SDD<C>
+apply_concrete( const H& h, const homomorphism<C>&, context<C>& cxt, const order<C>& o
+              , const SDD<C>& x, long)
+{
+  return h(cxt, o, x);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Evaluate an homomorphism.
 template <typename C>
 struct evaluation
 {
+  /// @brief The results of skipped levels evaluated without the cache, keyed by operands.
+  using jumps_type = std::unordered_map<SDD<C>, SDD<C>>;
+
+  /// @brief The number of skipped levels evaluated without the cache just above the current node.
+  std::size_t skipped;
+
+  /// @brief The results of the levels evaluated without the cache since the last cached level.
+  ///
+  /// As the skipped levels are only evaluated once per operand, sharing in SDD is preserved.
+  jumps_type* jumps;
+
   /// @brief Terminal |0| case.
   ///
   /// It shall never be called as the |0| case is handled by the evaluation of
@@ -41,11 +83,11 @@ struct evaluation
   template <typename H>
   SDD<C>
   operator()( const H& h, const one_terminal<C>&
-            , const homomorphism<C>&, const SDD<C>& x
+            , const homomorphism<C>& hom, const SDD<C>& x
             , context<C>& cxt, const order<C>& o)
   const
   {
-    return h(cxt, o, x);
+    return apply_concrete(h, hom, cxt, o, x, 0);
   }
 
   /// @brief Dispatch evaluation to the concrete homomorphism.
@@ -62,16 +104,29 @@ struct evaluation
     assert(not o.empty() && "Empty order.");
     assert(o.variable() == node.variable() && "Different variables in order and SDD.");
 
-    if (h.skip(o))
+    if (hom.skip(o))
     {
       // The evaluated homomorphism skips the current level. We can thus forward its application
       // to the following levels.
+      const auto next = o.next();
+      // When the next level is also skipped, jump directly to its evaluation rather than storing
+      // a pass-through operation in the cache, up to the configured period.
+      const bool jump = skipped + 1 < global<C>().hom_skip_cache_period
+                    and not next.empty() and hom.skip(next);
+      jumps_type local_jumps;
+      jumps_type& next_jumps = jumps ? *jumps : local_jumps;
       mem::rewinder _(cxt.sdd_context().arena());
       dd::square_union<C, typename Node::valuation_type> su(cxt.sdd_context());
       su.reserve(node.size());
       for (const auto& arc : node)
       {
-        SDD<C> new_successor = hom(cxt, o.next(), arc.successor());
+        // A long chain of skipped levels may be deeper than the stack.
+        SDD<C> new_successor = util::deep_call([&]
+                               {
+                                 return jump
+                                      ? this->jump(hom, arc.successor(), cxt, next, next_jumps)
+                                      : hom(cxt, next, arc.successor());
+                               });
         if (not new_successor.empty())
         {
           su.add(std::move(new_successor), arc.valuation());
@@ -81,8 +136,57 @@ struct evaluation
     }
     else
     {
-      return h(cxt, o, x);
+      return apply_concrete(h, hom, cxt, o, x, 0);
+    }
+  }
+
+private:
+
+  /// @brief Evaluate a skipped level without the cache.
+  SDD<C>
+  jump( const homomorphism<C>& hom, const SDD<C>& x, context<C>& cxt, const order<C>& o
+      , jumps_type& next_jumps)
+  const
+  {
+    const auto search = next_jumps.find(x);
+    if (search != next_jumps.end())
+    {
+      return search->second;
     }
+    auto res = binary_visit(evaluation<C>{skipped + 1, &next_jumps}, hom, x, hom, x, cxt, o);
+    next_jumps.emplace(x, res);
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Identify an order cursor in the operations stored in caches.
+///
+/// Unlike a copy of the cursor, it doesn't own the nodes of the order. As serials are never
+/// reused, it can't be mistaken for a cursor on other nodes once these ones are released.
+struct cached_order
+{
+  /// @brief The serial of the nodes of the order.
+  const std::size_t serial;
+
+  /// @brief The position of the head of the order, 0 if it's empty.
+  const order_position_type position;
+
+  /// @brief Constructor.
+  template <typename C>
+  cached_order(const order<C>& o)
+  noexcept
+    : serial(o.serial()), position(o.empty() ? 0 : o.position())
+  {}
+
+  friend
+  bool
+  operator==(const cached_order& lhs, const cached_order& rhs)
+  noexcept
+  {
+    return lhs.serial == rhs.serial and lhs.position == rhs.position;
   }
 };
 
@@ -90,11 +194,16 @@ struct evaluation
 
 /// @internal
 /// @brief The evaluation of an homomorphism in the cache.
+///
+/// It's stored by the cache, which looks it up and evaluates it with a cached_homomorphism_key.
 template <typename C>
 struct cached_homomorphism
 {
-  /// @brief The current order position.
-  const order<C> ord;
+  /// @brief The type of the result of the evaluation.
+  using result_type = SDD<C>;
+
+  /// @brief The current order position, which doesn't own the nodes of the order.
+  const cached_order ord;
 
   /// @brief The homomorphism to evaluate.
   const homomorphism<C> hom;
@@ -102,6 +211,34 @@ struct cached_homomorphism
   /// @brief The homomorphism's operand.
   const SDD<C> sdd;
 
+  friend
+  bool
+  operator==(const cached_homomorphism& lhs, const cached_homomorphism& rhs)
+  noexcept
+  {
+    return lhs.hom == rhs.hom and lhs.sdd == rhs.sdd and lhs.ord == rhs.ord;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Describe the evaluation of an homomorphism to look it up in the cache.
+///
+/// It borrows the caller's order, homomorphism and operand, thus a hit doesn't copy them. The
+/// cached_homomorphism which owns them is built only on a miss, once the evaluation is done.
+template <typename C>
+struct cached_homomorphism_key
+{
+  /// @brief The current order position.
+  const order<C>& ord;
+
+  /// @brief The homomorphism to evaluate.
+  const homomorphism<C>& hom;
+
+  /// @brief The homomorphism's operand.
+  const SDD<C>& sdd;
+
   /// @brief Launch the evaluation.
   ///
   /// Called by the cache.
@@ -109,15 +246,28 @@ struct cached_homomorphism
   operator()(context<C>& cxt)
   const
   {
-    return binary_visit(evaluation<C>{}, hom, sdd, hom, sdd, cxt, ord);
+#ifdef LIBSDD_PROFILE
+    cxt.profiler().evaluated();
+#endif
+    cxt.interruption().evaluation();
+    trace::scope _("hom");
+    return binary_visit(evaluation<C>{0, nullptr}, hom, sdd, hom, sdd, cxt, ord);
+  }
+
+  /// @brief Build the operation stored in the cache.
+  cached_homomorphism<C>
+  operation()
+  const
+  {
+    return {ord, hom, sdd};
   }
 
   friend
   bool
-  operator==(const cached_homomorphism& lhs, const cached_homomorphism& rhs)
+  operator==(const cached_homomorphism_key& lhs, const cached_homomorphism<C>& rhs)
   noexcept
   {
-    return lhs.hom == rhs.hom and lhs.sdd == rhs.sdd;
+    return lhs.hom == rhs.hom and lhs.sdd == rhs.sdd and cached_order(lhs.ord) == rhs.ord;
   }
 };
 
@@ -139,10 +289,10 @@ struct should_cache
 
   /// @brief Application of should_cache.
   bool
-  operator()(const cached_homomorphism<C>& ch)
+  operator()(const cached_homomorphism_key<C>& key)
   const noexcept
   {
-    return visit(*this, ch.hom);
+    return visit(*this, key.hom);
   }
 };
 
@@ -154,10 +304,22 @@ namespace std {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Hash specialization for sdd::hom::cached_order
+template <>
+struct hash<sdd::hom::cached_order>
+{
+  std::size_t
+  operator()(const sdd::hom::cached_order& o)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed(o.serial) (val(o.position));
+  }
+};
+
 /// @internal
 /// @brief Hash specialization for sdd::hom::cached_homomorphism
-///
-/// We don't need to hash order as the SDD operand brings the same information.
 template <typename C>
 struct hash<sdd::hom::cached_homomorphism<C>>
 {
@@ -166,7 +328,23 @@ struct hash<sdd::hom::cached_homomorphism<C>>
   const
   {
     using namespace sdd::hash;
-    return seed(ch.hom) (val(ch.sdd));
+    return seed(ch.hom) (val(ch.sdd)) (val(ch.ord));
+  }
+};
+
+/// @internal
+/// @brief Hash specialization for sdd::hom::cached_homomorphism_key
+///
+/// Same as the hash of the operation it describes.
+template <typename C>
+struct hash<sdd::hom::cached_homomorphism_key<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::cached_homomorphism_key<C>& key)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(key.hom) (val(key.sdd)) (val(sdd::hom::cached_order(key.ord)));
   }
 };
 
@@ -0,0 +1,411 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // remove_if
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception> // current_exception, make_exception_ptr
+#include <future>
+#include <memory>    // make_shared, shared_ptr, unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility>   // move
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/interrupt.hh"
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The result of an asynchronous application of an homomorphism.
+///
+/// It's shared by the handle and the executor, which releases it when it stops: a result can't
+/// hold an SDD once the library is released.
+template <typename C>
+struct async_result
+{
+  /// @brief Protect the value.
+  std::mutex mutex;
+
+  /// @brief The resulting SDD, until it's retrieved or released.
+  boost::optional<SDD<C>> value;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief The handle of an asynchronous application of an homomorphism.
+///
+/// The library lock must not be held while waiting for the result. A handle can outlive the
+/// manager: the result is then released with the library.
+template <typename C>
+class async_evaluation
+{
+  // Can't copy an async_evaluation.
+  async_evaluation(const async_evaluation&) = delete;
+  async_evaluation& operator=(const async_evaluation&) = delete;
+
+  // Can't assign an async_evaluation.
+  async_evaluation& operator=(async_evaluation&&) = delete;
+
+private:
+
+  /// @brief Ready when the evaluation is finished.
+  std::future<void> future_;
+
+  /// @brief The result, set before future_ is ready.
+  std::shared_ptr<async_result<C>> result_;
+
+  /// @brief Cancel this evaluation.
+  cancellation_token token_;
+
+  /// @brief The library lock.
+  std::shared_ptr<std::recursive_mutex> library_;
+
+public:
+
+  /// @internal
+  async_evaluation( std::future<void>&& future, std::shared_ptr<async_result<C>> result
+                  , cancellation_token token, std::shared_ptr<std::recursive_mutex> library)
+    : future_(std::move(future)), result_(std::move(result)), token_(std::move(token))
+    , library_(std::move(library))
+  {}
+
+  /// @brief Move constructor.
+  async_evaluation(async_evaluation&&) = default;
+
+  /// @brief Destructor.
+  ///
+  /// If the result was not retrieved, the evaluation is cancelled.
+  ~async_evaluation()
+  {
+    if (future_.valid())
+    {
+      token_.cancel();
+      // The result may hold an SDD, thus it's released while the library is locked.
+      std::lock_guard<std::recursive_mutex> lock(*library_);
+      std::lock_guard<std::mutex> result_lock(result_->mutex);
+      result_->value = boost::none;
+    }
+  }
+
+  /// @brief Wait for the result.
+  /// @throw interrupted if the evaluation was cancelled or if the library was released, or the
+  /// exception thrown by the evaluation.
+  ///
+  /// It can only be called once.
+  SDD<C>
+  get()
+  {
+    future_.get();
+    // Moving the result doesn't use the library, thus the library lock is not needed.
+    std::lock_guard<std::mutex> lock(result_->mutex);
+    if (not result_->value)
+    {
+      throw interrupted(interrupted::cause::cancelled);
+    }
+    auto res = std::move(*result_->value);
+    result_->value = boost::none;
+    return res;
+  }
+
+  /// @brief Wait until the result is available.
+  void
+  wait()
+  const
+  {
+    future_.wait();
+  }
+
+  /// @brief Wait until the result is available or a duration has passed.
+  /// @return true if the result is available.
+  template <typename Rep, typename Period>
+  bool
+  wait_for(const std::chrono::duration<Rep, Period>& duration)
+  const
+  {
+    return future_.wait_for(duration) == std::future_status::ready;
+  }
+
+  /// @brief Ask the evaluation to stop, or not to start if it's still queued.
+  ///
+  /// The result is then an interrupted exception, unless the evaluation was already finished.
+  void
+  cancel()
+  noexcept
+  {
+    token_.cancel();
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Apply homomorphisms on a background thread, one at a time.
+///
+/// The library is not thread-safe (reference counts, unique tables and caches are not protected),
+/// thus evaluations can't run concurrently. The background thread holds the library lock while it
+/// evaluates, and other threads must hold it to use the library as long as evaluations are queued.
+template <typename C>
+class executor
+{
+  // Can't copy an executor.
+  executor(const executor&) = delete;
+  executor& operator=(const executor&) = delete;
+
+private:
+
+  /// @brief A queued application.
+  struct task
+  {
+    const homomorphism<C> h;
+    const order<C> o;
+    const SDD<C> x;
+    std::promise<void> promise;
+    const std::shared_ptr<async_result<C>> result;
+    const std::shared_ptr<cancellation_token> token;
+  };
+
+  /// @brief The context of evaluations.
+  context<C>& cxt_;
+
+  /// @brief Protect the library.
+  const std::shared_ptr<std::recursive_mutex> library_;
+
+  /// @brief Protect the queue.
+  std::mutex queue_mutex_;
+
+  /// @brief Wake up the background thread.
+  std::condition_variable queue_cv_;
+
+  /// @brief Applications waiting to be evaluated.
+  std::deque<std::unique_ptr<task>> queue_;
+
+  /// @brief The token of the running task, if any.
+  std::shared_ptr<cancellation_token> running_;
+
+  /// @brief The results delivered to handles, released when this executor stops.
+  ///
+  /// Only accessed with the library lock.
+  std::vector<std::weak_ptr<async_result<C>>> delivered_;
+
+  /// @brief Ask the background thread to stop.
+  bool stop_;
+
+  /// @brief The background thread, started at the first application.
+  std::thread thread_;
+
+public:
+
+  /// @brief Constructor.
+  executor(context<C>& cxt)
+    : cxt_(cxt), library_(std::make_shared<std::recursive_mutex>()), queue_mutex_(), queue_cv_()
+    , queue_(), running_(), delivered_(), stop_(false), thread_()
+  {}
+
+  /// @brief Destructor.
+  ~executor()
+  {
+    stop();
+  }
+
+  /// @brief Stop the background thread.
+  ///
+  /// Queued evaluations are cancelled, the running one is asked to stop. Results not retrieved yet
+  /// are released, as handles may outlive the library.
+  void
+  stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stop_ = true;
+      if (running_)
+      {
+        running_->cancel();
+      }
+    }
+    queue_cv_.notify_one();
+    if (thread_.joinable())
+    {
+      thread_.join();
+    }
+    std::lock_guard<std::recursive_mutex> library_lock(*library_);
+    for (auto& t : queue_)
+    {
+      t->promise.set_exception(cancelled());
+    }
+    queue_.clear();
+    for (const auto& weak : delivered_)
+    {
+      if (const auto result = weak.lock())
+      {
+        std::lock_guard<std::mutex> result_lock(result->mutex);
+        result->value = boost::none;
+      }
+    }
+    delivered_.clear();
+  }
+
+  /// @brief Get the lock of the library.
+  std::unique_lock<std::recursive_mutex>
+  lock()
+  {
+    return std::unique_lock<std::recursive_mutex>(*library_);
+  }
+
+  /// @brief Queue the application of an homomorphism.
+  ///
+  /// Copying operands modifies reference counts, thus it takes the library lock: it waits for the
+  /// end of the running evaluation, if any.
+  async_evaluation<C>
+  apply(const homomorphism<C>& h, const order<C>& o, const SDD<C>& x)
+  {
+    std::lock_guard<std::recursive_mutex> library_lock(*library_);
+    return push(homomorphism<C>(h), order<C>(o), SDD<C>(x));
+  }
+
+  /// @brief Queue the application of an homomorphism, taking ownership of its operands.
+  ///
+  /// Moving operands doesn't modify reference counts and copying an order doesn't touch the
+  /// library, thus it doesn't take the library lock: it returns immediately, even while an
+  /// evaluation is running. The order is copied, as o may only borrow its nodes.
+  async_evaluation<C>
+  apply(homomorphism<C>&& h, order<C> o, SDD<C>&& x)
+  {
+    return push(std::move(h), order<C>(o), std::move(x));
+  }
+
+private:
+
+  /// @brief The result of a cancelled evaluation.
+  static
+  std::exception_ptr
+  cancelled()
+  {
+    return std::make_exception_ptr(interrupted(interrupted::cause::cancelled));
+  }
+
+  /// @brief Queue a task, under the queue lock only.
+  async_evaluation<C>
+  push(homomorphism<C>&& h, order<C>&& o, SDD<C>&& x)
+  {
+    cancellation_token token;
+    auto result = std::make_shared<async_result<C>>();
+    auto t = std::unique_ptr<task>(new task{ std::move(h), std::move(o), std::move(x)
+                                           , std::promise<void>(), result
+                                           , std::make_shared<cancellation_token>(token)});
+    auto future = t->promise.get_future();
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      queue_.push_back(std::move(t));
+      if (not thread_.joinable())
+      {
+        thread_ = std::thread([this]{run();});
+      }
+    }
+    queue_cv_.notify_one();
+    return {std::move(future), std::move(result), std::move(token), library_};
+  }
+
+  /// @brief Give a result to its handle, with the library lock.
+  void
+  deliver(const std::shared_ptr<async_result<C>>& result, SDD<C>&& value)
+  {
+    if (delivered_.size() == delivered_.capacity())
+    {
+      // Forget the results already retrieved or released before growing.
+      delivered_.erase( std::remove_if( delivered_.begin(), delivered_.end()
+                                      , [](const auto& weak){return weak.expired();})
+                      , delivered_.end());
+    }
+    delivered_.emplace_back(result);
+    std::lock_guard<std::mutex> lock(result->mutex);
+    result->value = std::move(value);
+  }
+
+  /// @brief The loop of the background thread.
+  void
+  run()
+  {
+    while (true)
+    {
+      std::unique_ptr<task> t;
+      {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        queue_cv_.wait(lock, [this]{return stop_ or not queue_.empty();});
+        if (stop_)
+        {
+          return;
+        }
+        t = std::move(queue_.front());
+        queue_.pop_front();
+        running_ = t->token;
+      }
+
+      std::lock_guard<std::recursive_mutex> library_lock(*library_);
+      boost::optional<SDD<C>> result;
+      std::exception_ptr error;
+      if (t->token->cancelled())
+      {
+        error = cancelled();
+      }
+      else
+      {
+        cxt_.interruption().task_token(t->token);
+        try
+        {
+          result = t->h(cxt_, t->o, t->x);
+          cxt_.adapt_caches();
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+        cxt_.interruption().task_token(nullptr);
+      }
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        running_.reset();
+      }
+      if (not error)
+      {
+        try
+        {
+          deliver(t->result, std::move(*result));
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+      }
+      // Operands are released before the caller is notified.
+      auto promise = std::move(t->promise);
+      t.reset();
+      if (error)
+      {
+        promise.set_exception(error);
+      }
+      else
+      {
+        promise.set_value();
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
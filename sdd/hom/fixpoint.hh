@@ -6,21 +6,54 @@
 
 #pragma once
 
-#include <iosfwd>
+#include <algorithm> // find
+#include <cstdint>   // uint64_t
+#include <ostream>
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/sum.hh"
 #include "sdd/order/order.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd {
 
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief How a Fixpoint is evaluated.
+enum class fixpoint_mode
+{
+  /// @brief Apply the operand to all states reached so far, until they don't change.
+  whole,
+  /// @brief When the operand is Id + T, only apply T to the states discovered by the last
+  /// iteration (breadth-first search); otherwise, same as whole.
+  frontier,
+  /// @brief Like frontier, but each operand of T is also applied to the states discovered by the
+  /// previous operands in the same iteration.
+  chaining
+};
+
+/// @brief Textual output of a fixpoint_mode.
+inline
+std::ostream&
+operator<<(std::ostream& os, fixpoint_mode mode)
+{
+  switch (mode)
+  {
+    case fixpoint_mode::whole    : return os << "whole";
+    case fixpoint_mode::frontier : return os << "frontier";
+    case fixpoint_mode::chaining : return os << "chaining";
+  }
+  return os;
+}
+
 // Forward declaration needed by fixpoint_builder_helper.
 template <typename C>
 homomorphism<C>
-fixpoint(const homomorphism<C>&);
+fixpoint(const homomorphism<C>&, fixpoint_mode = fixpoint_mode::frontier);
 
 namespace hom {
 
@@ -34,21 +67,102 @@ struct _fixpoint
   /// @brief The homomorphism to apply until a fixpoint is reached.
   const homomorphism<C> h;
 
+  /// @brief How this fixpoint is evaluated.
+  const fixpoint_mode mode;
+
   /// @brief Evaluation.
   SDD<C>
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
   const
   {
+    trace::scope span("fixpoint", false /* not sampled */);
+    typename context<C>::fixpoint_scope _(cxt);
+    if (mode != fixpoint_mode::whole and mem::is<_sum<C>>(h))
+    {
+      const auto& s = mem::variant_cast<const _sum<C>>(*h);
+      if (std::find(s.begin(), s.end(), id<C>()) != s.end())
+      {
+        return mode == fixpoint_mode::chaining
+             ? chaining(cxt, o, x, s, span)
+             : frontier(cxt, o, x, s, span);
+      }
+    }
     SDD<C> x1 = x;
     SDD<C> x2 = x1;
+    std::uint64_t iterations = 0;
     do
     {
+      ++iterations;
+      cxt.iteration(x1);
       x2 = x1;
       swap(x1, h(cxt, o, x1));
     } while (x1 != x2);
+    span.result("iterations", iterations);
     return x1;
   }
 
+  /// @brief Evaluation of (Id + T)*, by applying T only to newly discovered states.
+  SDD<C>
+  frontier( context<C>& cxt, const order<C>& o, const SDD<C>& x, const _sum<C>& s
+          , trace::scope& span)
+  const
+  {
+    auto& sdd_cxt = cxt.sdd_context();
+    SDD<C> reached = x;
+    SDD<C> next = x;
+    std::uint64_t iterations = 0;
+    while (next != zero<C>())
+    {
+      ++iterations;
+      cxt.iteration(reached);
+      dd::sum_builder<C, SDD<C>> images(sdd_cxt);
+      images.reserve(s.size);
+      for (const auto& t : s)
+      {
+        if (t != id<C>())
+        {
+          images.add(t(cxt, o, next));
+        }
+      }
+      next = dd::difference(sdd_cxt, dd::sum(sdd_cxt, std::move(images)), reached);
+      reached = dd::sum(sdd_cxt, reached, next);
+    }
+    span.result("iterations", iterations);
+    return reached;
+  }
+
+  /// @brief Evaluation of (Id + T)*, by chaining the operands of T on newly discovered states.
+  SDD<C>
+  chaining( context<C>& cxt, const order<C>& o, const SDD<C>& x, const _sum<C>& s
+          , trace::scope& span)
+  const
+  {
+    auto& sdd_cxt = cxt.sdd_context();
+    SDD<C> reached = x;
+    SDD<C> next = x;
+    std::uint64_t iterations = 0;
+    while (next != zero<C>())
+    {
+      ++iterations;
+      cxt.iteration(reached);
+      // States discovered by an operand are immediately given to the following ones.
+      SDD<C> discovered = zero<C>();
+      for (const auto& t : s)
+      {
+        if (t != id<C>())
+        {
+          const auto image = dd::difference(sdd_cxt, t(cxt, o, next), reached);
+          reached = dd::sum(sdd_cxt, reached, image);
+          next = dd::sum(sdd_cxt, next, image);
+          discovered = dd::sum(sdd_cxt, discovered, image);
+        }
+      }
+      next = discovered;
+    }
+    span.result("iterations", iterations);
+    return reached;
+  }
+
   /// @brief Skip predicate.
   bool
   skip(const order<C>& o)
@@ -70,14 +184,16 @@ struct _fixpoint
   operator==(const _fixpoint& lhs, const _fixpoint& rhs)
   noexcept
   {
-    return lhs.h == rhs.h;
+    return lhs.h == rhs.h and lhs.mode == rhs.mode;
   }
 
   friend
   std::ostream&
   operator<<(std::ostream& os, const _fixpoint& f)
   {
-    return os << "(" << f.h << ")*";
+    os << "(" << f.h << ")*";
+    // Only the default mode is implicit.
+    return f.mode == fixpoint_mode::frontier ? os : os << "[" << f.mode << "]";
   }
 };
 
@@ -89,14 +205,14 @@ template <typename C>
 struct fixpoint_builder
 {
   homomorphism<C>
-  operator()(const _identity<C>&, const homomorphism<C>& h)
+  operator()(const _identity<C>&, const homomorphism<C>& h, fixpoint_mode)
   const noexcept
   {
     return h;
   }
 
   homomorphism<C>
-  operator()(const _fixpoint<C>&, const homomorphism<C>& h)
+  operator()(const _fixpoint<C>&, const homomorphism<C>& h, fixpoint_mode)
   const noexcept
   {
     return h;
@@ -104,10 +220,10 @@ struct fixpoint_builder
 
   template <typename T>
   homomorphism<C>
-  operator()(const T&, const homomorphism<C>& h)
+  operator()(const T&, const homomorphism<C>& h, fixpoint_mode mode)
   const noexcept
   {
-    return hom::make<C, _fixpoint<C>>(h);
+    return hom::make<C, _fixpoint<C>>(h, mode);
   }
 };
 
@@ -116,12 +232,13 @@ struct fixpoint_builder
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief Create the Fixpoint homomorphism.
+/// @param mode How it's evaluated; by default, when h is Id + T, T is only applied to new states.
 /// @related homomorphism
 template <typename C>
 homomorphism<C>
-fixpoint(const homomorphism<C>& h)
+fixpoint(const homomorphism<C>& h, fixpoint_mode mode)
 {
-  return visit(hom::fixpoint_builder<C>{}, h, h);
+  return visit(hom::fixpoint_builder<C>{}, h, h, mode);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -142,7 +259,7 @@ struct hash<sdd::hom::_fixpoint<C>>
   const
   {
     using namespace sdd::hash;
-    return seed(345789) (val(f.h));
+    return seed(345789) (val(f.h)) (val(static_cast<int>(f.mode)));
   }
 };
 
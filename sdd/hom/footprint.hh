@@ -0,0 +1,316 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm>     // lower_bound, upper_bound
+#include <unordered_map>
+#include <vector>
+
+#include "sdd/hom/composition.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/fixpoint.hh"
+#include "sdd/hom/function.hh"
+#include "sdd/hom/identity.hh"
+#include "sdd/hom/if_then_else.hh"
+#include "sdd/hom/intersection.hh"
+#include "sdd/hom/local.hh"
+#include "sdd/hom/sum.hh"
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Forward declaration.
+template <typename C> struct _saturation_fixpoint;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The variables of a level that an homomorphism may read or write.
+///
+/// It's an over-approximation: some variables, and possibly all variables from a given one down
+/// to the bottom of the level (variables are numbered from the bottom, the last one being 0).
+template <typename C>
+struct footprint
+{
+  /// @brief A variable type.
+  using variable_type = typename C::variable_type;
+
+  /// @brief Above this number of variables, they are approximated by all the variables below.
+  static constexpr std::size_t max_variables = 64;
+
+  /// @brief The variables above top, sorted.
+  std::vector<variable_type> variables;
+
+  /// @brief Tell if all the variables below top are also touched.
+  bool open;
+
+  /// @brief The highest of the variables touched from the bottom, if open.
+  variable_type top;
+
+  /// @brief Default constructor, for an homomorphism which touches nothing.
+  footprint()
+    : variables{}, open{false}, top{0}
+  {}
+
+  /// @brief Add a variable.
+  void
+  add(variable_type v)
+  {
+    if (open and v <= top)
+    {
+      return;
+    }
+    const auto it = std::lower_bound(variables.begin(), variables.end(), v);
+    if (it == variables.end() or *it != v)
+    {
+      variables.insert(it, v);
+      if (variables.size() > max_variables)
+      {
+        add_below(variables.back());
+      }
+    }
+  }
+
+  /// @brief Add a variable and all variables below.
+  void
+  add_below(variable_type v)
+  {
+    if (open and v <= top)
+    {
+      return;
+    }
+    open = true;
+    top = v;
+    variables.erase( variables.begin()
+                   , std::upper_bound(variables.begin(), variables.end(), v));
+  }
+
+  /// @brief Add the variables of another footprint.
+  void
+  merge(const footprint& other)
+  {
+    if (other.open)
+    {
+      add_below(other.top);
+    }
+    for (const auto v : other.variables)
+    {
+      add(v);
+    }
+  }
+
+  /// @brief Tell if two footprints have a variable in common.
+  friend
+  bool
+  meet(const footprint& lhs, const footprint& rhs)
+  noexcept
+  {
+    if (lhs.open and rhs.open)
+    {
+      return true;
+    }
+    if (lhs.open and not rhs.variables.empty() and rhs.variables.front() <= lhs.top)
+    {
+      return true;
+    }
+    if (rhs.open and not lhs.variables.empty() and lhs.variables.front() <= rhs.top)
+    {
+      return true;
+    }
+    auto l = lhs.variables.begin();
+    auto r = rhs.variables.begin();
+    while (l != lhs.variables.end() and r != rhs.variables.end())
+    {
+      if (*l < *r)
+      {
+        ++l;
+      }
+      else if (*r < *l)
+      {
+        ++r;
+      }
+      else
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+template <typename C>
+constexpr std::size_t footprint<C>::max_variables;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Compute the footprint of an homomorphism on the head of an order.
+///
+/// Local and function homomorphisms touch their target, identity touches nothing, and
+/// homomorphisms built with operators touch what their operands touch. Other homomorphisms,
+/// like inductive ones, may create new homomorphisms when they are evaluated: they are assumed to
+/// touch all variables from the first one they don't skip.
+template <typename C>
+struct footprint_visitor
+{
+  /// @brief The order on which footprints are computed.
+  const order<C>& o_;
+
+  /// @brief Nodes are unified and immutable, their addresses identify them.
+  mutable std::unordered_map<const void*, footprint<C>> cache_;
+
+  footprint<C>
+  operator()(const _identity<C>&, const homomorphism<C>&)
+  const
+  {
+    return {};
+  }
+
+  footprint<C>
+  operator()(const _local<C>& l, const homomorphism<C>&)
+  const
+  {
+    footprint<C> res;
+    res.add(l.target);
+    return res;
+  }
+
+  footprint<C>
+  operator()(const _function<C>& f, const homomorphism<C>&)
+  const
+  {
+    footprint<C> res;
+    res.add(f.target);
+    return res;
+  }
+
+  footprint<C>
+  operator()(const _composition<C>& c, const homomorphism<C>&)
+  const
+  {
+    return cached(c, [&](footprint<C>& res){merge(res, c.left); merge(res, c.right);});
+  }
+
+  footprint<C>
+  operator()(const _fixpoint<C>& f, const homomorphism<C>&)
+  const
+  {
+    return cached(f, [&](footprint<C>& res){merge(res, f.h);});
+  }
+
+  footprint<C>
+  operator()(const _if_then_else<C>& i, const homomorphism<C>&)
+  const
+  {
+    return cached(i, [&](footprint<C>& res)
+                     {
+                       merge(res, i.h_if);
+                       merge(res, i.h_then);
+                       merge(res, i.h_else);
+                     });
+  }
+
+  footprint<C>
+  operator()(const _intersection<C>& i, const homomorphism<C>&)
+  const
+  {
+    return cached(i, [&](footprint<C>& res)
+                     {
+                       for (const auto& h : i)
+                       {
+                         merge(res, h);
+                       }
+                     });
+  }
+
+  footprint<C>
+  operator()(const _saturation_fixpoint<C>& s, const homomorphism<C>&)
+  const
+  {
+    return cached(s, [&](footprint<C>& res)
+                     {
+                       merge(res, s.F);
+                       merge(res, s.L);
+                       for (const auto& g : s)
+                       {
+                         merge(res, g);
+                       }
+                     });
+  }
+
+  footprint<C>
+  operator()(const _sum<C>& s, const homomorphism<C>&)
+  const
+  {
+    return cached(s, [&](footprint<C>& res)
+                     {
+                       for (const auto& h : s)
+                       {
+                         merge(res, h);
+                       }
+                     });
+  }
+
+  /// @brief Any other homomorphism touches everything from the first variable it doesn't skip.
+  template <typename T>
+  footprint<C>
+  operator()(const T&, const homomorphism<C>& h)
+  const
+  {
+    auto cursor = o_;
+    while (not cursor.empty() and h.skip(cursor))
+    {
+      cursor = cursor.next();
+    }
+    // When all variables are skipped, the homomorphism is applied on |1|.
+    footprint<C> res;
+    res.add_below(cursor.empty() ? 0 : cursor.variable());
+    return res;
+  }
+
+private:
+
+  void
+  merge(footprint<C>& res, const homomorphism<C>& h)
+  const
+  {
+    res.merge(visit(*this, h, h));
+  }
+
+  template <typename H, typename Fun>
+  footprint<C>
+  cached(const H& h, Fun&& fun)
+  const
+  {
+    const auto search = cache_.find(&h);
+    if (search != cache_.end())
+    {
+      return search->second;
+    }
+    footprint<C> res;
+    fun(res);
+    cache_.emplace(&h, res);
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Get the variables an homomorphism may read or write when applied on an order.
+template <typename C>
+footprint<C>
+get_footprint(const order<C>& o, const homomorphism<C>& h)
+{
+  return visit(footprint_visitor<C>{o, {}}, h, h);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
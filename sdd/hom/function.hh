@@ -8,12 +8,14 @@
 
 #include <algorithm> // find
 #include <iosfwd>
-#include <memory>    // unique_ptr
+#include <memory>    // shared_ptr
 #include <typeinfo>  // typeid
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/split.hh"
+#include "sdd/util/hash.hh"
 #include "sdd/util/packed.hh"
 #include "sdd/order/carrier.hh"
 #include "sdd/order/order.hh"
@@ -208,6 +210,66 @@ private:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief The application of a user's function on a valuation, stored in the cache of functions.
+template <typename C>
+struct cached_function
+{
+  /// @brief The type of a set of values.
+  using values_type = typename C::Values;
+
+  /// @brief The user's function.
+  ///
+  /// It's shared with its homomorphism to keep it alive as long as this operation is cached, thus
+  /// its address can't be reused by another function.
+  const std::shared_ptr<const function_base<C>> fun;
+
+  /// @brief The valuation on which the function is applied.
+  const values_type val;
+
+  /// @brief Apply the user's function.
+  ///
+  /// Called by the cache.
+  values_type
+  operator()(context<C>&)
+  const
+  {
+    return (*fun)(val);
+  }
+
+  friend
+  bool
+  operator==(const cached_function& lhs, const cached_function& rhs)
+  noexcept
+  {
+    return lhs.fun == rhs.fun and lhs.val == rhs.val;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Describe a cached_function to look it up without building it.
+template <typename C>
+struct function_application
+{
+  /// @brief The user's function.
+  const function_base<C>* fun;
+
+  /// @brief The valuation on which the function is applied.
+  const typename C::Values& val;
+
+  friend
+  bool
+  operator==(const function_application& lhs, const cached_function<C>& rhs)
+  noexcept
+  {
+    return lhs.fun == rhs.fun.get() and lhs.val == rhs.val;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C>
 struct LIBSDD_ATTRIBUTE_PACKED _function
@@ -218,15 +280,18 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
   /// @brief The identifier on which the user function is applied.
   const typename C::variable_type target;
 
-  /// @brief Ownership of the user's values function.
-  const std::unique_ptr<const function_base<C>> fun_ptr;
+  /// @brief Ownership of the user's values function, shared with the cache of functions.
+  const std::shared_ptr<const function_base<C>> fun_ptr;
 
   /// @brief Dispatch the Values homomorphism evaluation.
   struct evaluation
   {
+    /// @brief The type of the shared user's function.
+    using function_ptr_type = std::shared_ptr<const function_base<C>>;
+
     /// @brief |0| case, should never happen.
     SDD<C>
-    operator()(const zero_terminal<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const zero_terminal<C>&, const function_ptr_type&, context<C>&, const order<C>&)
     const noexcept
     {
       assert(false);
@@ -235,7 +300,7 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
 
     /// @brief |1| case.
     SDD<C>
-    operator()(const one_terminal<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const one_terminal<C>&, const function_ptr_type&, context<C>&, const order<C>&)
     const
     {
       return one<C>();
@@ -243,7 +308,7 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
 
     /// @brief A function can't be applied on an hierarchical node.
     SDD<C>
-    operator()(const hierarchical_node<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const hierarchical_node<C>&, const function_ptr_type&, context<C>&, const order<C>&)
     const
     {
       assert(false && "Apply function on an hierarchical node");
@@ -252,17 +317,17 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
 
     /// @brief Evaluation on a flat node.
     SDD<C>
-    operator()( const flat_node<C>& node, const function_base<C>& fun, context<C>& cxt
+    operator()( const flat_node<C>& node, const function_ptr_type& fun, context<C>& cxt
               , const order<C>& o)
     const
     {
-      if (fun.selector() or fun.shifter())
+      if (fun->selector() or fun->shifter())
       {
         dd::alpha_builder<C, values_type> alpha_builder(cxt.sdd_context());
         alpha_builder.reserve(node.size());
         for (const auto& arc : node)
         {
-          values_type val = fun(arc.valuation());
+          values_type val = apply(fun, arc.valuation(), cxt);
           if (not val.empty())
           {
             alpha_builder.add(std::move(val), arc.successor());
@@ -276,11 +341,24 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
         sum_operands.reserve(node.size());
         for (const auto& arc : node)
         {
-          sum_operands.add(SDD<C>(o.variable(), fun(arc.valuation()), arc.successor()));
+          sum_operands.add(SDD<C>(o.variable(), apply(fun, arc.valuation(), cxt), arc.successor()));
         }
         return dd::sum(cxt.sdd_context(), std::move(sum_operands));
       }
     }
+
+    /// @brief Apply the user's function on a valuation, through the cache of functions if any.
+    static
+    values_type
+    apply(const function_ptr_type& fun, const values_type& val, context<C>& cxt)
+    {
+      if (cxt.has_function_cache())
+      {
+        return cxt.function_cache()( function_application<C>{fun.get(), val}
+                                   , [&]{return cached_function<C>{fun, val};});
+      }
+      return (*fun)(val);
+    }
   };
 
   /// @brief Skip variable predicate.
@@ -304,7 +382,41 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
   const
   {
-    return visit(evaluation(), x, *fun_ptr, cxt, o);
+    return visit(evaluation(), x, fun_ptr, cxt, o);
+  }
+
+  /// @brief Split a flat node in the paths kept and removed by a selector function.
+  ///
+  /// The values removed from an arc are the difference between its valuation and the result of
+  /// the function, thus there is no difference of SDD.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    assert(fun_ptr->selector());
+    const auto& node = mem::variant_cast<flat_node<C>>(*x);
+    dd::alpha_builder<C, values_type> accepted(cxt.sdd_context());
+    dd::alpha_builder<C, values_type> rejected(cxt.sdd_context());
+    accepted.reserve(node.size());
+    rejected.reserve(node.size());
+    for (const auto& arc : node)
+    {
+      values_type val = evaluation::apply(fun_ptr, arc.valuation(), cxt);
+      if (val.empty())
+      {
+        rejected.add(arc.valuation(), arc.successor());
+      }
+      else if (val == arc.valuation())
+      {
+        accepted.add(std::move(val), arc.successor());
+      }
+      else
+      {
+        rejected.add(difference(arc.valuation(), val), arc.successor());
+        accepted.add(std::move(val), arc.successor());
+      }
+    }
+    return {SDD<C>(o.variable(), std::move(accepted)), SDD<C>(o.variable(), std::move(rejected))};
   }
 
   friend
@@ -372,4 +484,38 @@ struct hash<sdd::hom::_function<C>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Hash specialization for sdd::hom::cached_function.
+template <typename C>
+struct hash<sdd::hom::cached_function<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::cached_function<C>& x)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(x.fun.get()) (val(x.val));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Hash specialization for sdd::hom::function_application.
+///
+/// It must be the same as the hash of the described sdd::hom::cached_function.
+template <typename C>
+struct hash<sdd::hom::function_application<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::function_application<C>& x)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(x.fun) (val(x.val));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace std
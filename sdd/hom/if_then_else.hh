@@ -13,6 +13,7 @@
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/order/order.hh"
 
 namespace sdd { namespace hom {
@@ -39,20 +40,32 @@ struct _if_then_else
   const
   {
     // Apply predicate.
-    const auto tmp = h_if(cxt, o, s);
+    const auto parts = hom::split(cxt, h_if, o, s);
 
     dd::sum_builder<C, SDD<C>> sum_operands(cxt.sdd_context());
     sum_operands.reserve(2);
 
     // Apply "then" on the part accepted by the predicate.
-    sum_operands.add(h_then(cxt, o, tmp));
+    sum_operands.add(h_then(cxt, o, parts.accepted));
 
     // Apply "else" on the part rejected by the predicate.
-    sum_operands.add(h_else(cxt, o, dd::difference(cxt.sdd_context(), s, std::move(tmp))));
+    sum_operands.add(h_else(cxt, o, parts.rejected));
 
     return dd::sum(cxt.sdd_context(), std::move(sum_operands));
   }
 
+  /// @brief Split, when both branches are selectors.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& s)
+  const
+  {
+    const auto parts = hom::split(cxt, h_if, o, s);
+    auto then_parts = hom::split(cxt, h_then, o, parts.accepted);
+    auto else_parts = hom::split(cxt, h_else, o, parts.rejected);
+    return { dd::sum(cxt.sdd_context(), then_parts.accepted, else_parts.accepted)
+           , dd::sum(cxt.sdd_context(), then_parts.rejected, else_parts.rejected)};
+  }
+
   /// @brief Skip predicate.
   bool
   skip(const order<C>& o)
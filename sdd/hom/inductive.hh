@@ -8,13 +8,16 @@
 
 #include <cassert>
 #include <iosfwd>
-#include <memory>   // unique_ptr
-#include <typeinfo> // typeid
+#include <memory>      // unique_ptr
+#include <type_traits> // false_type, true_type
+#include <typeinfo>    // typeid
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/mem/variant.hh"
 #include "sdd/util/packed.hh"
+#include "sdd/util/typelist.hh"
 #include "sdd/order/order.hh"
 
 namespace sdd { namespace hom {
@@ -78,10 +81,11 @@ struct inductive_base
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief Used to wrap user's inductive homomorphisms.
+/// @brief Call a user's inductive homomorphism, whether it defines the optional members or not.
+///
+/// No virtual function is involved, it's shared by static and dynamic inductive homomorphisms.
 template <typename C, typename User>
-struct inductive_derived
-  : public inductive_base<C>
+struct inductive_user
 {
   /// @brief The user's inductive homomorphism.
   const User h;
@@ -89,15 +93,10 @@ struct inductive_derived
   /// @brief The type of a set of values.
   using values_type = typename C::Values;
 
-  /// @brief Constructor.
-  inductive_derived(User u)
-    : h{std::move(u)}
-  {}
-
   /// @brief Tell if the user's inductive skip the current variable.
   bool
   skip(const order<C>& o)
-  const noexcept override
+  const noexcept
   {
     return skip_impl(h, o, 0);
   }
@@ -105,7 +104,7 @@ struct inductive_derived
   /// @brief Tell if the user's inductive is a selector.
   bool
   selector()
-  const noexcept override
+  const noexcept
   {
     return selector_impl(h, 0);
   }
@@ -113,7 +112,7 @@ struct inductive_derived
   /// @brief Get the next homomorphism to apply from the user.
   homomorphism<C>
   operator()(const order<C>& o, const SDD<C>& x)
-  const override
+  const
   {
     return h(o, x);
   }
@@ -121,7 +120,7 @@ struct inductive_derived
   /// @brief Get the next homomorphism to apply from the user.
   homomorphism<C>
   operator()(const order<C>& o, const values_type& val)
-  const override
+  const
   {
     return h(o, val);
   }
@@ -129,24 +128,15 @@ struct inductive_derived
   /// @brief Get the base case from the user.
   SDD<C>
   operator()(const one_terminal<C>&)
-  const override
+  const
   {
     return h();
   }
 
-  /// @brief Compare inductive_derived.
-  bool
-  operator==(const inductive_base<C>& other)
-  const noexcept override
-  {
-    return typeid(*this) == typeid(other)
-           and h == static_cast<const inductive_derived&>(other).h;
-  }
-
   /// @brief Get the user's inductive hash value.
   std::size_t
   hash()
-  const noexcept(noexcept(std::hash<User>()(h))) override
+  const noexcept(noexcept(std::hash<User>()(h)))
   {
     return std::hash<User>()(h);
   }
@@ -154,11 +144,19 @@ struct inductive_derived
   /// @brief Get the user's inductive textual representation.
   void
   print(std::ostream& os)
-  const override
+  const
   {
     print_impl(os, h, 0);
   }
 
+  friend
+  bool
+  operator==(const inductive_user& lhs, const inductive_user& rhs)
+  noexcept
+  {
+    return lhs.h == rhs.h;
+  }
+
 private:
 
   /// @brief Called when the user's inductive is printable.
@@ -238,57 +236,150 @@ private:
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief inductive homomorphism.
+/// @brief Used to wrap user's inductive homomorphisms.
+template <typename C, typename User>
+struct inductive_derived final
+  : public inductive_base<C>
+{
+  /// @brief The user's inductive homomorphism.
+  const inductive_user<C, User> user;
+
+  /// @brief The type of a set of values.
+  using values_type = typename C::Values;
+
+  /// @brief Constructor.
+  inductive_derived(User u)
+    : user{std::move(u)}
+  {}
+
+  /// @brief Tell if the user's inductive skip the current variable.
+  bool
+  skip(const order<C>& o)
+  const noexcept override
+  {
+    return user.skip(o);
+  }
+
+  /// @brief Tell if the user's inductive is a selector.
+  bool
+  selector()
+  const noexcept override
+  {
+    return user.selector();
+  }
+
+  /// @brief Get the next homomorphism to apply from the user.
+  homomorphism<C>
+  operator()(const order<C>& o, const SDD<C>& x)
+  const override
+  {
+    return user(o, x);
+  }
+
+  /// @brief Get the next homomorphism to apply from the user.
+  homomorphism<C>
+  operator()(const order<C>& o, const values_type& val)
+  const override
+  {
+    return user(o, val);
+  }
+
+  /// @brief Get the base case from the user.
+  SDD<C>
+  operator()(const one_terminal<C>& one)
+  const override
+  {
+    return user(one);
+  }
+
+  /// @brief Compare inductive_derived.
+  bool
+  operator==(const inductive_base<C>& other)
+  const noexcept override
+  {
+    return typeid(*this) == typeid(other)
+           and user == static_cast<const inductive_derived&>(other).user;
+  }
+
+  /// @brief Get the user's inductive hash value.
+  std::size_t
+  hash()
+  const noexcept(noexcept(user.hash())) override
+  {
+    return user.hash();
+  }
+
+  /// @brief Get the user's inductive textual representation.
+  void
+  print(std::ostream& os)
+  const override
+  {
+    user.print(os);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Dispatch the inductive homomorphism evaluation.
+///
+/// Inductive is either an inductive_base, or an inductive_user for static inductives.
 template <typename C>
-struct _inductive
+struct inductive_evaluation
 {
-  /// @brief Ownership of the user's inductive homomorphism.
-  const std::unique_ptr<const inductive_base<C>> hom_ptr;
+  context<C>& cxt_;
+  const order<C>& order_;
+  const SDD<C> sdd_;
 
-  /// @brief Dispatch the inductive homomorphism evaluation.
-  struct evaluation
+  template <typename Inductive>
+  SDD<C>
+  operator()(const zero_terminal<C>&, const Inductive&)
+  const noexcept
   {
-    context<C>& cxt_;
-    const order<C>& order_;
-    const SDD<C> sdd_;
+    assert(false);
+    __builtin_unreachable();
+  }
 
-    SDD<C>
-    operator()(const zero_terminal<C>&, const inductive_base<C>&)
-    const noexcept
-    {
-      assert(false);
-      __builtin_unreachable();
-    }
+  template <typename Inductive>
+  SDD<C>
+  operator()(const one_terminal<C>& one, const Inductive& i)
+  const
+  {
+    return i(one);
+  }
 
-    SDD<C>
-    operator()(const one_terminal<C>& one, const inductive_base<C>& i)
-    const
+  template <typename Node, typename Inductive>
+  SDD<C>
+  operator()(const Node& node, const Inductive& inductive)
+  const
+  {
+    dd::sum_builder<C, SDD<C>> sum_operands(cxt_.sdd_context());
+    sum_operands.reserve(node.size());
+    for (const auto& arc : node)
     {
-      return i(one);
+      const homomorphism<C> next_hom = inductive(order_, arc.valuation());
+      sum_operands.add(next_hom(cxt_, order_.next(), arc.successor()));
     }
+    return dd::sum(cxt_.sdd_context(), std::move(sum_operands));
+  }
+};
 
-    template <typename Node>
-    SDD<C>
-    operator()(const Node& node, const inductive_base<C>& inductive)
-    const
-    {
-      dd::sum_builder<C, SDD<C>> sum_operands(cxt_.sdd_context());
-      sum_operands.reserve(node.size());
-      for (const auto& arc : node)
-      {
-        const homomorphism<C> next_hom = inductive(order_, arc.valuation());
-        sum_operands.add(next_hom(cxt_, order_.next(), arc.successor()));
-      }
-      return dd::sum(cxt_.sdd_context(), std::move(sum_operands));
-    }
-  };
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief inductive homomorphism.
+template <typename C>
+struct _inductive
+{
+  /// @brief Ownership of the user's inductive homomorphism.
+  const std::unique_ptr<const inductive_base<C>> hom_ptr;
 
   /// @brief Evaluation.
   SDD<C>
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
   const
   {
-    return visit(evaluation{cxt, o, s}, s, *hom_ptr);
+    return visit(inductive_evaluation<C>{cxt, o, s}, s, *hom_ptr);
   }
 
   /// @brief Skip predicate.
@@ -326,17 +417,108 @@ struct _inductive
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief inductive homomorphism of a type listed in the configuration's static_inductives.
+///
+/// Each such type is an alternative of homomorphisms: the user's object is stored inline, and
+/// calls to its members are resolved at compile-time.
+template <typename C, typename User>
+struct _static_inductive
+{
+  /// @brief The user's inductive homomorphism.
+  const inductive_user<C, User> user;
+
+  /// @brief Evaluation.
+  SDD<C>
+  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
+  const
+  {
+    return visit(inductive_evaluation<C>{cxt, o, s}, s, user);
+  }
+
+  /// @brief Skip predicate.
+  bool
+  skip(const order<C>& o)
+  const noexcept
+  {
+    return user.skip(o);
+  }
+
+  /// @brief Selector predicate
+  bool
+  selector()
+  const noexcept
+  {
+    return user.selector();
+  }
+
+  friend
+  bool
+  operator==(const _static_inductive& lhs, const _static_inductive& rhs)
+  noexcept
+  {
+    return lhs.user == rhs.user;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const _static_inductive& i)
+  {
+    i.user.print(os);
+    return os;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Get the variant of homomorphisms from the built-in operations and the static inductives.
+template <typename C, typename Users, typename... Types>
+struct static_inductives_variant;
+
+/// @internal
+template <typename C, typename... Users, typename... Types>
+struct static_inductives_variant<C, util::list<Users...>, Types...>
+{
+  using type = mem::variant<Types..., _static_inductive<C, Users>...>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Create a dynamic inductive homomorphism.
+template <typename C, typename User>
+homomorphism<C>
+make_inductive(const User& u, std::false_type)
+{
+  return make<C, _inductive<C>>(std::make_unique<inductive_derived<C, User>>(u));
+}
+
+/// @internal
+/// @brief Create a static inductive homomorphism.
+template <typename C, typename User>
+homomorphism<C>
+make_inductive(const User& u, std::true_type)
+{
+  return make<C, _static_inductive<C, User>>(inductive_user<C, User>{u});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace hom
 
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief Create the inductive homomorphism.
 /// @related homomorphism
+///
+/// When User is listed in C::static_inductives, it's stored inline and called without virtual
+/// functions.
 template <typename C, typename User>
 homomorphism<C>
 inductive(const User& u)
 {
-  return hom::make<C, hom::_inductive<C>>(std::make_unique<hom::inductive_derived<C, User>>(u));
+  return hom::make_inductive<C>(u, util::contains<User, typename C::static_inductives>{});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -362,4 +544,19 @@ struct hash<sdd::hom::_inductive<C>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Hash specialization for sdd::hom::_static_inductive.
+template <typename C, typename User>
+struct hash<sdd::hom::_static_inductive<C, User>>
+{
+  std::size_t
+  operator()(const sdd::hom::_static_inductive<C, User>& i)
+  const
+  {
+    return i.user.hash();
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace std
@@ -0,0 +1,341 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>    // uint64_t
+#include <exception>
+#include <functional>
+#include <memory>     // make_shared, shared_ptr
+
+#include "sdd/internal_manager_fwd.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/tools/nodes.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @exception interrupted
+/// @brief Thrown when the evaluation of an homomorphism is cancelled or reaches its deadline.
+///
+/// Caches only store completed operations and temporary memory is released while unwinding, thus
+/// the library can be used again after this exception has been caught.
+class interrupted final
+  : public std::exception
+{
+public:
+
+  /// @brief Why an evaluation was interrupted.
+  enum class cause {cancelled, deadline};
+
+private:
+
+  /// @brief Why the evaluation was interrupted.
+  const cause cause_;
+
+public:
+
+  /// @internal
+  interrupted(cause c)
+    : cause_(c)
+  {}
+
+  /// @brief Tell why the evaluation was interrupted.
+  cause
+  why()
+  const noexcept
+  {
+    return cause_;
+  }
+
+  /// @brief Return the textual description of the error.
+  const char*
+  what()
+  const noexcept override
+  {
+    return cause_ == cause::cancelled ? "Evaluation cancelled." : "Evaluation deadline reached.";
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Ask evaluations to stop, possibly from another thread.
+///
+/// Copies share the same state.
+class cancellation_token
+{
+private:
+
+  /// @brief Tell if cancellation was requested.
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+
+public:
+
+  /// @brief Constructor.
+  cancellation_token()
+    : cancelled_(std::make_shared<std::atomic<bool>>(false))
+  {}
+
+  /// @brief Request cancellation.
+  void
+  cancel()
+  noexcept
+  {
+    cancelled_->store(true, std::memory_order_relaxed);
+  }
+
+  /// @brief Withdraw the cancellation request.
+  void
+  reset()
+  noexcept
+  {
+    cancelled_->store(false, std::memory_order_relaxed);
+  }
+
+  /// @brief Tell if cancellation was requested.
+  bool
+  cancelled()
+  const noexcept
+  {
+    return cancelled_->load(std::memory_order_relaxed);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Reported to progress callbacks.
+template <typename C>
+struct progress
+{
+  /// @brief The number of fixpoint iterations since the interruption was reset.
+  std::uint64_t iterations;
+
+  /// @brief The number of homomorphisms evaluations (cache misses) since the last reset.
+  std::uint64_t evaluations;
+
+  /// @brief The states of the current fixpoint iteration.
+  SDD<C> current;
+
+  /// @brief The number of SDD nodes alive in the library, current being one of many.
+  ///
+  /// O(1).
+  std::size_t live_nodes;
+
+  /// @brief The time elapsed since the last reset.
+  std::chrono::nanoseconds elapsed;
+
+  /// @brief Get the number of nodes of current.
+  ///
+  /// O(n) where n is the number of nodes of current, thus it's only computed when asked.
+  std::size_t
+  nodes()
+  const
+  {
+    const auto res = tools::nodes(current);
+    return res.first + res.second;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Control when evaluations of homomorphisms should stop, and report their progress.
+///
+/// Checks happen at each fixpoint iteration and at each cache miss of homomorphisms. They throw
+/// interrupted to stop the evaluation.
+template <typename C>
+class interruption
+{
+  // Can't copy an interruption.
+  interruption(const interruption&) = delete;
+  interruption& operator=(const interruption&) = delete;
+
+public:
+
+  /// @brief The clock used for deadlines and progress.
+  using clock = std::chrono::steady_clock;
+
+  /// @brief The type of a progress callback.
+  using callback_type = std::function<void (const progress<C>&)>;
+
+private:
+
+  /// @brief The deadline is checked every deadline_period evaluations, it must be a power of 2.
+  static constexpr std::uint64_t deadline_period = 256;
+
+  /// @brief Tell if a token or a deadline is set.
+  bool armed_;
+
+  /// @brief Stop evaluations when it's cancelled, if set.
+  std::shared_ptr<cancellation_token> token_;
+
+  /// @brief Stop the current asynchronous evaluation when it's cancelled, if set.
+  std::shared_ptr<cancellation_token> task_token_;
+
+  /// @brief Tell if a deadline is set.
+  bool has_deadline_;
+
+  /// @brief Stop evaluations once this date is passed, if has_deadline_.
+  clock::time_point deadline_;
+
+  /// @brief Called at fixpoint iterations, at most once per period_.
+  callback_type callback_;
+
+  /// @brief The minimal time between two calls to the progress callback.
+  clock::duration period_;
+
+  /// @brief The date of the next call to the progress callback.
+  clock::time_point next_report_;
+
+  /// @brief The date of the last reset.
+  clock::time_point start_;
+
+  /// @brief The number of fixpoint iterations since the last reset.
+  std::uint64_t iterations_;
+
+  /// @brief The number of evaluations since the last reset.
+  std::uint64_t evaluations_;
+
+public:
+
+  /// @brief Default constructor.
+  interruption()
+  {
+    reset();
+  }
+
+  /// @brief Stop evaluations when a token is cancelled.
+  void
+  cancel_with(const cancellation_token& token)
+  {
+    token_ = std::make_shared<cancellation_token>(token);
+    armed_ = true;
+  }
+
+  /// @internal
+  /// @brief Set the token of the current asynchronous evaluation, nullptr when it's finished.
+  ///
+  /// It's independent of the token set by cancel_with().
+  void
+  task_token(std::shared_ptr<cancellation_token> token)
+  noexcept
+  {
+    task_token_ = std::move(token);
+    armed_ = token_ or task_token_ or has_deadline_;
+  }
+
+  /// @brief Stop evaluations after a given date.
+  void
+  deadline(clock::time_point date)
+  noexcept
+  {
+    has_deadline_ = true;
+    deadline_ = date;
+    armed_ = true;
+  }
+
+  /// @brief Stop evaluations after a given duration from now.
+  void
+  timeout(clock::duration duration)
+  noexcept
+  {
+    deadline(clock::now() + duration);
+  }
+
+  /// @brief Report progress at fixpoint iterations.
+  /// @param callback Called with the progress of the evaluation.
+  /// @param period The minimal time between two calls.
+  ///
+  /// The callback can throw to stop the evaluation.
+  void
+  on_progress(callback_type callback, clock::duration period = std::chrono::seconds(1))
+  {
+    callback_ = std::move(callback);
+    period_ = period;
+    next_report_ = clock::now();
+  }
+
+  /// @brief Remove the token, the deadline and the progress callback, and reset counters.
+  void
+  reset()
+  noexcept
+  {
+    token_.reset();
+    has_deadline_ = false;
+    armed_ = task_token_ != nullptr;
+    callback_ = nullptr;
+    period_ = clock::duration::zero();
+    start_ = clock::now();
+    next_report_ = start_;
+    iterations_ = 0;
+    evaluations_ = 0;
+  }
+
+  /// @internal
+  /// @brief Called before an homomorphism is evaluated.
+  void
+  evaluation()
+  {
+    ++evaluations_;
+    if (armed_)
+    {
+      check((evaluations_ & (deadline_period - 1)) == 0);
+    }
+  }
+
+  /// @internal
+  /// @brief Called at each iteration of a fixpoint.
+  void
+  iteration(const SDD<C>& current)
+  {
+    ++iterations_;
+    if (armed_)
+    {
+      check(true);
+    }
+    if (callback_)
+    {
+      const auto now = clock::now();
+      if (now >= next_report_)
+      {
+        next_report_ = now + period_;
+        callback_({ iterations_, evaluations_, current, global<C>().sdd_unique_table.size()
+                  , std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_)});
+      }
+    }
+  }
+
+private:
+
+  /// @brief Throw if the token is cancelled or, if asked, if the deadline has passed.
+  void
+  check(bool deadline)
+  const
+  {
+    if ((token_ and token_->cancelled()) or (task_token_ and task_token_->cancelled()))
+    {
+      throw interrupted(interrupted::cause::cancelled);
+    }
+    if (deadline and has_deadline_ and clock::now() >= deadline_)
+    {
+      throw interrupted(interrupted::cause::deadline);
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace hom
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
@@ -12,6 +12,7 @@
 #include <iosfwd>
 #include <stdexcept>  //invalid_argument
 #include <unordered_map>
+#include <utility>    // move
 
 #include <boost/container/flat_set.hpp>
 
@@ -20,6 +21,7 @@
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -41,11 +43,38 @@ struct _intersection
   /// @brief The homomorphism operands' set.
   const operands_type operands;
 
+  /// @brief Tell if all operands are selectors.
+  ///
+  /// Operands are already unified when this intersection is created, thus it's decided once.
+  const bool all_selectors;
+
+  /// @brief Constructor.
+  _intersection(operands_type&& ops)
+    : operands(std::move(ops))
+    , all_selectors(std::all_of( operands.begin(), operands.end()
+                               , [](const homomorphism<C>& h){return h.selector();}))
+  {}
+
   /// @brief Evaluation.
   SDD<C>
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
   const
   {
+    if (all_selectors)
+    {
+      // Selectors are filters: each operand only filters the paths kept by the previous ones,
+      // which doesn't need any intersection of SDD.
+      auto res = x;
+      for (const auto& op : operands)
+      {
+        res = op(cxt, o, res);
+        if (res.empty())
+        {
+          break;
+        }
+      }
+      return res;
+    }
     dd::intersection_builder<C, SDD<C>> intersection_operands(cxt.sdd_context());
     intersection_operands.reserve(operands.size());
     for (const auto& op : operands)
@@ -60,6 +89,29 @@ struct _intersection
     return dd::intersection(cxt.sdd_context(), std::move(intersection_operands));
   }
 
+  /// @brief Split, when all operands are selectors.
+  ///
+  /// Each operand only splits the part accepted by the previous ones.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    dd::sum_builder<C, SDD<C>> rejected(cxt.sdd_context());
+    rejected.reserve(operands.size());
+    auto accepted = x;
+    for (const auto& op : operands)
+    {
+      auto parts = hom::split(cxt, op, o, accepted);
+      rejected.add(std::move(parts.rejected));
+      accepted = std::move(parts.accepted);
+      if (accepted.empty())
+      {
+        break;
+      }
+    }
+    return {std::move(accepted), dd::sum(cxt.sdd_context(), std::move(rejected))};
+  }
+
   /// @brief Skip variable predicate.
   bool
   skip(const order<C>& o)
@@ -74,8 +126,7 @@ struct _intersection
   selector()
   const noexcept
   {
-    return std::all_of( operands.begin(), operands.end()
-                      , [](const homomorphism<C>& h){return h.selector();});
+    return all_selectors;
   }
 
   /// @brief Get an iterator to the first operand.
@@ -12,6 +12,7 @@
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -89,6 +90,34 @@ struct LIBSDD_ATTRIBUTE_PACKED _local
     return visit(evaluation{cxt, o, h}, s);
   }
 
+  /// @brief Split, when the nested homomorphism is a selector.
+  ///
+  /// The partition of the node doesn't change, its valuations are split.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& s)
+  const
+  {
+    const auto& node = mem::variant_cast<hierarchical_node<C>>(*s);
+    mem::rewinder _(cxt.sdd_context().arena());
+    dd::square_union<C, SDD<C>> accepted(cxt.sdd_context());
+    dd::square_union<C, SDD<C>> rejected(cxt.sdd_context());
+    accepted.reserve(node.size());
+    rejected.reserve(node.size());
+    for (const auto& arc : node)
+    {
+      auto parts = hom::split(cxt, h, o.nested(), arc.valuation());
+      if (not parts.accepted.empty())
+      {
+        accepted.add(arc.successor(), std::move(parts.accepted));
+      }
+      if (not parts.rejected.empty())
+      {
+        rejected.add(arc.successor(), std::move(parts.rejected));
+      }
+    }
+    return {SDD<C>(node.variable(), accepted()), SDD<C>(node.variable(), rejected())};
+  }
+
   /// @brief Skip predicate.
   bool
   skip(const order<C>& o)
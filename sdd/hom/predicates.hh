@@ -0,0 +1,195 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // upper_bound
+#include <iterator>  // prev
+#include <new>       // bad_alloc
+#include <vector>
+
+#include "sdd/hom/definition.hh"
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Store the skip and selector predicates of all unified homomorphisms.
+///
+/// It's an observer of the homomorphisms unique table. The selector predicate is computed once,
+/// when an homomorphism is unified. The skip predicate depends on the order: it's computed at the
+/// first request for a position of an order, then kept in a set of intervals of positions. As an
+/// homomorphism skips all positions but the few ones of its variables, there are few intervals,
+/// whatever the size of the order. Thus, the predicates of composite homomorphisms (sums,
+/// compositions, etc.) no longer traverse their operands at each evaluation.
+template <typename C>
+class predicates
+{
+private:
+
+  /// @brief The type of a unified homomorphism.
+  using unique_type = typename homomorphism<C>::unique_type;
+
+  /// @brief Consecutive positions with the same skip predicate.
+  struct interval
+  {
+    /// @brief The first position.
+    std::size_t first;
+
+    /// @brief The position after the last one.
+    std::size_t last;
+
+    /// @brief Tell if the positions are skipped.
+    bool skipped;
+  };
+
+  /// @brief The predicates of an homomorphism.
+  struct entry
+  {
+    /// @brief Tell if the homomorphism is a selector.
+    bool selector;
+
+    /// @brief The serial of the order of intervals, 0 if none.
+    std::size_t order_serial;
+
+    /// @brief The known positions, sorted and disjoint.
+    std::vector<interval> intervals;
+  };
+
+  /// @brief Predicates indexed by the dense identifiers of homomorphisms.
+  std::vector<entry> entries_;
+
+public:
+
+  /// @brief Default constructor.
+  predicates()
+    : entries_()
+  {}
+
+  /// @brief Called when an homomorphism is inserted in the unique table.
+  void
+  on_insert(const unique_type& u)
+  {
+    if (u.id() >= entries_.size())
+    {
+      entries_.resize(u.id() + 1);
+    }
+    // Operands of u are already unified, thus their own selector predicate is known.
+    auto& e = entries_[u.id()];
+    e.selector = apply_visitor([](const auto& h){return h.selector();}, u.data());
+    e.order_serial = 0;
+    e.intervals.clear();
+  }
+
+  /// @brief Called when an existing homomorphism is requested again.
+  void
+  on_hit(const unique_type&)
+  const noexcept
+  {}
+
+  /// @brief Called when an homomorphism is erased from the unique table.
+  void
+  on_erase(const unique_type& u)
+  {
+    // Release the memory of the intervals, the identifier may not be reused soon.
+    entries_[u.id()].intervals = std::vector<interval>();
+  }
+
+  /// @brief Tell if an homomorphism is a selector.
+  ///
+  /// O(1).
+  bool
+  selector(const unique_type& u)
+  const noexcept
+  {
+    return entries_[u.id()].selector;
+  }
+
+  /// @brief Tell if an homomorphism skips the head of an order.
+  ///
+  /// O(log n) once computed for this position, where n is the number of intervals.
+  bool
+  skip(const unique_type& u, const order<C>& o)
+  noexcept
+  {
+    const auto position = o.position();
+    {
+      auto& e = entries_[u.id()];
+      if (e.order_serial != o.serial())
+      {
+        // First request for this order. An homomorphism is seldom applied on different orders.
+        e.order_serial = o.serial();
+        e.intervals.clear();
+      }
+      const auto search = lookup(e, position);
+      if (search != e.intervals.begin() and position < std::prev(search)->last)
+      {
+        return std::prev(search)->skipped;
+      }
+    }
+    // May request the skip predicate of operands, thus entries_ must not be referenced meanwhile.
+    const bool res = apply_visitor([&](const auto& h){return h.skip(o);}, u.data());
+    try
+    {
+      remember(entries_[u.id()], position, res);
+    }
+    catch (const std::bad_alloc&)
+    {
+      // Not remembered, it will be computed again.
+    }
+    return res;
+  }
+
+private:
+
+  /// @brief Get the first interval which starts after a position.
+  static
+  typename std::vector<interval>::iterator
+  lookup(entry& e, std::size_t position)
+  noexcept
+  {
+    return std::upper_bound( e.intervals.begin(), e.intervals.end(), position
+                           , [](std::size_t p, const interval& i){return p < i.first;});
+  }
+
+  /// @brief Remember the skip predicate of an unknown position.
+  ///
+  /// Positions are mostly requested from the top to the bottom of the order, thus the last
+  /// interval is usually extended.
+  static
+  void
+  remember(entry& e, std::size_t position, bool skipped)
+  {
+    auto next = lookup(e, position);
+    const bool extend_prev = next != e.intervals.begin() and std::prev(next)->last == position
+                         and std::prev(next)->skipped == skipped;
+    const bool extend_next = next != e.intervals.end() and next->first == position + 1
+                         and next->skipped == skipped;
+    if (extend_prev and extend_next)
+    {
+      std::prev(next)->last = next->last;
+      e.intervals.erase(next);
+    }
+    else if (extend_prev)
+    {
+      std::prev(next)->last = position + 1;
+    }
+    else if (extend_next)
+    {
+      next->first = position;
+    }
+    else
+    {
+      e.intervals.insert(next, interval{position, position + 1, skipped});
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
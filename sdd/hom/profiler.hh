@@ -0,0 +1,263 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cstdint> // uint64_t
+#include <unordered_map>
+#include <vector>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/definition_fwd.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief What the profiler recorded for an homomorphism.
+struct hom_profile
+{
+  /// @brief The number of times the homomorphism was applied.
+  std::uint64_t calls = 0;
+
+  /// @brief The number of applications found in the cache.
+  std::uint64_t hits = 0;
+
+  /// @brief The number of applications actually evaluated (including those not cached).
+  std::uint64_t misses = 0;
+
+  /// @brief The time spent in applications of this homomorphism, including nested ones.
+  ///
+  /// Recursive applications of the same homomorphism are counted once.
+  std::chrono::nanoseconds inclusive = std::chrono::nanoseconds::zero();
+
+  /// @brief The time spent in applications of this homomorphism, excluding nested ones.
+  std::chrono::nanoseconds exclusive = std::chrono::nanoseconds::zero();
+
+  /// @brief The total number of arcs of the root nodes of operands.
+  ///
+  /// Only the root node is considered, as counting all nodes would cost more than the evaluation.
+  std::uint64_t input_arcs = 0;
+
+  /// @brief The total number of arcs of the root nodes of results.
+  std::uint64_t output_arcs = 0;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Record the applications of homomorphisms.
+///
+/// Only the applications going through homomorphism::operator() are recorded, which is the case of
+/// all applications when the library is compiled with LIBSDD_PROFILE. Otherwise, it's never fed.
+template <typename C>
+class profiler
+{
+  // Can't copy a profiler.
+  profiler(const profiler&) = delete;
+  profiler& operator=(const profiler&) = delete;
+
+public:
+
+  /// @brief The clock used to measure durations.
+  using clock = std::chrono::steady_clock;
+
+  /// @brief Profiles indexed by homomorphisms.
+  using map_type = std::unordered_map<homomorphism<C>, hom_profile>;
+
+private:
+
+  /// @brief An application in progress.
+  struct frame
+  {
+    /// @brief The profile of the applied homomorphism.
+    ///
+    /// Not an iterator, as nested applications may rehash profiles_, which invalidates iterators
+    /// but not references to elements.
+    hom_profile* profile;
+
+    /// @brief When the application started.
+    clock::time_point start;
+
+    /// @brief The time spent in nested applications.
+    clock::duration nested;
+
+    /// @brief Tell if the application was evaluated rather than found in the cache.
+    bool evaluated;
+  };
+
+  /// @brief All recorded profiles.
+  map_type profiles_;
+
+  /// @brief Applications in progress, the last one being the current one.
+  std::vector<frame> stack_;
+
+  /// @brief The number of applications in progress for each homomorphism.
+  std::unordered_map<const hom_profile*, unsigned int> active_;
+
+public:
+
+  /// @brief Record an application for the time of its scope.
+  class scope
+  {
+    // Can't copy a scope.
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+    /// @brief The profiler that records this application.
+    profiler& p_;
+
+  public:
+
+    /// @brief Start an application of h on x.
+    scope(profiler& p, const homomorphism<C>& h, const SDD<C>& x)
+      : p_(p)
+    {
+      p_.enter(h, x);
+    }
+
+    /// @brief Stop the application.
+    ///
+    /// The application is recorded even when it was interrupted by an exception.
+    ~scope()
+    {
+      p_.leave();
+    }
+
+    /// @brief Record the result of the application.
+    SDD<C>
+    operator()(SDD<C>&& res)
+    noexcept
+    {
+      p_.stack_.back().profile->output_arcs += arcs(res);
+      return std::move(res);
+    }
+  };
+
+  /// @brief Default constructor.
+  profiler() = default;
+
+  /// @brief Tell that the current application is evaluated rather than found in the cache.
+  void
+  evaluated()
+  noexcept
+  {
+    if (not stack_.empty())
+    {
+      stack_.back().evaluated = true;
+    }
+  }
+
+  /// @brief Get the profile of an homomorphism, nullptr if it was never applied.
+  const hom_profile*
+  operator[](const homomorphism<C>& h)
+  const
+  {
+    const auto search = profiles_.find(h);
+    return search == profiles_.end() ? nullptr : &search->second;
+  }
+
+  /// @brief Get all recorded profiles.
+  const map_type&
+  profiles()
+  const noexcept
+  {
+    return profiles_;
+  }
+
+  /// @brief Forget all recorded profiles.
+  ///
+  /// It must not be called while an application is in progress.
+  void
+  clear()
+  noexcept
+  {
+    assert(stack_.empty());
+    profiles_.clear();
+    active_.clear();
+  }
+
+private:
+
+  /// @brief Get the number of arcs of the root node of an SDD.
+  static
+  std::uint64_t
+  arcs(const SDD<C>& x)
+  noexcept
+  {
+    return visit([](const auto& n) -> std::uint64_t {return size(n);}, x);
+  }
+
+  /// @brief A terminal has no arcs.
+  template <typename T>
+  static
+  std::size_t
+  size(const T&)
+  noexcept
+  {
+    return 0;
+  }
+
+  /// @brief Get the number of arcs of a flat node.
+  static
+  std::size_t
+  size(const flat_node<C>& n)
+  noexcept
+  {
+    return n.size();
+  }
+
+  /// @brief Get the number of arcs of a hierarchical node.
+  static
+  std::size_t
+  size(const hierarchical_node<C>& n)
+  noexcept
+  {
+    return n.size();
+  }
+
+  void
+  enter(const homomorphism<C>& h, const SDD<C>& x)
+  {
+    auto& profile = profiles_.emplace(h, hom_profile{}).first->second;
+    ++profile.calls;
+    profile.input_arcs += arcs(x);
+    ++active_[&profile];
+    stack_.push_back({&profile, clock::now(), clock::duration::zero(), false});
+  }
+
+  void
+  leave()
+  noexcept
+  {
+    const auto& f = stack_.back();
+    const auto duration = clock::now() - f.start;
+    auto& profile = *f.profile;
+    if (f.evaluated)
+    {
+      ++profile.misses;
+    }
+    else
+    {
+      ++profile.hits;
+    }
+    profile.exclusive += duration - f.nested;
+    if (--active_.find(&profile)->second == 0)
+    {
+      profile.inclusive += duration;
+    }
+    stack_.pop_back();
+    if (not stack_.empty())
+    {
+      stack_.back().nested += duration;
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
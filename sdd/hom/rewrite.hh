@@ -172,7 +172,7 @@ struct rewriter
     {
       // Don't forget to add id to F!.
       F.push_back(id<C>());
-      rewritten_F = rewrite(o.next(), fixpoint(sum(o.next(), F.begin(), F.end())));
+      rewritten_F = rewrite(o.next(), fixpoint(sum(o.next(), F.begin(), F.end()), f.mode));
     }
 
     auto rewritten_L = id<C>();
@@ -180,8 +180,9 @@ struct rewriter
     {
       // Don't forget to add id to L!.
       L.push_back(id<C>());
-      rewritten_L
-        = local(o.variable(), rewrite(o.nested(), fixpoint(sum(o.nested(), L.begin(), L.end()))));
+      rewritten_L = local( o.variable()
+                         , rewrite( o.nested()
+                                  , fixpoint(sum(o.nested(), L.begin(), L.end()), f.mode)));
     }
 
     // Put selectors in front. It might help cut paths sooner in the Saturation Fixpoint's
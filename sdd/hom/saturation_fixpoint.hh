@@ -7,8 +7,11 @@
 #pragma once
 
 #include <algorithm>  // all_of, copy, equal
+#include <cstdint>    // uint64_t
 #include <iosfwd>
 #include <stdexcept>  // invalid_argument
+#include <utility>    // swap
+#include <vector>
 
 #include <boost/container/flat_set.hpp>
 
@@ -17,10 +20,14 @@
 #include "sdd/hom/consolidate.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/footprint.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/saturation_state.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
+#include "sdd/util/trace.hh"
 
 namespace sdd { namespace hom {
 
@@ -77,30 +84,85 @@ public:
   }
 
   /// @brief Evaluation.
+  ///
+  /// A worklist of the operands to apply: all operands are applied once, then an operand is
+  /// applied again only if an operand which touches one of its variables produced new states.
+  /// As operands with no variable in common commute, an operand which didn't produce new states
+  /// still can't produce any after the others produced some. F and L, which are closures, are
+  /// not applied again after producing new states themselves.
+  ///
+  /// What evaluations learn about operands is kept in the context, indexed by self.
   SDD<C>
-  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
+  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s, const homomorphism<C>& self)
   const
   {
+    trace::scope span("saturation", false /* not sampled */, "variable", variable);
     auto& sdd_context = cxt.sdd_context();
+    mem::rewinder _(sdd_context.arena());
+    typename context<C>::fixpoint_scope scope(cxt);
+
+    auto& state = cxt.saturations()(self, G_size);
+    const auto& enabled = dependencies(state, o).enabled;
+
+    // The operands to apply, F and L being the two last ones.
+    using alloc = mem::linear_alloc<char>;
+    std::vector<char, alloc> pending(G_size + 2, true, alloc(sdd_context.arena()));
+    std::size_t nb_pending = G_size + 2;
+
+    auto& counters = state.counters;
+    const auto ranks = global<C>().saturation_reordering ? reorder(state) : nullptr;
 
-    SDD<C> s1 = s;
-    SDD<C> s2 = s;
+    SDD<C> current = s;
+    std::size_t changes = 0;
+    std::uint64_t rounds = 0;
+
+    // Apply an operand if it's pending, then make pending the operands it enables when it
+    // produces new states.
+    const auto apply = [&](std::size_t i, const homomorphism<C>& h, bool chain)
+    {
+      if (not pending[i])
+      {
+        return false;
+      }
+      pending[i] = false;
+      --nb_pending;
+      auto next = chain ? dd::sum(sdd_context, current, h(cxt, o, current)) : h(cxt, o, current);
+      if (next != current)
+      {
+        current = std::move(next);
+        ++changes;
+        for (const auto j : enabled[i])
+        {
+          nb_pending += not pending[j];
+          pending[j] = true;
+        }
+      }
+      return true;
+    };
 
     do
     {
-      s1 = s2;
+      ++rounds;
+      cxt.iteration(current);
 
-      s2 = F(cxt, o, s2); // apply (F + Id)*
-      s2 = L(cxt, o, s2); // apply (L + Id)*
+      apply(G_size, F, false);     // apply (F + Id)*
+      apply(G_size + 1, L, false); // apply (L + Id)*
 
-      for (const auto& g : *this)
+      for (operands_size_type k = 0; k < G_size; ++k)
       {
         // chain applications of G
-        s2 = dd::sum(sdd_context, dd::sum_builder<C, SDD<C>>(sdd_context, {s2, g(cxt, o, s2)}));
+        const auto i = ranks ? ranks[k] : k;
+        const auto before = changes;
+        if (apply(i, begin()[i], true))
+        {
+          ++counters[i].firings;
+          counters[i].productive += before != changes;
+        }
       }
-    } while (s1 != s2);
+    } while (nb_pending != 0);
 
-    return s1;
+    span.result("rounds", rounds);
+    return current;
   }
 
   /// @brief Skip predicate.
@@ -175,6 +237,68 @@ private:
     return reinterpret_cast<char*>(const_cast<_saturation_fixpoint*>(this))
          + sizeof(_saturation_fixpoint);
   }
+
+  /// @brief Get the dependencies between operands on an order.
+  ///
+  /// Computed again only when the order changes, which seldom happens.
+  const saturation_dependencies<C>&
+  dependencies(saturation_state<C>& state, const order<C>& o)
+  const
+  {
+    if (not state.dependencies or not (state.dependencies->o == o))
+    {
+      std::vector<footprint<C>> footprints;
+      footprints.reserve(G_size + 2);
+      for (const auto& g : *this)
+      {
+        footprints.push_back(get_footprint(o, g));
+      }
+      footprints.push_back(get_footprint(o, F));
+      footprints.push_back(get_footprint(o, L));
+
+      std::vector<std::vector<std::size_t>> enabled(G_size + 2);
+      for (std::size_t i = 0; i < enabled.size(); ++i)
+      {
+        for (std::size_t j = 0; j < enabled.size(); ++j)
+        {
+          // F and L are closures, they can't produce new states twice in a row.
+          if ((i != j or i < G_size) and meet(footprints[i], footprints[j]))
+          {
+            enabled[i].push_back(j);
+          }
+        }
+      }
+      state.dependencies.reset(new saturation_dependencies<C>{o, std::move(enabled)});
+    }
+    return *state.dependencies;
+  }
+
+  /// @brief Sort operands of G by decreasing productivity, from time to time.
+  ///
+  /// Changing the order changes the intermediate sets, thus the operations to cache. Sorting only
+  /// after 4, 8, 16, ... evaluations keeps most cached intermediate results useful.
+  const operands_size_type*
+  reorder(saturation_state<C>& state)
+  const noexcept
+  {
+    const auto evaluations = ++state.evaluations;
+    if (evaluations >= 4 and (evaluations & (evaluations - 1)) == 0)
+    {
+      const auto& counters = state.counters;
+      auto& ranks = state.ranks;
+      // Insertion sort: it's stable and G is small.
+      for (operands_size_type k = 1; k < G_size; ++k)
+      {
+        for ( auto j = k
+            ; j > 0 and counters[ranks[j]].productive > counters[ranks[j - 1]].productive
+            ; --j)
+        {
+          std::swap(ranks[j], ranks[j - 1]);
+        }
+      }
+    }
+    return state.ranks.data();
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
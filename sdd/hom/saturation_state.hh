@@ -0,0 +1,153 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <memory>        // unique_ptr
+#include <numeric>       // iota
+#include <unordered_map>
+#include <vector>
+
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/order/order.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Count the applications of an operand of the G part of a Saturation Fixpoint.
+struct saturation_counters
+{
+  /// @brief The number of times the operand was applied.
+  std::size_t firings;
+
+  /// @brief The number of times the operand produced new states.
+  std::size_t productive;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Tell which operands of a Saturation Fixpoint may produce new states after another one.
+template <typename C>
+struct saturation_dependencies
+{
+  /// @brief The order on which operands were analyzed.
+  const order<C> o;
+
+  /// @brief For each operand, the operands to apply again when it produces new states.
+  std::vector<std::vector<std::size_t>> enabled;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief What the evaluations of a Saturation Fixpoint learned about its operands.
+///
+/// It's not part of the identity of the homomorphism, thus it's not stored in the unified data.
+template <typename C>
+struct saturation_state
+{
+  /// @brief The type deduced from configuration of the number of operands.
+  using operands_size_type = typename C::operands_size_type;
+
+  /// @brief The number of evaluations, when operands of G are reordered.
+  std::size_t evaluations;
+
+  /// @brief The counters of the operands of G, in the same order as the operands.
+  std::vector<saturation_counters> counters;
+
+  /// @brief The order in which operands of G are applied.
+  std::vector<operands_size_type> ranks;
+
+  /// @brief The dependencies between operands, computed on the first evaluation on an order.
+  std::unique_ptr<const saturation_dependencies<C>> dependencies;
+
+  /// @brief Constructor.
+  saturation_state(std::size_t g_size)
+    : evaluations{0}, counters(g_size, saturation_counters{0, 0}), ranks(g_size), dependencies{}
+  {
+    std::iota(ranks.begin(), ranks.end(), 0);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The states of the Saturation Fixpoints evaluated in a context.
+///
+/// States are indexed by homomorphisms, like the profiles of the profiler.
+template <typename C>
+class saturation_states
+{
+  // Can't copy saturation states.
+  saturation_states(const saturation_states&) = delete;
+  saturation_states& operator=(const saturation_states&) = delete;
+
+public:
+
+  /// @brief States indexed by homomorphisms.
+  using map_type = std::unordered_map<homomorphism<C>, saturation_state<C>>;
+
+private:
+
+  /// @brief All states.
+  ///
+  /// Nested evaluations may rehash it, which invalidates iterators but not references to elements.
+  map_type states_;
+
+public:
+
+  /// @brief Default constructor.
+  saturation_states() = default;
+
+  /// @brief Get the state of a Saturation Fixpoint, created on its first evaluation.
+  saturation_state<C>&
+  operator()(const homomorphism<C>& h, std::size_t g_size)
+  {
+    auto search = states_.find(h);
+    if (search == states_.end())
+    {
+      search = states_.emplace(h, saturation_state<C>(g_size)).first;
+    }
+    return search->second;
+  }
+
+  /// @brief Get the state of a Saturation Fixpoint, nullptr if it was never evaluated.
+  const saturation_state<C>*
+  operator[](const homomorphism<C>& h)
+  const
+  {
+    const auto search = states_.find(h);
+    return search == states_.end() ? nullptr : &search->second;
+  }
+
+  /// @brief Forget the states of the Saturation Fixpoints that are no longer referenced.
+  ///
+  /// A Saturation Fixpoint being evaluated is referenced by its evaluation, thus it can be
+  /// called at any time.
+  void
+  sweep()
+  noexcept
+  {
+    for (auto cit = states_.begin(); cit != states_.end();)
+    {
+      if (cit->first.ptr()->reference_counter() == 1)
+      {
+        cit = states_.erase(cit);
+      }
+      else
+      {
+        ++cit;
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
@@ -0,0 +1,284 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <cassert>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/context_fwd.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/evaluation.hh"
+#include "sdd/hom/identity.hh"
+#include "sdd/order/order.hh"
+#include "sdd/util/deep_call.hh"
+#include "sdd/util/hash.hh"
+
+namespace sdd { namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The paths of an SDD accepted and rejected by a selector.
+template <typename C>
+struct split_result
+{
+  /// @brief The paths kept by the selector.
+  SDD<C> accepted;
+
+  /// @brief The paths removed by the selector.
+  SDD<C> rejected;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Split an SDD with the concrete type of a selector.
+///
+/// As homomorphisms are linear, a selector keeps or removes each path independently: it's a filter.
+/// Thus, both parts can be computed in a single traversal, where a concrete homomorphism knows how.
+template <typename C>
+struct split_evaluation
+{
+  /// @brief Terminal |0| case.
+  ///
+  /// It shall never be called as the |0| case is handled by split().
+  template <typename H>
+  split_result<C>
+  operator()( const H&, const zero_terminal<C>&
+            , const homomorphism<C>&, const SDD<C>&
+            , context<C>&, const order<C>&)
+  const noexcept
+  {
+    assert(false);
+    __builtin_unreachable();
+  }
+
+  /// @brief Terminal |1| case.
+  ///
+  /// The single path is either kept or removed.
+  template <typename H>
+  split_result<C>
+  operator()( const H& h, const one_terminal<C>&
+            , const homomorphism<C>& hom, const SDD<C>& x
+            , context<C>& cxt, const order<C>& o)
+  const
+  {
+    auto accepted = apply_concrete(h, hom, cxt, o, x, 0);
+    return accepted.empty() ? split_result<C>{accepted, x} : split_result<C>{accepted, zero<C>()};
+  }
+
+  /// @brief Dispatch the split to the concrete homomorphism.
+  ///
+  /// Like evaluations, splits are propagated on successors when the current level is skipped.
+  template <typename H, typename Node>
+  split_result<C>
+  operator()( const H& h, const Node& node
+            , const homomorphism<C>& hom, const SDD<C>& x
+            , context<C>& cxt, const order<C>& o)
+  const
+  {
+    assert(not o.empty() && "Empty order.");
+    assert(o.variable() == node.variable() && "Different variables in order and SDD.");
+
+    if (hom.skip(o))
+    {
+      const auto next = o.next();
+      mem::rewinder _(cxt.sdd_context().arena());
+      dd::square_union<C, typename Node::valuation_type> accepted(cxt.sdd_context());
+      dd::square_union<C, typename Node::valuation_type> rejected(cxt.sdd_context());
+      accepted.reserve(node.size());
+      rejected.reserve(node.size());
+      for (const auto& arc : node)
+      {
+        auto parts = util::deep_call([&]{return split(cxt, hom, next, arc.successor());});
+        if (not parts.accepted.empty())
+        {
+          accepted.add(std::move(parts.accepted), arc.valuation());
+        }
+        if (not parts.rejected.empty())
+        {
+          rejected.add(std::move(parts.rejected), arc.valuation());
+        }
+      }
+      return {SDD<C>(node.variable(), accepted()), SDD<C>(node.variable(), rejected())};
+    }
+    else
+    {
+      return split_impl(h, hom, cxt, o, x, 0);
+    }
+  }
+
+private:
+
+  /// @brief Called when the concrete homomorphism has split().
+  ///
+  /// Compile-time dispatch.
+  template <typename H>
+  static auto
+  split_impl( const H& h, const homomorphism<C>&, context<C>& cxt, const order<C>& o
+            , const SDD<C>& x, int)
+  -> decltype(h.split(cxt, o, x))
+  {
+    return h.split(cxt, o, x);
+  }
+
+  /// @brief Called when the concrete homomorphism doesn't have split().
+  ///
+  /// The rejected part is then the difference between the operand and the accepted part.
+  ///
+  /// Compile-time dispatch.
+  template <typename H>
+  static split_result<C>
+  split_impl( const H& h, const homomorphism<C>& hom, context<C>& cxt, const order<C>& o
+            , const SDD<C>& x, long)
+  {
+    auto accepted = apply_concrete(h, hom, cxt, o, x, 0);
+    auto rejected = dd::difference(cxt.sdd_context(), x, accepted);
+    return {std::move(accepted), std::move(rejected)};
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The split of an SDD by a selector, stored in the cache of splits.
+///
+/// Like cached_homomorphism, it's looked up and evaluated with a cached_split_key.
+template <typename C>
+struct cached_split
+{
+  /// @brief The type of the result of the split.
+  using result_type = split_result<C>;
+
+  /// @brief The current order position, which doesn't own the nodes of the order.
+  const cached_order ord;
+
+  /// @brief The selector.
+  const homomorphism<C> hom;
+
+  /// @brief The split SDD.
+  const SDD<C> sdd;
+
+  friend
+  bool
+  operator==(const cached_split& lhs, const cached_split& rhs)
+  noexcept
+  {
+    return lhs.hom == rhs.hom and lhs.sdd == rhs.sdd and lhs.ord == rhs.ord;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Describe the split of an SDD to look it up in the cache of splits.
+///
+/// It borrows the caller's operands, like cached_homomorphism_key.
+template <typename C>
+struct cached_split_key
+{
+  /// @brief The current order position.
+  const order<C>& ord;
+
+  /// @brief The selector.
+  const homomorphism<C>& hom;
+
+  /// @brief The split SDD.
+  const SDD<C>& sdd;
+
+  /// @brief Launch the split.
+  ///
+  /// Called by the cache.
+  split_result<C>
+  operator()(context<C>& cxt)
+  const
+  {
+    cxt.interruption().evaluation();
+    return binary_visit(split_evaluation<C>{}, hom, sdd, hom, sdd, cxt, ord);
+  }
+
+  /// @brief Build the operation stored in the cache.
+  cached_split<C>
+  operation()
+  const
+  {
+    return {ord, hom, sdd};
+  }
+
+  friend
+  bool
+  operator==(const cached_split_key& lhs, const cached_split<C>& rhs)
+  noexcept
+  {
+    return lhs.hom == rhs.hom and lhs.sdd == rhs.sdd and cached_order(lhs.ord) == rhs.ord;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Split an SDD in the paths accepted and rejected by a selector.
+///
+/// Same as {h(x), x - h(x)}, but homomorphisms which support it compute both parts at once.
+template <typename C>
+split_result<C>
+split(context<C>& cxt, const homomorphism<C>& h, const order<C>& o, const SDD<C>& x)
+{
+  assert(h.selector() && "Split with an homomorphism which is not a selector.");
+  if (x.empty())
+  {
+    return {x, x};
+  }
+  if (h == id<C>())
+  {
+    return {x, zero<C>()};
+  }
+  const cached_split_key<C> key{o, h, x};
+  return cxt.split_cache().evaluate(key, [&]{return key.operation();});
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Hash specialization for sdd::hom::cached_split.
+template <typename C>
+struct hash<sdd::hom::cached_split<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::cached_split<C>& cs)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(cs.hom) (val(cs.sdd)) (val(cs.ord));
+  }
+};
+
+/// @internal
+/// @brief Hash specialization for sdd::hom::cached_split_key.
+///
+/// Same as the hash of the operation it describes.
+template <typename C>
+struct hash<sdd::hom::cached_split_key<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::cached_split_key<C>& key)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(key.hom) (val(key.sdd)) (val(sdd::hom::cached_order(key.ord)));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
@@ -21,6 +21,7 @@
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/split.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -73,6 +74,29 @@ struct LIBSDD_ATTRIBUTE_PACKED _sum
     return dd::sum(cxt.sdd_context(), std::move(sum_operands));
   }
 
+  /// @brief Split, when all operands are selectors.
+  ///
+  /// Each operand only splits the part rejected by the previous ones.
+  split_result<C>
+  split(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    dd::sum_builder<C, SDD<C>> accepted(cxt.sdd_context());
+    accepted.reserve(size);
+    auto rejected = x;
+    for (const auto& op : *this)
+    {
+      auto parts = hom::split(cxt, op, o, rejected);
+      accepted.add(std::move(parts.accepted));
+      rejected = std::move(parts.rejected);
+      if (rejected.empty())
+      {
+        break;
+      }
+    }
+    return {dd::sum(cxt.sdd_context(), std::move(accepted)), std::move(rejected)};
+  }
+
   /// @brief Skip variable predicate.
   bool
   skip(const order<C>& o)
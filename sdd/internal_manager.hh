@@ -7,16 +7,22 @@
 #pragma once
 
 #include <cassert>
+#include <memory> // make_shared, shared_ptr
 
 #include <boost/container/flat_set.hpp>
 
 #include "sdd/internal_manager_fwd.hh"
 #include "sdd/dd/context.hh"
 #include "sdd/dd/definition.hh"
+#include "sdd/dd/level_partitioner.hh"
+#include "sdd/dd/level_profile.hh"
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/hom/predicates.hh"
+#include "sdd/mem/computed_table.hh"
 #include "sdd/mem/unique_table.hh"
+#include "sdd/order/order.hh"
 
 namespace sdd {
 
@@ -41,17 +47,33 @@ struct internal_manager
   /// @brief The type of a smart pointer to a unified SDD.
   using sdd_ptr_type = typename SDD<C>::ptr_type;
 
+  /// @brief The type of the table of unified SDD.
+  ///
+  /// It maintains a per-variable profile and it can be partitioned by variables.
+  using sdd_unique_table_type
+    = mem::unique_table<sdd_unique_type, dd::level_profile<C>, dd::level_partitioner<C>>;
+
   /// @brief The type of a unified homomorphism.
   using hom_unique_type = typename homomorphism<C>::unique_type;
 
   /// @brief The type of a smart pointer to a unified homomorphism.
   using hom_ptr_type = typename homomorphism<C>::ptr_type;
 
+  /// @brief The type of the table of unified homomorphisms.
+  ///
+  /// It stores the predicates of homomorphisms.
+  using hom_unique_table_type = mem::unique_table<hom_unique_type, hom::predicates<C>>;
+
+  /// @brief The nodes of all orders.
+  ///
+  /// Orders only point to these nodes, thus it's the last member to be destroyed.
+  typename order<C>::registry order_registry;
+
   /// @brief Manage the handlers needed by ptr when a unified data is no longer referenced.
   struct ptr_handlers
   {
-    ptr_handlers( mem::unique_table<sdd_unique_type>& sdd_ut
-                , mem::unique_table<hom_unique_type>& hom_ut)
+    ptr_handlers( sdd_unique_table_type& sdd_ut
+                , hom_unique_table_type& hom_ut)
     {
       mem::set_deletion_handler<sdd_unique_type>([&](const sdd_unique_type* u){sdd_ut.erase(u);});
       mem::set_deletion_handler<hom_unique_type>([&](const hom_unique_type* u){hom_ut.erase(u);});
@@ -65,13 +87,19 @@ struct internal_manager
   } handlers;
 
   /// @brief The set of a unified SDD.
-  mem::unique_table<sdd_unique_type> sdd_unique_table;
+  sdd_unique_table_type sdd_unique_table;
+
+  /// @brief The memory ceiling of caches, if the configuration asks them to adapt their capacity.
+  const std::shared_ptr<mem::cache_budget> cache_budget;
+
+  /// @brief The computed table shared by all caches, if the configuration asks for it.
+  const std::shared_ptr<mem::computed_table> unified_cache;
 
   /// @brief The SDD operations evaluation context.
   dd::context<C> sdd_context;
 
   /// @brief The set of unified homomorphisms.
-  mem::unique_table<hom_unique_type> hom_unique_table;
+  hom_unique_table_type hom_unique_table;
 
   /// @brief The homomorphisms evaluation context.
   hom::context<C> hom_context;
@@ -88,20 +116,42 @@ struct internal_manager
   /// @brief Used to avoid frequent useless reallocations in saturation_fixpoint().
   boost::container::flat_set<homomorphism<C>> saturation_fixpoint_data;
 
+  /// @brief Tell if Saturation Fixpoints apply their most productive operands first.
+  const bool saturation_reordering;
+
+  /// @brief Store one out of this number of consecutive skipped levels in the cache.
+  const std::size_t hom_skip_cache_period;
+
   /// @brief Constructor with a given configuration.
   internal_manager(const C& configuration)
-    : handlers(sdd_unique_table, hom_unique_table)
-    , sdd_unique_table(configuration.sdd_unique_table_size)
+    : order_registry()
+    , handlers(sdd_unique_table, hom_unique_table)
+    , sdd_unique_table( configuration.sdd_unique_table_partitioned
+                       ? configuration.sdd_unique_table_partition_size
+                       : configuration.sdd_unique_table_size
+                      , configuration.sdd_unique_table_partitioned)
+    , cache_budget( configuration.adaptive_caches
+                  ? std::make_shared<mem::cache_budget>(configuration.cache_memory_ceiling)
+                  : nullptr)
+    , unified_cache( configuration.unified_cache
+                   ? std::make_shared<mem::computed_table>( configuration.unified_cache_size
+                                                          , cache_budget)
+                   : nullptr)
     , sdd_context( configuration.sdd_difference_cache_size
                  , configuration.sdd_intersection_cache_size
                  , configuration.sdd_sum_cache_size
-                 , configuration.sdd_arena_size)
+                 , configuration.sdd_arena_size
+                 , unified_cache
+                 , cache_budget)
     , hom_unique_table(configuration.hom_unique_table_size)
-    , hom_context(configuration.hom_cache_size, sdd_context)
+    , hom_context( configuration.hom_cache_size, sdd_context, unified_cache, cache_budget
+                 , configuration.hom_function_cache_size, configuration.hom_split_cache_size)
     , zero(mk_terminal<zero_terminal<C>>())
     , one(mk_terminal<one_terminal<C>>())
     , id(mk_id())
     , saturation_fixpoint_data()
+    , saturation_reordering(configuration.saturation_reordering)
+    , hom_skip_cache_period(configuration.hom_skip_cache_period)
   {}
 
 private:
@@ -7,8 +7,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex> // recursive_mutex, unique_lock
+#include <vector>
 
 #include "sdd/internal_manager.hh"
+#include "sdd/hom/executor.hh"
 #include "sdd/values_manager.hh"
 
 namespace sdd {
@@ -30,7 +33,8 @@ class manager;
 /// @param configuration An instance of the configuration.
 /// @throw std::runtime_error if the library was already initialized.
 ///
-/// It must be the first function called before any other call to the library.
+/// It must be the first function called before any other call to the library, including the
+/// construction of an order. SDD, homomorphisms and orders must not outlive the returned manager.
 template <typename C>
 manager<C>
 init(const C& configuration = C())
@@ -82,6 +86,51 @@ public:
     ptr_->reset_hom_cache();
   }
 
+  /// @brief Get the control of the interruption of homomorphisms evaluations.
+  ///
+  /// It sets a cancellation token, a deadline and a progress callback for all evaluations.
+  hom::interruption<C>&
+  interruption()
+  noexcept
+  {
+    return ptr_->interruption();
+  }
+
+  /// @brief Apply an homomorphism on a background thread.
+  ///
+  /// Applications are queued and evaluated one at a time, as the library is not thread-safe. As
+  /// long as applications are queued, other threads must hold lock() to use the library, and must
+  /// not hold it while waiting for a result. Using the library includes building, copying and
+  /// destroying SDD and homomorphisms, and building orders.
+  ///
+  /// This overload copies the operands, thus it takes lock(): it waits for the end of the running
+  /// evaluation, if any.
+  hom::async_evaluation<C>
+  apply_async(const homomorphism<C>& h, const order<C>& o, const SDD<C>& x)
+  {
+    return ptr_->apply_async(h, o, x);
+  }
+
+  /// @brief Apply an homomorphism on a background thread, taking ownership of its operands.
+  ///
+  /// Moving the operands doesn't use the library, thus this overload doesn't take lock(): it can
+  /// be called while an evaluation is running, and returns without waiting for it. The operands
+  /// must have been obtained while holding lock(), like any use of the library.
+  hom::async_evaluation<C>
+  apply_async(homomorphism<C>&& h, order<C> o, SDD<C>&& x)
+  {
+    return ptr_->apply_async(std::move(h), std::move(o), std::move(x));
+  }
+
+  /// @brief Get the lock that protects the library from concurrent uses.
+  ///
+  /// It's recursive.
+  std::unique_lock<std::recursive_mutex>
+  lock()
+  {
+    return ptr_->lock();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDDs.
   const mem::unique_table_statistics&
@@ -91,6 +140,31 @@ public:
     return ptr_->sdd_stats();
   }
 
+  /// @brief Get the statistics of live SDD nodes, per variable number.
+  ///
+  /// The returned vector is indexed by variable numbers. As each hierarchical level numbers its
+  /// variables from 0, nodes of different levels with the same variable number are merged. It's
+  /// maintained by the unique table of SDD, thus it's cheap enough to be sampled frequently, e.g.
+  /// at each fixpoint iteration. Note that nodes only referenced by caches are still alive.
+  const std::vector<dd::level_statistics>&
+  sdd_level_profile()
+  const noexcept
+  {
+    return ptr_->sdd_level_profile();
+  }
+
+  /// @internal
+  /// @brief Get the statistics of each partition of the unique table of SDD.
+  ///
+  /// The partition 0 contains terminals, the partition v + 1 the nodes of variable v. There's
+  /// only one partition if the configuration doesn't enable partitioning.
+  std::vector<mem::unique_table_statistics>
+  sdd_partitions_stats()
+  const
+  {
+    return ptr_->sdd_partitions_stats();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDD difference operations.
   const mem::cache_statistics&
@@ -136,6 +210,49 @@ public:
     return ptr_->hom_cache_stats();
   }
 
+  /// @internal
+  /// @brief Get the statistics of the cache of applications of user's functions.
+  ///
+  /// They are empty if this cache is disabled.
+  mem::cache_statistics
+  hom_function_cache_stats()
+  const
+  {
+    return ptr_->hom_function_cache_stats();
+  }
+
+  /// @internal
+  /// @brief Get the statistics of the cache of splits by selectors.
+  const mem::cache_statistics&
+  hom_split_cache_stats()
+  const noexcept
+  {
+    return ptr_->hom_split_cache_stats();
+  }
+
+  /// @internal
+  /// @brief Get the statistics of the computed table shared by all caches.
+  ///
+  /// It's empty if caches don't share their entries.
+  mem::computed_table_statistics
+  unified_cache_stats()
+  const
+  {
+    return ptr_->unified_cache_stats();
+  }
+
+#ifdef LIBSDD_PROFILE
+  /// @brief Get the profiles of homomorphisms applications.
+  ///
+  /// Only available when the library is compiled with LIBSDD_PROFILE.
+  const hom::profiler<C>&
+  hom_profiler()
+  const noexcept
+  {
+    return ptr_->hom_profiler();
+  }
+#endif
+
   /// @internal
   auto
   values_stats()
@@ -173,15 +290,21 @@ private:
   /// @brief The manager of SDD and homomorphisms.
   std::unique_ptr<internal_manager<C>> m_;
 
+  /// @brief Evaluate homomorphisms on a background thread.
+  ///
+  /// It's stopped before the library is released.
+  hom::executor<C> executor_;
+
 public:
 
   manager_impl( std::unique_ptr<values_manager<values_type>>&& vm_ptr
               , std::unique_ptr<internal_manager<C>>&& im_ptr)
-    : values_(std::move(vm_ptr)), m_(std::move(im_ptr))
+    : values_(std::move(vm_ptr)), m_(std::move(im_ptr)), executor_(m_->hom_context)
   {}
 
   ~manager_impl()
   {
+    executor_.stop();
     *global_ptr<C>() = nullptr;
     *global_values_ptr<values_type>() = nullptr;
   }
@@ -193,6 +316,35 @@ public:
     m_->hom_context.clear();
   }
 
+  /// @brief Get the control of the interruption of homomorphisms evaluations.
+  hom::interruption<C>&
+  interruption()
+  noexcept
+  {
+    return m_->hom_context.interruption();
+  }
+
+  /// @brief Apply an homomorphism on a background thread.
+  hom::async_evaluation<C>
+  apply_async(const homomorphism<C>& h, const order<C>& o, const SDD<C>& x)
+  {
+    return executor_.apply(h, o, x);
+  }
+
+  /// @brief Apply an homomorphism on a background thread, taking ownership of its operands.
+  hom::async_evaluation<C>
+  apply_async(homomorphism<C>&& h, order<C> o, SDD<C>&& x)
+  {
+    return executor_.apply(std::move(h), std::move(o), std::move(x));
+  }
+
+  /// @brief Get the lock that protects the library from concurrent uses.
+  std::unique_lock<std::recursive_mutex>
+  lock()
+  {
+    return executor_.lock();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDDs.
   const mem::unique_table_statistics&
@@ -202,6 +354,23 @@ public:
     return m_->sdd_unique_table.stats();
   }
 
+  /// @brief Get the statistics of live SDD nodes, per variable.
+  const std::vector<dd::level_statistics>&
+  sdd_level_profile()
+  const noexcept
+  {
+    return m_->sdd_unique_table.observer().levels();
+  }
+
+  /// @internal
+  /// @brief Get the statistics of each partition of the unique table of SDD.
+  std::vector<mem::unique_table_statistics>
+  sdd_partitions_stats()
+  const
+  {
+    return m_->sdd_unique_table.partitions_stats();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDD difference operations.
   const mem::cache_statistics&
@@ -247,6 +416,45 @@ public:
     return m_->hom_context.cache().statistics();
   }
 
+  /// @internal
+  /// @brief Get the statistics of the cache of applications of user's functions.
+  mem::cache_statistics
+  hom_function_cache_stats()
+  const
+  {
+    return m_->hom_context.has_function_cache()
+         ? m_->hom_context.function_cache().statistics()
+         : mem::cache_statistics{};
+  }
+
+  /// @internal
+  /// @brief Get the statistics of the cache of splits by selectors.
+  const mem::cache_statistics&
+  hom_split_cache_stats()
+  const noexcept
+  {
+    return m_->hom_context.split_cache().statistics();
+  }
+
+  /// @internal
+  /// @brief Get the statistics of the computed table shared by all caches.
+  mem::computed_table_statistics
+  unified_cache_stats()
+  const
+  {
+    return m_->unified_cache ? m_->unified_cache->statistics() : mem::computed_table_statistics{};
+  }
+
+#ifdef LIBSDD_PROFILE
+  /// @internal
+  const hom::profiler<C>&
+  hom_profiler()
+  const noexcept
+  {
+    return m_->hom_context.profiler();
+  }
+#endif
+
   /// @internal
   auto
   values_stats()
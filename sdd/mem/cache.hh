@@ -6,12 +6,15 @@
 
 #pragma once
 
-#include <memory> // unique_ptr
+#include <memory>  // make_shared, shared_ptr
+#include <string>
 #include <tuple>
+#include <type_traits> // conditional_t, result_of_t
+#include <utility> // forward, move
 
 #include "sdd/mem/cache_entry.hh"
+#include "sdd/mem/computed_table.hh"
 #include "sdd/mem/hash_table.hh"
-#include "sdd/mem/lru_list.hh"
 #include "sdd/util/hash.hh"
 
 namespace sdd { namespace mem {
@@ -59,38 +62,25 @@ struct apply_filters<T, Filter, Filters...>
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief The statistics of a cache.
-struct cache_statistics
+/// @brief Get the type of the result of an operation stored in a cache.
+///
+/// It's the type returned by the evaluation of the operation.
+template <typename Operation, typename Context, typename = void>
+struct cache_result
 {
-  /// @brief The number of entries.
-  std::size_t size;
-
-  /// @brief The number of hits.
-  std::size_t hits;
-
-  /// @brief The number of misses.
-  std::size_t misses;
-
-  /// @brief The number of filtered entries.
-  std::size_t filtered;
-
-  /// @brief The number of entries discarded by the LRU policy.
-  std::size_t discarded;
-
-  /// @brief The number of buckets with more than one element in the underlying hash table.
-  std::size_t collisions;
-
-  /// @brief The number of buckets with only one element in the underlying hash table.
-  std::size_t alone;
-
-  /// @brief The number of empty buckets in the underlying hash table.
-  std::size_t empty;
-
-  /// @brief The number of buckets in the underlying hash table.
-  std::size_t buckets;
+  using type = std::result_of_t<Operation(Context&)>;
+};
 
-  /// @brief The load factor of the underlying hash table.
-  double load_factor;
+/// @internal
+/// @brief Get the type of the result of an operation which is not evaluated by itself.
+///
+/// Such an operation is evaluated by the key which describes it, see cache::evaluate(), and it
+/// gives the type of its result.
+template <typename Operation, typename Context>
+struct cache_result< Operation, Context
+                   , std::conditional_t<true, void, typename Operation::result_type>>
+{
+  using type = typename Operation::result_type;
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -100,7 +90,8 @@ struct cache_statistics
 /// @tparam Operation is the operation type.
 /// @tparam Filters is a list of filters that reject some operations.
 ///
-/// It uses the LRU strategy to cleanup old entries.
+/// It uses the LRU strategy to cleanup old entries. Entries are stored in a computed_table, which
+/// can be shared with other caches.
 template <typename Context, typename Operation, typename... Filters>
 class cache
 {
@@ -114,7 +105,7 @@ private:
   using context_type = Context;
 
   /// @brief The type of the result of an operation stored in the cache.
-  using result_type = std::result_of_t<Operation(context_type&)>;
+  using result_type = typename cache_result<Operation, context_type>::type;
 
   /// @brief The of an entry that stores an operation and its result.
   using cache_entry_type = cache_entry<Operation, result_type>;
@@ -128,83 +119,62 @@ private:
   /// @brief The wanted load factor for the underlying hash table.
   static constexpr double max_load_factor = 0.85;
 
-  /// @brief The actual storage of caches entries.
+  /// @brief Index the entries of this cache.
   set_type set_;
 
-  /// @brief The the container that sorts cache entries by last access date.
-  lru_list<cache_entry_type> lru_list_;
+  /// @brief Tell if the computed table is shared with other caches.
+  const bool shared_;
 
-  /// @brief The maximum size this cache is authorized to grow to.
-  std::size_t max_size_;
+  /// @brief The actual storage of caches entries.
+  const std::shared_ptr<computed_table> table_;
+
+  /// @brief Identify this cache in the computed table.
+  const computed_table::tag_type tag_;
 
   /// @brief The statistics of this cache.
   mutable cache_statistics stats_;
 
-  /// @brief Fixed-size pool allocator for cache entries.
-  struct pool
-  {
-    union node
-    {
-      node* next;
-      unsigned char data[sizeof(cache_entry_type)];
-    };
-
-    std::unique_ptr<node[]> head;
-    node* free_list;
-
-    pool(std::size_t size)
-      : head(std::make_unique<node[]>(size)), free_list(head.get())
-    {
-      for (std::size_t i = 0; i < size - 1; ++i)
-      {
-        free_list[i].next = &free_list[i+1];
-      }
-      free_list[size - 1].next = nullptr;
-    }
-
-    void*
-    allocate()
-    noexcept
-    {
-      assert(free_list != nullptr);
-      void* p = free_list;
-      free_list = free_list->next;
-      return p;
-    }
-
-    void
-    deallocate(void* ptr)
-    noexcept
-    {
-      assert(ptr != nullptr);
-      node* p = static_cast<node*>(ptr);
-      p->next = free_list;
-      free_list = p;
-    }
-  } pool_;
-
 public:
 
   /// @brief Construct a cache.
   /// @param context This cache's context.
   /// @param size How many cache entries are kept, should be greater than the order height.
   ///
-  /// When the maximal size is reached, a cleanup is launched: half of the cache is removed,
-  /// using a LRU strategy. This cache will never perform a rehash, therefore it allocates
-  /// all the memory it needs at its construction.
+  /// When the maximal size is reached, the least recently used entry is removed. This cache will
+  /// never perform a rehash, therefore it allocates all the memory it needs for its buckets at its
+  /// construction; entries are allocated at the first insertion.
   cache(context_type& context, std::size_t size)
+    : cache(context, size, nullptr, std::string())
+  {}
+
+  /// @brief Construct a cache which stores its entries in a given computed table.
+  /// @param context This cache's context.
+  /// @param size The number of buckets is deduced from this size.
+  /// @param table Where entries are stored; a private one is created if it's nullptr.
+  /// @param name Identify this cache in the statistics of the computed table.
+  /// @param budget If not nullptr, the private table adapts its capacity within this budget.
+  ///
+  /// The number of entries is bounded by the capacity of the table, thus the size only matters for
+  /// the performance of the lookups when the table is shared.
+  cache( context_type& context, std::size_t size, std::shared_ptr<computed_table> table
+       , std::string name, std::shared_ptr<cache_budget> budget = nullptr)
     : cxt_(context)
     , set_(size, max_load_factor)
-    , lru_list_()
-    , max_size_(set_.bucket_count() * max_load_factor)
+    , shared_(table != nullptr)
+    , table_(shared_ ? std::move(table)
+                     : std::make_shared<computed_table>(
+                         static_cast<std::size_t>(set_.bucket_count() * max_load_factor)
+                         , std::move(budget)))
+    , tag_(table_->attach( this, &discard, &relocate, &resized, &statistics_of, std::move(name)
+                         , sizeof(cache_entry_type), alignof(cache_entry_type)))
     , stats_()
-    , pool_(max_size_)
   {}
 
   /// @brief Destructor.
   ~cache()
   {
     clear();
+    table_->detach(tag_);
   }
 
   /// @brief Cache lookup.
@@ -218,46 +188,73 @@ public:
       return op(cxt_);
     }
 
-    // Lookup for op.
     typename set_type::insert_commit_data commit_data;
-    auto insertion = set_.insert_check( op
-                                      , [](auto&& lhs, auto&& rhs){return lhs == rhs.operation;}
-                                      , commit_data);
-
-    // Check if op has already been computed.
-    if (not insertion.second)
+    if (const auto entry = find(op, commit_data))
     {
-      ++stats_.hits;
-      // Move cache entry to the end of the LRU list.
-      lru_list_.splice(lru_list_.end(), lru_list_, insertion.first->lru_cit_);
-      return insertion.first->result;
+      return entry->result;
     }
-
-    ++stats_.misses;
-
-    cache_entry_type* entry;
     auto res = op(cxt_); // evaluation may throw
+    return insert(std::move(op), std::move(res), commit_data);
+  }
 
-    // Clean up the cache, if necessary.
-    if (set_.size() == max_size_)
+  /// @brief Cache lookup with a key describing an operation.
+  /// @param key Must have the same hash as the operation it describes and be comparable to
+  /// operations with ==.
+  /// @param make Build the operation from the key.
+  ///
+  /// The operation is built only when it's not found, thus a hit doesn't pay for its construction.
+  template <typename Key, typename Make>
+  result_type
+  operator()(const Key& key, Make&& make)
+  {
+    static_assert(sizeof...(Filters) == 0, "Filters need an operation");
+    typename set_type::insert_commit_data commit_data;
+    if (const auto entry = find(key, commit_data))
     {
-      auto oldest = lru_list_.front();
-      set_.erase(oldest);
-      oldest->~cache_entry_type();
-      pool_.deallocate(oldest);
-      lru_list_.pop_front();
-      ++stats_.discarded;
+      return entry->result;
     }
+    auto op = make();
+    auto res = op(cxt_); // evaluation may throw
+    return insert(std::move(op), std::move(res), commit_data);
+  }
 
-    entry = new (pool_.allocate()) cache_entry_type(std::move(op), std::move(res));
-
-    // Add the new cache entry to the end of the LRU list.
-    entry->lru_cit_ = lru_list_.insert(lru_list_.end(), entry);
+  /// @brief Cache lookup with a key which evaluates the operation it describes.
+  /// @param key Must have the same hash as the operation it describes and be comparable to
+  /// operations with ==. It's evaluated when it's not found, and filters are applied to it.
+  /// @param make Build the operation to store from the key, once it has been evaluated.
+  ///
+  /// The key may borrow what the stored operation must own: ownership is only taken on a miss.
+  template <typename Key, typename Make>
+  result_type
+  evaluate(const Key& key, Make&& make)
+  {
+    if (not apply_filters<Key, Filters...>()(key))
+    {
+      ++stats_.filtered;
+      return key(cxt_);
+    }
 
-    // Finally, set the result associated to op.
-    set_.insert_commit(entry, commit_data); // doesn't throw
+    typename set_type::insert_commit_data commit_data;
+    if (const auto entry = find(key, commit_data))
+    {
+      return entry->result;
+    }
+    auto res = key(cxt_); // evaluation may throw
+    return insert(make(), std::move(res), commit_data);
+  }
 
-    return entry->result;
+  /// @brief Let the computed table of this cache change its capacity, if it decided to.
+  ///
+  /// Resizing relocates all entries of the table in O(capacity), thus lookups only record that
+  /// it's needed, and the owner of the cache calls this method at quiescent points. It must not be
+  /// called while an entry is being read.
+  void
+  adapt()
+  {
+    if (table_->should_adapt())
+    {
+      table_->adapt();
+    }
   }
 
   /// @brief Remove all entries of the cache.
@@ -268,7 +265,7 @@ public:
     set_.clear_and_dispose([&](cache_entry_type* x)
                               {
                                 x->~cache_entry_type();
-                                pool_.deallocate(x);
+                                table_->release(x);
                               });
   }
 
@@ -289,8 +286,106 @@ public:
     std::tie(stats_.collisions, stats_.alone, stats_.empty) = set_.collisions();
     stats_.buckets = set_.bucket_count();
     stats_.load_factor = set_.load_factor();
+    stats_.bytes_per_entry = table_->bytes_per_entry();
+    stats_.footprint = set_.bucket_count() * sizeof(cache_entry_type*)
+                     + (shared_ ? 0 : table_->capacity() * table_->bytes_per_entry());
+    stats_.capacity = table_->capacity();
+    stats_.grown = table_->grown();
+    stats_.shrunk = table_->shrunk();
+    stats_.denied = table_->denied();
     return stats_;
   }
+
+private:
+
+  /// @brief Look for an operation, nullptr if it's not found.
+  ///
+  /// A found entry becomes the most recently used one.
+  template <typename Key>
+  const cache_entry_type*
+  find(const Key& key, typename set_type::insert_commit_data& commit_data)
+  {
+    auto insertion = set_.insert_check( key
+                                      , [](auto&& lhs, auto&& rhs){return lhs == rhs.operation;}
+                                      , commit_data);
+    if (not insertion.second)
+    {
+      ++stats_.hits;
+      // Move cache entry to the end of the LRU list.
+      table_->touch(insertion.first);
+      return insertion.first;
+    }
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  /// @brief Store an operation and its result, once find() didn't find it.
+  result_type
+  insert( Operation&& op, result_type&& res
+        , typename set_type::insert_commit_data& commit_data)
+  {
+    // Get a slot for the new entry, which may discard the least recently used entry.
+    auto entry = new (table_->allocate(tag_)) cache_entry_type(std::move(op), std::move(res));
+
+    // Finally, set the result associated to op.
+    set_.insert_commit(entry, commit_data); // doesn't throw
+
+    // If the table should now adapt its capacity, it's left to adapt(): this insertion may happen
+    // deep in a recursive evaluation.
+    return entry->result;
+  }
+
+  /// @brief Called by the computed table to move an entry of this cache to another slot.
+  static
+  void
+  relocate(void* c, void* from, void* to)
+  {
+    auto& self = *static_cast<cache*>(c);
+    auto entry = static_cast<cache_entry_type*>(from);
+    self.set_.erase(entry);
+    auto moved = new (to) cache_entry_type(std::move(*entry));
+    entry->~cache_entry_type();
+    typename set_type::insert_commit_data commit_data;
+    self.set_.insert_check( moved->operation
+                          , [](auto&& lhs, auto&& rhs){return lhs == rhs.operation;}
+                          , commit_data);
+    self.set_.insert_commit(moved, commit_data);
+  }
+
+  /// @brief Called by the computed table when its capacity has changed.
+  ///
+  /// When the table is private, buckets follow its capacity.
+  static
+  void
+  resized(void* c, std::size_t capacity)
+  {
+    auto& self = *static_cast<cache*>(c);
+    if (not self.shared_)
+    {
+      self.set_.rehash(static_cast<std::size_t>(capacity / max_load_factor));
+    }
+  }
+
+  /// @brief Called by the computed table to discard an entry of this cache.
+  static
+  void
+  discard(void* c, void* e)
+  {
+    auto& self = *static_cast<cache*>(c);
+    auto entry = static_cast<cache_entry_type*>(e);
+    self.set_.erase(entry);
+    entry->~cache_entry_type();
+    self.table_->release(entry);
+    ++self.stats_.discarded;
+  }
+
+  /// @brief Called by the computed table to get the statistics of this cache.
+  static
+  const cache_statistics&
+  statistics_of(const void* c)
+  {
+    return static_cast<const cache*>(c)->statistics();
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -7,11 +7,9 @@
 #pragma once
 
 #include <functional> // hash
-#include <list>
-#include <utility>    // forward
+#include <utility>    // forward, move
 
 #include "sdd/mem/hash_table.hh"
-#include "sdd/mem/lru_list.hh"
 #include "sdd/util/hash.hh"
 
 namespace sdd { namespace mem {
@@ -29,17 +27,14 @@ struct cache_entry
   cache_entry(const cache_entry&) = delete;
   cache_entry& operator=(const cache_entry&) = delete;
 
-  /// @brief
+  /// @brief Link to the next entry in the same bucket of the cache's hash table.
   mem::intrusive_member_hook<cache_entry> hook;
 
   /// @brief The cached operation.
-  const Operation operation;
+  Operation operation;
 
   /// @brief The result of the evaluation of operation.
-  const Result result;
-
-  /// @brief Where this cache entry is stored in the LRU list.
-  typename lru_list<cache_entry>::const_iterator lru_cit_;
+  Result result;
 
   /// @brief Constructor.
   template <typename... Args>
@@ -47,7 +42,15 @@ struct cache_entry
     : hook()
     , operation(std::move(op))
     , result(std::forward<Args>(args)...)
-    , lru_cit_()
+  {}
+
+  /// @brief Move constructor.
+  ///
+  /// Used to relocate an entry when its computed table is resized.
+  cache_entry(cache_entry&& other)
+    : hook()
+    , operation(std::move(other.operation))
+    , result(std::move(other.result))
   {}
 
   /// @brief Cache entries are only compared using their operations.
@@ -0,0 +1,659 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // count_if, max, min
+#include <cassert>
+#include <cstddef>   // max_align_t
+#include <cstdint>   // uint8_t
+#include <cstring>   // memcpy
+#include <memory>    // shared_ptr, unique_ptr
+#include <string>
+#include <utility>   // pair
+#include <vector>
+
+#include "sdd/mem/lru_list.hh"
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The statistics of a cache.
+struct cache_statistics
+{
+  /// @brief The number of entries.
+  std::size_t size;
+
+  /// @brief The number of hits.
+  std::size_t hits;
+
+  /// @brief The number of misses.
+  std::size_t misses;
+
+  /// @brief The number of filtered entries.
+  std::size_t filtered;
+
+  /// @brief The number of entries discarded by the LRU policy.
+  std::size_t discarded;
+
+  /// @brief The number of buckets with more than one element in the underlying hash table.
+  std::size_t collisions;
+
+  /// @brief The number of buckets with only one element in the underlying hash table.
+  std::size_t alone;
+
+  /// @brief The number of empty buckets in the underlying hash table.
+  std::size_t empty;
+
+  /// @brief The number of buckets in the underlying hash table.
+  std::size_t buckets;
+
+  /// @brief The load factor of the underlying hash table.
+  double load_factor;
+
+  /// @brief The number of bytes of one entry, operation and result included.
+  std::size_t bytes_per_entry;
+
+  /// @brief The number of bytes allocated by the cache for its entries and its buckets.
+  ///
+  /// All the memory is allocated when the cache is created, thus it doesn't depend on the number of
+  /// entries. When entries are shared with other caches, only buckets are counted.
+  std::size_t footprint;
+
+  /// @brief The maximal number of entries of the computed table of this cache.
+  std::size_t capacity;
+
+  /// @brief The number of times the computed table of this cache has grown.
+  std::size_t grown;
+
+  /// @brief The number of times the computed table of this cache has shrunk.
+  std::size_t shrunk;
+
+  /// @brief The number of times the computed table of this cache couldn't grow within its budget.
+  std::size_t denied;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A decision to change the capacity of a computed table.
+struct resize_event
+{
+  /// @brief The number of misses of the table when it was resized.
+  std::size_t misses;
+
+  /// @brief The capacity before the resize.
+  std::size_t from;
+
+  /// @brief The capacity after the resize.
+  std::size_t to;
+
+  /// @brief The hit rate observed since the previous decision.
+  double hit_rate;
+
+  /// @brief The ratio of misses that discarded an entry since the previous decision.
+  double discard_rate;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The statistics of a computed table shared by several caches.
+struct computed_table_statistics
+{
+  /// @brief The maximal number of entries.
+  std::size_t capacity;
+
+  /// @brief The number of entries, all operations included.
+  std::size_t size;
+
+  /// @brief The number of entries discarded by the LRU policy.
+  std::size_t discarded;
+
+  /// @brief The number of bytes of one entry.
+  std::size_t bytes_per_entry;
+
+  /// @brief The number of bytes allocated for entries.
+  std::size_t footprint;
+
+  /// @brief The number of times this table couldn't grow within its budget.
+  std::size_t denied;
+
+  /// @brief All changes of capacity, in chronological order.
+  std::vector<resize_event> resizes;
+
+  /// @brief The statistics of each cache using this table, with its name.
+  ///
+  /// It gives hits and misses per kind of operation.
+  std::vector<std::pair<std::string, cache_statistics>> caches;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A memory ceiling shared by computed tables which adapt their capacity.
+///
+/// Only the memory of entries is accounted for, not the one of the buckets of caches.
+class cache_budget
+{
+  // Can't copy a cache_budget.
+  cache_budget(const cache_budget&) = delete;
+  cache_budget& operator=(const cache_budget&) = delete;
+
+private:
+
+  /// @brief The maximal number of bytes.
+  const std::size_t ceiling_;
+
+  /// @brief The number of bytes used by all tables.
+  std::size_t used_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param ceiling The maximal number of bytes.
+  cache_budget(std::size_t ceiling)
+    : ceiling_(ceiling), used_(0)
+  {}
+
+  /// @brief Account for some bytes, even if the ceiling is exceeded.
+  void
+  charge(std::size_t bytes)
+  noexcept
+  {
+    used_ += bytes;
+  }
+
+  /// @brief Give back some bytes.
+  void
+  release(std::size_t bytes)
+  noexcept
+  {
+    assert(bytes <= used_);
+    used_ -= bytes;
+  }
+
+  /// @brief Get the number of bytes that can still be charged without exceeding the ceiling.
+  std::size_t
+  available()
+  const noexcept
+  {
+    return used_ < ceiling_ ? ceiling_ - used_ : 0;
+  }
+
+  /// @brief Get the maximal number of bytes.
+  std::size_t
+  ceiling()
+  const noexcept
+  {
+    return ceiling_;
+  }
+
+  /// @brief Get the number of bytes used by all tables.
+  std::size_t
+  used()
+  const noexcept
+  {
+    return used_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The storage of cache entries, with an LRU policy.
+///
+/// Each cache indexes its own entries with a hash table, but entries are stored in a computed table
+/// which decides which one is discarded when it's full: the least recently used one, whatever the
+/// cache it belongs to. Thus, when a table is shared by several caches, they share a single memory
+/// budget which shifts to the most active operations. Entries are stored in slots of the size of
+/// the largest entry, allocated when the first entry is stored.
+///
+/// When it's given a budget, the table adapts its capacity: after each window of misses, it grows
+/// if most misses discarded an entry (the working set doesn't fit), and it shrinks if entries are
+/// seldom reused or if it's mostly empty. Resizing relocates entries in O(capacity), thus a cache
+/// doesn't resize the table when should_adapt() becomes true: it's left to cache::adapt(), called
+/// by the owner of the cache at quiescent points, never while an entry is being read.
+class computed_table
+{
+  // Can't copy a computed_table.
+  computed_table(const computed_table&) = delete;
+  computed_table& operator=(const computed_table&) = delete;
+
+public:
+
+  /// @brief The type of an index of an entry.
+  using index_type = lru_list::index_type;
+
+  /// @brief Identify a cache using this table.
+  using tag_type = std::uint8_t;
+
+  /// @brief Called to discard an entry of a cache.
+  using discard_type = void (*)(void* cache, void* entry);
+
+  /// @brief Called to move an entry of a cache to another slot.
+  using relocate_type = void (*)(void* cache, void* from, void* to);
+
+  /// @brief Called when the capacity of the table has changed.
+  using resized_type = void (*)(void* cache, std::size_t capacity);
+
+  /// @brief Called to get the statistics of a cache.
+  using statistics_type = const cache_statistics& (*)(const void* cache);
+
+  /// @brief An adaptive table never shrinks below this capacity, unless it started smaller.
+  static constexpr std::size_t min_capacity = 1024;
+
+  /// @brief The minimal number of misses between two decisions of an adaptive table.
+  static constexpr std::size_t min_window = 4096;
+
+  /// @brief An adaptive table grows when at least this ratio of misses discarded an entry.
+  static constexpr double grow_discard_rate = 0.5;
+
+  /// @brief Under this hit rate, an adaptive table shrinks and never grows.
+  static constexpr double min_hit_rate = 0.05;
+
+private:
+
+  /// @brief A cache using this table.
+  struct owner
+  {
+    /// @brief The cache, nullptr once detached.
+    void* cache;
+
+    /// @brief How to discard one of its entries.
+    discard_type discard;
+
+    /// @brief How to move one of its entries.
+    relocate_type relocate;
+
+    /// @brief How to tell it that the capacity has changed.
+    resized_type resized;
+
+    /// @brief How to get its statistics.
+    statistics_type statistics;
+
+    /// @brief Its name.
+    std::string name;
+  };
+
+  /// @brief The maximal number of entries.
+  std::size_t capacity_;
+
+  /// @brief The size of a slot, large enough for all entries.
+  std::size_t slot_size_;
+
+  /// @brief The alignment of slots, enough for all entries.
+  std::size_t slot_alignment_;
+
+  /// @brief All slots, allocated at the first allocation of an entry.
+  std::unique_ptr<unsigned char[]> slots_;
+
+  /// @brief The cache which owns the entry of each slot.
+  std::unique_ptr<tag_type[]> tags_;
+
+  /// @brief Sort entries by last access date.
+  lru_list lru_;
+
+  /// @brief The caches using this table.
+  std::vector<owner> owners_;
+
+  /// @brief The first free slot, the next free one being stored in the slot itself.
+  index_type free_;
+
+  /// @brief Slots after this one have never been used.
+  index_type unused_;
+
+  /// @brief The number of entries.
+  std::size_t size_;
+
+  /// @brief The number of entries discarded by the LRU policy.
+  std::size_t discarded_;
+
+  /// @brief The number of allocated entries.
+  std::size_t misses_;
+
+  /// @brief If not nullptr, the capacity adapts to the usage of the table, within this budget.
+  const std::shared_ptr<cache_budget> budget_;
+
+  /// @brief An adaptive table doesn't shrink below this capacity.
+  const std::size_t floor_;
+
+  /// @brief The number of misses between two decisions.
+  std::size_t window_;
+
+  /// @brief The number of hits since the last decision.
+  std::size_t window_hits_;
+
+  /// @brief The number of misses since the last decision.
+  std::size_t window_misses_;
+
+  /// @brief The number of discarded entries since the last decision.
+  std::size_t window_discarded_;
+
+  /// @brief The number of times this table couldn't grow within its budget.
+  std::size_t denied_;
+
+  /// @brief All changes of capacity.
+  std::vector<resize_event> resizes_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param capacity The maximal number of entries.
+  /// @param budget If not nullptr, capacity is only the initial one and it adapts to the usage of
+  /// the table, within this budget.
+  computed_table(std::size_t capacity, std::shared_ptr<cache_budget> budget = nullptr)
+    : capacity_(std::max<std::size_t>(capacity, 1)), slot_size_(0), slot_alignment_(1)
+    , slots_(), tags_(), lru_(capacity_), owners_(), free_(lru_hook::nil), unused_(0), size_(0)
+    , discarded_(0), misses_(0), budget_(std::move(budget))
+    , floor_(std::min(capacity_, std::size_t(min_capacity)))
+    , window_(std::max(capacity_, std::size_t(min_window))), window_hits_(0), window_misses_(0)
+    , window_discarded_(0), denied_(0), resizes_()
+  {}
+
+  /// @brief Destructor.
+  ~computed_table()
+  {
+    if (budget_ and slots_)
+    {
+      budget_->release(capacity_ * bytes_per_entry());
+    }
+  }
+
+  /// @brief Register a cache.
+  /// @param entry_size The size of the entries of this cache.
+  /// @param entry_alignment The alignment of the entries of this cache.
+  /// @return The tag that identifies this cache.
+  ///
+  /// All caches must be attached before the first allocation.
+  tag_type
+  attach( void* cache, discard_type discard, relocate_type relocate, resized_type resized
+        , statistics_type statistics, std::string name, std::size_t entry_size
+        , std::size_t entry_alignment)
+  {
+    assert(not slots_ && "Cache attached after the first allocation");
+    assert(owners_.size() < 256 && "Too many caches");
+    slot_alignment_ = std::max(slot_alignment_, entry_alignment);
+    slot_size_ = std::max({slot_size_, entry_size, sizeof(index_type)});
+    slot_size_ = (slot_size_ + slot_alignment_ - 1) / slot_alignment_ * slot_alignment_;
+    owners_.push_back(owner{cache, discard, relocate, resized, statistics, std::move(name)});
+    return static_cast<tag_type>(owners_.size() - 1);
+  }
+
+  /// @brief Unregister a cache, which must have released all its entries.
+  void
+  detach(tag_type tag)
+  noexcept
+  {
+    owners_[tag].cache = nullptr;
+  }
+
+  /// @brief Get a slot to store a new entry of a cache.
+  ///
+  /// When the table is full, the least recently used entry is discarded by its cache.
+  void*
+  allocate(tag_type tag)
+  {
+    if (not slots_)
+    {
+      // new[] returns an address suitably aligned for any fundamental type.
+      assert(slot_alignment_ <= alignof(std::max_align_t));
+      slots_.reset(new unsigned char[capacity_ * slot_size_]);
+      tags_.reset(new tag_type[capacity_]);
+      if (budget_)
+      {
+        budget_->charge(capacity_ * bytes_per_entry());
+      }
+    }
+    index_type i;
+    if (free_ != lru_hook::nil)
+    {
+      i = free_;
+      std::memcpy(&free_, slot(i), sizeof(index_type));
+    }
+    else if (unused_ < capacity_)
+    {
+      i = unused_++;
+    }
+    else
+    {
+      discard_oldest();
+      ++window_discarded_;
+      i = free_;
+      std::memcpy(&free_, slot(i), sizeof(index_type));
+    }
+    tags_[i] = tag;
+    lru_.push_back(i);
+    ++size_;
+    ++misses_;
+    ++window_misses_;
+    return slot(i);
+  }
+
+  /// @brief Give back the slot of an entry, which must have been destroyed.
+  void
+  release(const void* entry)
+  noexcept
+  {
+    const auto i = index(entry);
+    lru_.erase(i);
+    std::memcpy(slot(i), &free_, sizeof(index_type));
+    free_ = i;
+    --size_;
+  }
+
+  /// @brief Make an entry the most recently used one.
+  void
+  touch(const void* entry)
+  noexcept
+  {
+    lru_.touch(index(entry));
+    ++window_hits_;
+  }
+
+  /// @brief Tell if an adaptive table should decide to change its capacity.
+  bool
+  should_adapt()
+  const noexcept
+  {
+    return budget_ and window_misses_ >= window_;
+  }
+
+  /// @brief Decide to change the capacity, using what was observed since the last decision.
+  ///
+  /// It must not be called while an entry is being read, as entries may be relocated.
+  void
+  adapt()
+  {
+    assert(budget_);
+    const auto hits = window_hits_;
+    const auto misses = window_misses_;
+    const auto discarded = window_discarded_;
+    window_hits_ = window_misses_ = window_discarded_ = 0;
+    if (misses == 0)
+    {
+      return;
+    }
+    const auto hit_rate = static_cast<double>(hits) / static_cast<double>(hits + misses);
+    const auto discard_rate = static_cast<double>(discarded) / static_cast<double>(misses);
+
+    auto target = capacity_;
+    if (hit_rate < min_hit_rate or size_ * 4 < capacity_)
+    {
+      // Entries are seldom reused, or the table is mostly empty: give memory back.
+      target = std::max(capacity_ / 2, floor_);
+    }
+    else if (discard_rate >= grow_discard_rate)
+    {
+      // The working set doesn't fit: double, or take what's left if it's at least a quarter.
+      const auto extra = std::min(capacity_, budget_->available() / bytes_per_entry());
+      if (extra == 0 or extra < capacity_ / 4)
+      {
+        ++denied_;
+        return;
+      }
+      target = capacity_ + extra;
+    }
+    if (target != capacity_)
+    {
+      resizes_.push_back(resize_event{misses_, capacity_, target, hit_rate, discard_rate});
+      resize(target);
+    }
+  }
+
+  /// @brief Change the capacity.
+  ///
+  /// When the new capacity is smaller than the number of entries, the least recently used ones are
+  /// discarded. Remaining entries are relocated by their caches, thus it must not be called while
+  /// an entry is being read.
+  void
+  resize(std::size_t capacity)
+  {
+    capacity = std::max<std::size_t>(capacity, 1);
+    assert(capacity < lru_hook::nil && "Too many cache entries");
+    if (not slots_)
+    {
+      capacity_ = capacity;
+      lru_ = lru_list(capacity_);
+    }
+    else
+    {
+      std::unique_ptr<unsigned char[]> slots(new unsigned char[capacity * slot_size_]);
+      std::unique_ptr<tag_type[]> tags(new tag_type[capacity]);
+      lru_list lru(capacity);
+
+      while (size_ > capacity)
+      {
+        discard_oldest();
+      }
+
+      // Move entries at the beginning of the new slots, keeping their order of use.
+      index_type i = lru_.empty() ? index_type(lru_hook::nil) : lru_.front();
+      index_type j = 0;
+      for (; i != lru_hook::nil; i = lru_.next(i), ++j)
+      {
+        const auto& o = owners_[tags_[i]];
+        o.relocate(o.cache, slot(i), slots.get() + static_cast<std::size_t>(j) * slot_size_);
+        tags[j] = tags_[i];
+        lru.push_back(j);
+      }
+
+      if (budget_)
+      {
+        budget_->release(capacity_ * bytes_per_entry());
+        budget_->charge(capacity * bytes_per_entry());
+      }
+      slots_ = std::move(slots);
+      tags_ = std::move(tags);
+      lru_ = std::move(lru);
+      free_ = lru_hook::nil;
+      unused_ = j;
+      capacity_ = capacity;
+    }
+    window_ = std::max(capacity_, std::size_t(min_window));
+    for (const auto& o : owners_)
+    {
+      if (o.cache != nullptr)
+      {
+        o.resized(o.cache, capacity_);
+      }
+    }
+  }
+
+  /// @brief Get the maximal number of entries.
+  std::size_t
+  capacity()
+  const noexcept
+  {
+    return capacity_;
+  }
+
+  /// @brief Get the number of bytes used by one entry.
+  std::size_t
+  bytes_per_entry()
+  const noexcept
+  {
+    return slot_size_ + sizeof(tag_type) + sizeof(lru_hook);
+  }
+
+  /// @brief Get the number of times this table has grown.
+  std::size_t
+  grown()
+  const noexcept
+  {
+    return static_cast<std::size_t>(std::count_if( resizes_.begin(), resizes_.end()
+                                                 , [](const auto& r){return r.to > r.from;}));
+  }
+
+  /// @brief Get the number of times this table has shrunk.
+  std::size_t
+  shrunk()
+  const noexcept
+  {
+    return resizes_.size() - grown();
+  }
+
+  /// @brief Get the number of times this table couldn't grow within its budget.
+  std::size_t
+  denied()
+  const noexcept
+  {
+    return denied_;
+  }
+
+  /// @brief Get the statistics of this table and of the caches using it.
+  computed_table_statistics
+  statistics()
+  const
+  {
+    computed_table_statistics stats{ capacity_, size_, discarded_, bytes_per_entry()
+                                   , capacity_ * bytes_per_entry(), denied_, resizes_, {}};
+    for (const auto& o : owners_)
+    {
+      if (o.cache != nullptr)
+      {
+        stats.caches.emplace_back(o.name, o.statistics(o.cache));
+      }
+    }
+    return stats;
+  }
+
+private:
+
+  /// @brief Discard the least recently used entry.
+  void
+  discard_oldest()
+  {
+    const auto i = lru_.front();
+    const auto& victim = owners_[tags_[i]];
+    victim.discard(victim.cache, slot(i)); // calls release()
+    ++discarded_;
+  }
+
+  /// @brief Get the address of a slot.
+  unsigned char*
+  slot(index_type i)
+  const noexcept
+  {
+    return slots_.get() + static_cast<std::size_t>(i) * slot_size_;
+  }
+
+  /// @brief Get the index of the slot of an entry.
+  index_type
+  index(const void* entry)
+  const noexcept
+  {
+    const auto offset = static_cast<const unsigned char*>(entry) - slots_.get();
+    assert(offset >= 0 and static_cast<std::size_t>(offset) % slot_size_ == 0);
+    return static_cast<index_type>(static_cast<std::size_t>(offset) / slot_size_);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <algorithm>   // fill
+#include <algorithm>   // fill, max
 #include <cassert>
 #include <functional>  // hash
 #include <memory>      // unique_ptr
@@ -43,9 +43,12 @@ class hash_table
 public:
 
   /// @brief Used by insert_check
+  ///
+  /// It keeps the hash value rather than the bucket, thus it stays valid if the table is rehashed
+  /// between insert_check() and insert_commit().
   struct insert_commit_data
   {
-    Data** bucket;
+    std::size_t hash;
   };
 
 private:
@@ -84,10 +87,10 @@ public:
   {
     static_assert(not Rehash, "Use with fixed-size hash table only");
 
-    const std::size_t pos = std::hash<T>()(x) & (nb_buckets_ - 1);
+    commit_data.hash = std::hash<T>()(x);
+    const std::size_t pos = commit_data.hash & (nb_buckets_ - 1);
 
     Data* current = buckets_[pos];
-    commit_data.bucket = buckets_.get() + pos;
 
     while (current != nullptr)
     {
@@ -108,8 +111,9 @@ public:
     static_assert(not Rehash, "Use with fixed-size hash table only");
     assert(x != nullptr);
 
+    Data** bucket = buckets_.get() + (commit_data.hash & (nb_buckets_ - 1));
     Data* previous = nullptr;
-    Data* current = *commit_data.bucket;
+    Data* current = *bucket;
 
     // We append x at the end of the bucket, it seems to be faster than appending it directly
     // in front.
@@ -125,7 +129,7 @@ public:
     }
     else
     {
-      *commit_data.bucket = x;
+      *bucket = x;
     }
 
     ++size_;
@@ -185,6 +189,21 @@ public:
     assert(false && "Data to erase not found");
   }
 
+  /// @brief Apply a function on all elements.
+  template <typename Function>
+  void
+  for_each(Function&& f)
+  const
+  {
+    for (std::size_t i = 0; i < nb_buckets_; ++i)
+    {
+      for (const Data* current = buckets_[i]; current != nullptr; current = current->hook.next)
+      {
+        f(*current);
+      }
+    }
+  }
+
   /// @brief Clear the whole table.
   template <typename Disposer>
   void
@@ -204,6 +223,30 @@ public:
     size_ = 0;
   }
 
+  /// @brief Change the number of buckets.
+  /// @param size The number of buckets is the next power of 2 of this size.
+  void
+  rehash(std::size_t size)
+  {
+    const auto new_nb_buckets = util::next_power_of_2(std::max<std::size_t>(size, 1));
+    auto new_buckets = std::make_unique<Data*[]>(new_nb_buckets);
+    std::fill(new_buckets.get(), new_buckets.get() + new_nb_buckets, nullptr);
+    for (std::size_t i = 0; i < nb_buckets_; ++i)
+    {
+      Data* data_ptr = buckets_[i];
+      while (data_ptr)
+      {
+        Data* next = data_ptr->hook.next;
+        const std::size_t pos = std::hash<Data>()(*data_ptr) & (new_nb_buckets - 1);
+        data_ptr->hook.next = new_buckets[pos];
+        new_buckets[pos] = data_ptr;
+        data_ptr = next;
+      }
+    }
+    buckets_ = std::move(new_buckets);
+    nb_buckets_ = new_nb_buckets;
+  }
+
   /// @brief Get the load factor of the internal hash table.
   double
   load_factor()
@@ -6,16 +6,157 @@
 
 #pragma once
 
-#include <list>
+#include <cassert>
+#include <cstdint> // uint32_t
+#include <limits>
+#include <memory>  // unique_ptr
 
 namespace sdd { namespace mem {
 
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief The type of the container that sorts cache entries by last access date.
-template <typename CacheEntry>
-using lru_list = std::list<CacheEntry*>;
+/// @brief The links of a cache entry in the LRU list.
+struct lru_hook
+{
+  /// @brief The type of an index of a cache entry.
+  using index_type = std::uint32_t;
+
+  /// @brief Mark the absence of a cache entry.
+  static constexpr index_type nil = std::numeric_limits<index_type>::max();
+
+  /// @brief The previous (older) cache entry.
+  index_type prev = nil;
+
+  /// @brief The next (more recent) cache entry.
+  index_type next = nil;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A list that sorts cache entries by last access date.
+///
+/// Cache entries are stored in an array of fixed size, thus they are identified by their indexes
+/// in this array. Links are stored aside, in an array of the same size, rather than in a node
+/// allocated for each entry. The front is the oldest entry.
+class lru_list
+{
+  // Can't copy an lru_list.
+  lru_list(const lru_list&) = delete;
+  lru_list& operator=(const lru_list&) = delete;
+
+public:
+
+  /// @brief The type of an index of a cache entry.
+  using index_type = lru_hook::index_type;
+
+private:
+
+  /// @brief The links of all cache entries.
+  std::unique_ptr<lru_hook[]> links_;
+
+  /// @brief The oldest cache entry.
+  index_type front_;
+
+  /// @brief The most recent cache entry.
+  index_type back_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param size The number of cache entries.
+  lru_list(std::size_t size)
+    : links_(std::make_unique<lru_hook[]>(size)), front_(lru_hook::nil), back_(lru_hook::nil)
+  {
+    assert(size < lru_hook::nil && "Too many cache entries");
+  }
+
+  /// @brief Move constructor.
+  lru_list(lru_list&&) = default;
+
+  /// @brief Move operator.
+  lru_list& operator=(lru_list&&) = default;
+
+  /// @brief Tell if there are no entries in the list.
+  bool
+  empty()
+  const noexcept
+  {
+    return front_ == lru_hook::nil;
+  }
+
+  /// @brief Get the oldest entry.
+  index_type
+  front()
+  const noexcept
+  {
+    assert(not empty());
+    return front_;
+  }
+
+  /// @brief Get the entry used just after a given one, lru_hook::nil if it's the most recent one.
+  index_type
+  next(index_type i)
+  const noexcept
+  {
+    return links_[i].next;
+  }
+
+  /// @brief Add an entry as the most recent one.
+  void
+  push_back(index_type i)
+  noexcept
+  {
+    links_[i].prev = back_;
+    links_[i].next = lru_hook::nil;
+    if (back_ == lru_hook::nil)
+    {
+      front_ = i;
+    }
+    else
+    {
+      links_[back_].next = i;
+    }
+    back_ = i;
+  }
+
+  /// @brief Remove an entry.
+  void
+  erase(index_type i)
+  noexcept
+  {
+    const auto& link = links_[i];
+    if (link.prev == lru_hook::nil)
+    {
+      front_ = link.next;
+    }
+    else
+    {
+      links_[link.prev].next = link.next;
+    }
+    if (link.next == lru_hook::nil)
+    {
+      back_ = link.prev;
+    }
+    else
+    {
+      links_[link.next].prev = link.prev;
+    }
+  }
+
+  /// @brief Make an entry the most recent one.
+  void
+  touch(index_type i)
+  noexcept
+  {
+    if (i != back_)
+    {
+      erase(i);
+      push_back(i);
+    }
+  }
+};
 
 /*------------------------------------------------------------------------------------------------*/
 
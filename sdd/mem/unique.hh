@@ -52,6 +52,12 @@ private:
   /// Implements a reference-counting garbage collection.
   std::uint32_t ref_count_;
 
+  /// @brief A dense identifier, unique among all live data of the same unique_table.
+  ///
+  /// It's set by the unique_table when the data is effectively inserted. It's meant to be used
+  /// as an index in vectors or bitmaps, rather than using the address of the data as a key.
+  std::uint32_t id_;
+
   /// @brief The garbage collected data.
   ///
   /// The ptr class is responsible for the detection of dereferenced data and for
@@ -63,7 +69,7 @@ public:
   template <typename... Args>
   unique(Args&&... args)
   noexcept(std::is_nothrow_constructible<T, Args...>::value)
-    : hook(), ref_count_(0), data_(std::forward<Args>(args)...)
+    : hook(), ref_count_(0), id_(0), data_(std::forward<Args>(args)...)
   {}
 
   /// @brief Get a reference of the unified data.
@@ -74,6 +80,14 @@ public:
     return data_;
   }
 
+  /// @brief Get the dense identifier of the unified data.
+  std::uint32_t
+  id()
+  const noexcept
+  {
+    return id_;
+  }
+
   /// @brief Tell if the unified data is no longer referenced.
   bool
   is_not_referenced()
@@ -82,6 +96,14 @@ public:
     return ref_count_ == 0;
   }
 
+  /// @brief Get the number of ptr which reference the unified data.
+  std::uint32_t
+  reference_counter()
+  const noexcept
+  {
+    return ref_count_;
+  }
+
   /// @brief Equality.
   friend
   bool
@@ -111,6 +133,9 @@ public:
 
   // hash_table needs to access the hook.
   template <typename, bool> friend class hash_table;
+
+  // unique_table needs to set the identifier.
+  template <typename, typename, typename> friend class unique_table;
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <algorithm> // max
 #include <cassert>
-#include <memory> // unique_ptr
+#include <cstdint>   // uint32_t
+#include <memory>    // unique_ptr
+#include <tuple>     // tie
+#include <utility>   // forward
+#include <vector>
 
 #include "sdd/mem/hash_table.hh"
 
@@ -54,9 +59,56 @@ struct unique_table_statistics
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief The default observer of a unique_table: it does nothing.
+///
+/// An observer is notified when a data is effectively inserted, found again (hit) or erased.
+struct no_observer
+{
+  template <typename Unique>
+  void
+  on_insert(const Unique&)
+  const noexcept
+  {}
+
+  template <typename Unique>
+  void
+  on_hit(const Unique&)
+  const noexcept
+  {}
+
+  template <typename Unique>
+  void
+  on_erase(const Unique&)
+  const noexcept
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The default partitioner of a unique_table: all data belong to the same partition.
+struct no_partitioner
+{
+  template <typename Unique>
+  std::size_t
+  operator()(const Unique&)
+  const noexcept
+  {
+    return 0;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief A table to unify data.
-template <typename Unique>
+/// @tparam Observer Notified of all insertions, hits and erasures.
+/// @tparam Partitioner Give the index of the partition of a data.
+///
+/// When partitioning is enabled, each partition has its own hash table and its own cached
+/// allocation. Otherwise, all data are stored in the same partition.
+template <typename Unique, typename Observer = no_observer, typename Partitioner = no_partitioner>
 class unique_table
 {
   // Can't copy a unique_table.
@@ -65,25 +117,79 @@ class unique_table
 
 private:
 
-  /// @brief The actual container of unified data.
-  mem::hash_table<Unique> set_;
+  /// @brief A subset of the unified data.
+  struct partition
+  {
+    /// @brief The actual container of unified data.
+    mem::hash_table<Unique> set;
+
+    /// @brief Keep the memory of an insertion that was a hit.
+    std::unique_ptr<char[]> cache;
+
+    /// @brief The number of bytes of the cached memory.
+    std::size_t cache_size;
+
+    /// @brief The number of hits.
+    std::size_t hits;
+
+    /// @brief The number of misses.
+    std::size_t misses;
+
+    partition(std::size_t initial_size)
+      : set(initial_size), cache(nullptr), cache_size(0), hits(0), misses(0)
+    {}
+  };
+
+  /// @brief The partitions of unified data, created on demand.
+  std::vector<partition> partitions_;
+
+  /// @brief Tell if data are dispatched in several partitions.
+  const bool partitioned_;
+
+  /// @brief The initial size of partitions created on demand.
+  const std::size_t partition_size_;
+
+  /// @brief The number of unified data, in all partitions.
+  std::size_t size_;
 
   /// @brief The statistics of this unique_table.
   mutable unique_table_statistics stats_;
 
-  /// @brief Keep the memory of an insertion that was a hit.
-  std::unique_ptr<char[]> cache_;
+  /// @brief Identifiers of erased data, ready to be given to new data.
+  ///
+  /// Its capacity is never smaller than next_id_, thus giving back an identifier never allocates.
+  std::vector<std::uint32_t> free_ids_;
+
+  /// @brief The smallest identifier that has never been given.
+  std::uint32_t next_id_;
+
+  /// @brief Notified of all insertions, hits and erasures.
+  Observer observer_;
+
+  /// @brief Give the partition of a data.
+  Partitioner partitioner_;
 
-  /// @brief The number of bytes of the cached memory.
-  std::size_t cache_size_;
+  /// @brief Tell if a data is being erased.
+  bool erasing_;
+
+  /// @brief Data released while another one was erased, waiting for their own erasure.
+  ///
+  /// They are already removed from their hash table, thus they are chained with their hook.
+  Unique* pending_erasures_;
 
 public:
 
   /// @brief Constructor.
-  /// @param initial_size Initial capacity of the container.
-  unique_table(std::size_t initial_size)
-    : set_(initial_size), stats_(), cache_(nullptr), cache_size_(0)
-  {}
+  /// @param initial_size Initial capacity of the container, or of each partition when
+  /// partitioned is true.
+  /// @param partitioned Tell if data should be dispatched in partitions given by Partitioner.
+  unique_table(std::size_t initial_size, bool partitioned = false)
+    : partitions_(), partitioned_(partitioned), partition_size_(initial_size), size_(0), stats_()
+    , free_ids_(), next_id_(0), observer_(), partitioner_(), erasing_(false)
+    , pending_erasures_(nullptr)
+  {
+    partitions_.emplace_back(initial_size);
+  }
 
   /// @brief Unify a data.
   /// @param ptr A pointer to a data constructed with a placement new into the storage returned by
@@ -97,17 +203,25 @@ public:
     assert(ptr != nullptr);
     ++stats_.access;
 
-    auto insertion = set_.insert(ptr);
+    if (free_ids_.capacity() <= next_id_)
+    {
+      // Before ptr may be given a new identifier.
+      free_ids_.reserve(2 * next_id_ + 1);
+    }
+    auto& p = get_partition(partitioner_(*ptr));
+    auto insertion = p.set.insert(ptr);
     if (not insertion.second) // ptr already exists
     {
       ++stats_.hits;
+      ++p.hits;
+      observer_.on_hit(*insertion.first);
       ptr->~Unique();
-      if ((sizeof(Unique) + extra_bytes) > cache_size_)
+      if ((sizeof(Unique) + extra_bytes) > p.cache_size)
       {
         // The inserted ptr's memory to cache is bigger than the previously held cache. Thus it
         // might fit better allocations request by allocate().
-        cache_.reset(reinterpret_cast<char*>(ptr));
-        cache_size_ = sizeof(Unique) + extra_bytes;
+        p.cache.reset(reinterpret_cast<char*>(ptr));
+        p.cache_size = sizeof(Unique) + extra_bytes;
       }
       else
       {
@@ -117,21 +231,35 @@ public:
     else
     {
       ++stats_.misses;
-      stats_.peak = std::max(stats_.peak, set_.size());
+      ++p.misses;
+      ++size_;
+      stats_.peak = std::max(stats_.peak, size_);
+      if (free_ids_.empty())
+      {
+        ptr->id_ = next_id_++;
+      }
+      else
+      {
+        ptr->id_ = free_ids_.back();
+        free_ids_.pop_back();
+      }
+      observer_.on_insert(*ptr);
     }
     return *insertion.first;
   }
 
   /// @brief Allocate a memory block large enough for the given size.
+  /// @param partition_hint The partition the data to construct will likely belong to.
   char*
-  allocate(std::size_t extra_bytes)
+  allocate(std::size_t extra_bytes, std::size_t partition_hint = 0)
   {
-    if (cache_ and cache_size_ >= (sizeof(Unique) + extra_bytes))
+    auto& p = get_partition(partition_hint);
+    if (p.cache and p.cache_size >= (sizeof(Unique) + extra_bytes))
     {
       // re-use cached allocation
-      auto res = cache_.get();
-      cache_.release();
-      cache_size_ = 0;
+      auto res = p.cache.get();
+      p.cache.release();
+      p.cache_size = 0;
       return res;
     }
     else
@@ -143,30 +271,177 @@ public:
 
   /// @brief Erase the given unified data.
   ///
-  /// All subsequent uses of the erased data are invalid.
+  /// All subsequent uses of the erased data are invalid. Destroying a data releases the data it
+  /// references, which may be erased in turn: their destruction is postponed until the current one
+  /// is finished, thus a long chain of data, like the levels of a deep SDD, is erased in a loop
+  /// rather than in a recursion which could overflow the stack.
   void
   erase(const Unique* x)
   noexcept
   {
     assert(x != nullptr);
     assert(x->is_not_referenced() && "Unique still referenced");
-    set_.erase(x);
-    x->~Unique();
-    delete[] reinterpret_cast<const char*>(x); // match new char[] of allocate().
+    observer_.on_erase(*x);
+    get_partition(partitioner_(*x)).set.erase(x);
+    --size_;
+    if (erasing_)
+    {
+      // x is no longer in the hash table, its hook is free to chain it.
+      x->hook.next = pending_erasures_;
+      pending_erasures_ = const_cast<Unique*>(x);
+      return;
+    }
+    erasing_ = true;
+    destroy(x);
+    while (pending_erasures_ != nullptr)
+    {
+      const auto pending = pending_erasures_;
+      pending_erasures_ = pending->hook.next;
+      destroy(pending);
+    }
+    erasing_ = false;
+  }
+
+  /// @brief Get the number of unified data.
+  ///
+  /// O(1).
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @brief Get an upper bound of all identifiers given to live data.
+  ///
+  /// Identifiers are recycled, thus they always belong to [0, identifiers_bound()), a range
+  /// which size is the peak number of unified data.
+  std::uint32_t
+  identifiers_bound()
+  const noexcept
+  {
+    return next_id_;
+  }
+
+  /// @brief Get the observer of this unique_table.
+  const Observer&
+  observer()
+  const noexcept
+  {
+    return observer_;
+  }
+
+  /// @brief Get the observer of this unique_table.
+  Observer&
+  observer()
+  noexcept
+  {
+    return observer_;
+  }
+
+  /// @brief Get the partitioner of this unique_table.
+  const Partitioner&
+  partitioner()
+  const noexcept
+  {
+    return partitioner_;
+  }
+
+  /// @brief Get the number of partitions created so far.
+  std::size_t
+  nb_partitions()
+  const noexcept
+  {
+    return partitions_.size();
+  }
+
+  /// @brief Apply a function on all unified data of a partition.
+  template <typename Function>
+  void
+  for_each(std::size_t partition, Function&& f)
+  const
+  {
+    assert(partition < partitions_.size());
+    partitions_[partition].set.for_each(std::forward<Function>(f));
   }
 
   /// @brief Get the statistics of this unique_table.
+  ///
+  /// They cover all partitions.
   const unique_table_statistics&
   stats()
   const noexcept
   {
-    stats_.size = set_.size();
-    stats_.load_factor = set_.load_factor();
-    stats_.rehash = set_.nb_rehash();
-    std::tie(stats_.collisions, stats_.alone, stats_.empty) = set_.collisions();
-    stats_.buckets = set_.bucket_count();
+    stats_.size = size_;
+    stats_.rehash = 0;
+    stats_.collisions = 0;
+    stats_.alone = 0;
+    stats_.empty = 0;
+    stats_.buckets = 0;
+    for (const auto& p : partitions_)
+    {
+      std::size_t collisions, alone, empty;
+      std::tie(collisions, alone, empty) = p.set.collisions();
+      stats_.rehash += p.set.nb_rehash();
+      stats_.collisions += collisions;
+      stats_.alone += alone;
+      stats_.empty += empty;
+      stats_.buckets += p.set.bucket_count();
+    }
+    stats_.load_factor = static_cast<double>(stats_.size) / static_cast<double>(stats_.buckets);
     return stats_;
   }
+
+  /// @brief Get the statistics of each partition of this unique_table.
+  ///
+  /// The access field is not filled as it's only maintained for the whole table.
+  std::vector<unique_table_statistics>
+  partitions_stats()
+  const
+  {
+    std::vector<unique_table_statistics> res;
+    res.reserve(partitions_.size());
+    for (const auto& p : partitions_)
+    {
+      unique_table_statistics s{};
+      s.size = p.set.size();
+      s.load_factor = p.set.load_factor();
+      s.hits = p.hits;
+      s.misses = p.misses;
+      s.rehash = p.set.nb_rehash();
+      std::tie(s.collisions, s.alone, s.empty) = p.set.collisions();
+      s.buckets = p.set.bucket_count();
+      res.push_back(s);
+    }
+    return res;
+  }
+
+private:
+
+  /// @brief Destroy a data already removed from its hash table.
+  void
+  destroy(const Unique* x)
+  noexcept
+  {
+    free_ids_.push_back(x->id());
+    x->~Unique();
+    delete[] reinterpret_cast<const char*>(x); // match new char[] of allocate().
+  }
+
+  /// @brief Get a partition, create it if needed.
+  partition&
+  get_partition(std::size_t index)
+  {
+    if (not partitioned_)
+    {
+      return partitions_.front();
+    }
+    while (index >= partitions_.size())
+    {
+      partitions_.emplace_back(partition_size_);
+    }
+    return partitions_[index];
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
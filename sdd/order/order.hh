@@ -6,20 +6,24 @@
 
 #pragma once
 
-#include <algorithm>  // find
+#include <algorithm>  // find, max
+#include <atomic>
+#include <cstdint>    // uintptr_t
 #include <initializer_list>
 #include <iostream>
-#include <memory>     // shared_ptr
+#include <memory>     // shared_ptr, unique_ptr
 #include <sstream>
 #include <utility>    // pair
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "sdd/internal_manager_fwd.hh"
 #include "sdd/order/order_builder.hh"
 #include "sdd/order/order_error.hh"
 #include "sdd/order/order_identifier.hh"
 #include "sdd/order/order_node.hh"
+#include "sdd/util/deep_call.hh"
 #include "sdd/util/hash.hh"
 
 namespace sdd {
@@ -38,6 +42,21 @@ using order_positions_iterator = typename order_positions_type::const_iterator;
 ///
 /// It helps associate a variable (generated by the library) in an SDD to an identifier
 /// (provided by the user). An identifier should appear only once by order.
+///
+/// An order is a cursor on nodes interned by the manager: orders built from equal builders share
+/// the same nodes. An order built from a builder, or copied from another order, owns these nodes
+/// and keeps them alive. Cursors returned by next() and nested() only borrow them: moving along
+/// an order is just copying two pointers, but such a cursor must not outlive all the orders which
+/// own its nodes, unless it's copied. Nodes which are no longer owned are released by the manager
+/// from time to time, when other orders are built. Building an order from a builder looks up the
+/// nodes of the manager: as long as homomorphisms are applied asynchronously by the manager, it
+/// must be done while holding manager::lock().
+///
+/// Unlike previous versions, where an order was self-contained, orders now depend on the manager,
+/// like SDD and homomorphisms:
+/// - an order can only be built once the library is initialized by init(); this is checked by an
+///   assertion only, thus building an order before init() is undefined behavior in release builds;
+/// - an order must not outlive the manager returned by init(), not even to be destroyed.
 template <typename C>
 class order final
 {
@@ -59,33 +78,231 @@ private:
   /// @brief All nodes.
   using nodes_type = std::vector<order_node<C>>;
 
-  /// @brief A shared pointer to nodes.
-  using nodes_ptr_type = std::shared_ptr<const nodes_type>;
-
   /// @brief Define a mapping identifier->node.
   using id_to_node_type = std::unordered_map<order_identifier<C>, const order_node<C>*>;
 
-  /// @brief The concrete order.
-  nodes_ptr_type nodes_ptr_;
+  /// @brief The nodes of an order, shared by all orders built from equal builders.
+  ///
+  /// Allocated by the registry of the manager, which releases it once no order owns it.
+  struct data
+  {
+    /// @brief The concrete order.
+    nodes_type nodes;
+
+    /// @brief Maps identifiers to nodes.
+    id_to_node_type id_to_node;
 
-  /// @brief Maps identifiers to nodes.
-  std::shared_ptr<id_to_node_type> id_to_node_ptr_;
+    /// @brief The hash value of the structure of nodes.
+    std::size_t hash;
+
+    /// @brief Distinguish this data from all data created before, even if they had the same
+    /// address.
+    std::size_t serial;
+
+    /// @brief The number of orders which own this data.
+    ///
+    /// Orders may be copied and destroyed by several threads.
+    mutable std::atomic<std::size_t> owners;
+
+    /// @brief Constructor.
+    data(nodes_type&& n)
+      : nodes(std::move(n)), id_to_node(), hash(hash_structure(nodes)), serial(0), owners(0)
+    {}
+  };
+
+  /// @brief Hash data by the structure of their nodes.
+  struct data_hash
+  {
+    std::size_t
+    operator()(const data* d)
+    const noexcept
+    {
+      return d->hash;
+    }
+  };
+
+  /// @brief Compare data by the structure of their nodes.
+  struct data_equal
+  {
+    bool
+    operator()(const data* lhs, const data* rhs)
+    const noexcept
+    {
+      return lhs->hash == rhs->hash and same_structure(lhs->nodes, rhs->nodes);
+    }
+  };
+
+  /// @brief Tag the address of data owned by this order.
+  static constexpr std::uintptr_t owner_tag = 1;
+
+  /// @brief The address of the interned nodes, 0 if this order is empty.
+  ///
+  /// Its lowest bit, owner_tag, tells if this order owns the nodes or only borrows them.
+  std::uintptr_t data_;
 
   /// @brief The first node in the order.
   const order_node<C>* head_;
 
 public:
 
-  order(const order&) = default;
-  order& operator=(const order&) = default;
-  order(order&&) = default;
-  order& operator=(order&&) = default;
+  /// @internal
+  /// @brief The nodes of all orders built with a manager.
+  ///
+  /// It makes orders built from equal builders share the same nodes. The nodes which are no longer
+  /// owned by any order are released by sweep(), which is called when the number of interned data
+  /// has doubled since the last sweep, thus the memory of dead orders is bounded by the one of
+  /// live orders.
+  class registry
+  {
+    // Can't copy a registry.
+    registry(const registry&) = delete;
+    registry& operator=(const registry&) = delete;
+
+  private:
+
+    /// @brief The minimal number of interned data which triggers a sweep.
+    static constexpr std::size_t min_sweep_threshold = 64;
+
+    /// @brief All interned data.
+    std::unordered_set<const data*, data_hash, data_equal> set_;
+
+    /// @brief The number of interned data which triggers the next sweep.
+    std::size_t sweep_threshold_;
+
+  public:
+
+    /// @brief Default constructor.
+    registry()
+      : set_(), sweep_threshold_(min_sweep_threshold)
+    {}
+
+    /// @brief Destructor.
+    ~registry()
+    {
+      for (auto d : set_)
+      {
+        delete d;
+      }
+    }
+
+    /// @brief Get the shared data of the order described by a builder, nullptr if it's empty.
+    ///
+    /// The caller owns the returned data.
+    const data*
+    operator()(const order_builder<C>& builder)
+    {
+      auto nodes_ptr = mk_nodes_ptr(builder);
+      if (not nodes_ptr)
+      {
+        return nullptr;
+      }
+      if (set_.size() >= sweep_threshold_)
+      {
+        sweep();
+        sweep_threshold_ = std::max(min_sweep_threshold, 2 * set_.size());
+      }
+      std::unique_ptr<data> d(new data(std::move(*nodes_ptr)));
+      const auto insertion = set_.insert(d.get());
+      if (not insertion.second)
+      {
+        // An equal order already exists.
+        (*insertion.first)->owners.fetch_add(1, std::memory_order_relaxed);
+        return *insertion.first;
+      }
+      d->id_to_node.reserve(d->nodes.size());
+      for (const auto& n : d->nodes)
+      {
+        d->id_to_node.emplace(n.identifier(), &n);
+      }
+      static std::size_t serials = 0;
+      d->serial = ++serials;
+      d->owners.store(1, std::memory_order_relaxed);
+      return d.release();
+    }
+
+    /// @brief Release the data which are no longer owned by any order.
+    ///
+    /// Once a data is no longer owned, no order can own it again, except by building it again
+    /// with this registry.
+    void
+    sweep()
+    {
+      for (auto cit = set_.begin(); cit != set_.end();)
+      {
+        if ((*cit)->owners.load(std::memory_order_acquire) == 0)
+        {
+          delete *cit;
+          cit = set_.erase(cit);
+        }
+        else
+        {
+          ++cit;
+        }
+      }
+    }
+
+    /// @brief Get the number of distinct orders, including the ones not yet swept.
+    std::size_t
+    size()
+    const noexcept
+    {
+      return set_.size();
+    }
+  };
+
+  /// @brief Copy constructor.
+  ///
+  /// O(1), the copy owns the nodes, even if other only borrows them.
+  order(const order& other)
+  noexcept
+    : data_(acquire(other.get_data())), head_(other.head_)
+  {}
+
+  /// @brief Move constructor.
+  ///
+  /// O(1), other is left as a cursor which borrows the nodes.
+  order(order&& other)
+  noexcept
+    : data_(other.data_), head_(other.head_)
+  {
+    other.data_ &= ~owner_tag;
+  }
+
+  /// @brief Copy operator.
+  order&
+  operator=(const order& other)
+  noexcept
+  {
+    order tmp(other);
+    std::swap(data_, tmp.data_);
+    std::swap(head_, tmp.head_);
+    return *this;
+  }
+
+  /// @brief Move operator.
+  order&
+  operator=(order&& other)
+  noexcept
+  {
+    std::swap(data_, other.data_);
+    std::swap(head_, other.head_);
+    other.release();
+    return *this;
+  }
+
+  /// @brief Destructor.
+  ~order()
+  {
+    release();
+  }
 
   /// @brief Constructor.
+  /// @pre The library is initialized by init(), which is only checked by an assertion.
+  ///
+  /// Orders built from equal builders share the same nodes.
   order(const order_builder<C>& builder)
-    : nodes_ptr_(mk_nodes_ptr(builder))
-    , id_to_node_ptr_(mk_identifier_to_node(nodes_ptr_))
-    , head_(nodes_ptr_ ? &(nodes_ptr_->front()) : nullptr)
+    : data_(tag(global<C>().order_registry(builder)))
+    , head_(data_ ? &get_data()->nodes.front() : nullptr)
   {}
 
   /// @internal
@@ -96,7 +313,7 @@ public:
   contains(order_position_type upper, order_position_type nested)
   const noexcept
   {
-    const auto& path = (*nodes_ptr_)[nested].path();
+    const auto& path = get_data()->nodes[nested].path();
     return std::find(path.begin(), path.end(), upper) != path.end();
   }
 
@@ -106,7 +323,7 @@ public:
   nodes()
   const noexcept
   {
-    return *nodes_ptr_;
+    return get_data()->nodes;
   }
 
   /// @brief Get the variable of this order's head.
@@ -133,22 +350,37 @@ public:
     return head_->position();
   }
 
+  /// @internal
+  /// @brief Get an identifier of the nodes of this order, never reused for other nodes.
+  ///
+  /// Equal orders have the same serial, 0 is the serial of empty orders.
+  std::size_t
+  serial()
+  const noexcept
+  {
+    return data_ ? get_data()->serial : 0;
+  }
+
   /// @brief Get the next order of this order's head.
+  ///
+  /// O(1), the returned cursor borrows the nodes of this order.
   order
   next()
   const noexcept
   {
     assert(head_ != nullptr);
-    return order(nodes_ptr_, id_to_node_ptr_, head_->next());
+    return order(get_data(), head_->next());
   }
 
   /// @brief Get the nested order of this order's head.
+  ///
+  /// O(1), the returned cursor borrows the nodes of this order.
   order
   nested()
   const noexcept
   {
     assert(head_ != nullptr);
-    return order(nodes_ptr_, id_to_node_ptr_, head_->nested());
+    return order(get_data(), head_->nested());
   }
 
   /// @brief Tell if this order is empty.
@@ -173,14 +405,15 @@ public:
   node(const identifier_type& id)
   const
   {
-    try
+    if (data_ != 0)
     {
-      return *id_to_node_ptr_->at(order_identifier<C>(id));
-    }
-    catch (std::out_of_range&)
-    {
-      throw identifier_not_found_error<C>(id);
+      const auto search = get_data()->id_to_node.find(order_identifier<C>(id));
+      if (search != get_data()->id_to_node.end())
+      {
+        return *search->second;
+      }
     }
+    throw identifier_not_found_error<C>(id);
   }
 
   /// @internal
@@ -188,25 +421,19 @@ public:
   node_from_position(order_position_type pos)
   const noexcept
   {
-    return (*nodes_ptr_)[pos];
+    return get_data()->nodes[pos];
   }
 
   /// @brief Equality.
+  ///
+  /// O(1): as equal orders share the same nodes, it suffices to compare heads. All empty orders
+  /// are equal.
   friend
   bool
   operator==(const order& lhs, const order& rhs)
   noexcept
   {
-    if (lhs.empty())
-    {
-      return rhs.empty();
-    }
-    else if (rhs.empty())
-    {
-      return false;
-    }
-    return lhs.position() == rhs.position() and lhs.identifier() == rhs.identifier()
-       and lhs.nested() == rhs.nested() and lhs.next() == rhs.next();
+    return lhs.head_ == rhs.head_;
   }
 
 private:
@@ -231,17 +458,93 @@ private:
     }
   }
 
-  /// @brief Construct with a shallow copy an already existing order.
-  order( nodes_ptr_type nodes_ptr, std::shared_ptr<id_to_node_type> id_to_node
-       , const order_node<C>* head)
-    : nodes_ptr_{std::move(nodes_ptr)}
-    , id_to_node_ptr_{std::move(id_to_node)}
-    , head_{head}
+  /// @brief Construct a cursor which borrows already existing nodes.
+  order(const data* d, const order_node<C>* head)
+  noexcept
+    : data_(head ? reinterpret_cast<std::uintptr_t>(d) : 0), head_(head)
   {}
 
+  /// @brief Get the interned nodes, nullptr if this order is empty.
+  const data*
+  get_data()
+  const noexcept
+  {
+    return reinterpret_cast<const data*>(data_ & ~owner_tag);
+  }
+
+  /// @brief Tag the address of an owned data.
+  static
+  std::uintptr_t
+  tag(const data* d)
+  noexcept
+  {
+    return d ? reinterpret_cast<std::uintptr_t>(d) | owner_tag : 0;
+  }
+
+  /// @brief Own a data.
+  static
+  std::uintptr_t
+  acquire(const data* d)
+  noexcept
+  {
+    if (d)
+    {
+      d->owners.fetch_add(1, std::memory_order_relaxed);
+    }
+    return tag(d);
+  }
+
+  /// @brief Give up the nodes if this order owns them.
+  ///
+  /// The data is released by the next sweep of the registry if it's no longer owned.
+  void
+  release()
+  noexcept
+  {
+    if (data_ & owner_tag)
+    {
+      get_data()->owners.fetch_sub(1, std::memory_order_release);
+      data_ &= ~owner_tag;
+    }
+  }
+
+  /// @brief Compute the hash value of the structure of nodes.
+  static
+  std::size_t
+  hash_structure(const nodes_type& nodes)
+  noexcept
+  {
+    const auto pos = [](const order_node<C>* n){return n ? n->position() + 1 : 0;};
+    std::size_t h = nodes.size();
+    for (const auto& n : nodes)
+    {
+      sdd::hash::hash_combine(h, n.identifier());
+      sdd::hash::hash_combine(h, pos(n.next()));
+      sdd::hash::hash_combine(h, pos(n.nested()));
+    }
+    return h;
+  }
+
+  /// @brief Tell if two sets of nodes have the same structure.
+  static
+  bool
+  same_structure(const nodes_type& lhs, const nodes_type& rhs)
+  noexcept
+  {
+    const auto pos = [](const order_node<C>* n){return n ? n->position() + 1 : 0;};
+    return lhs.size() == rhs.size()
+       and std::equal( lhs.begin(), lhs.end(), rhs.begin()
+                     , [&](const order_node<C>& l, const order_node<C>& r)
+                          {
+                            return l.identifier() == r.identifier()
+                               and pos(l.next()) == pos(r.next())
+                               and pos(l.nested()) == pos(r.nested());
+                          });
+  }
+
   /// @brief Create the concrete order using an order_builder.
   static
-  nodes_ptr_type
+  std::unique_ptr<nodes_type>
   mk_nodes_ptr(const order_builder<C>& builder)
   {
     if (builder.empty())
@@ -249,7 +552,7 @@ private:
       return nullptr;
     }
 
-    auto nodes_ptr = std::make_shared<nodes_type>(builder.size());
+    auto nodes_ptr = std::make_unique<nodes_type>(builder.size());
     auto& nodes = *nodes_ptr;
 
     // Ensure that identifiers appear only once.
@@ -283,7 +586,8 @@ private:
 
       if (not ob.next().empty())
       {
-        next = helper(ob.next(), path);
+        // A flat order may be longer than the stack can hold recursive calls.
+        next = util::deep_call([&]{return helper(ob.next(), path);});
       }
 
       const auto variable = next.second;
@@ -302,21 +606,11 @@ private:
     return nodes_ptr;
   }
 
-  /// @brief
-  const std::shared_ptr<id_to_node_type>
-  mk_identifier_to_node(const nodes_ptr_type& nodes_ptr)
-  {
-    auto identifier_to_node_ptr = std::make_shared<id_to_node_type>();
-    if (nodes_ptr)
-    {
-      identifier_to_node_ptr->reserve(nodes_ptr->size());
-      std::for_each( nodes_ptr->begin(), nodes_ptr_->end()
-                   , [&](auto&& n){identifier_to_node_ptr->emplace(n.identifier(), &n);});
-    }
-    return identifier_to_node_ptr;
-  }
 };
 
+template <typename C>
+constexpr std::size_t order<C>::registry::min_sweep_threshold;
+
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief Textual representation of an order.
@@ -365,7 +659,7 @@ struct hash<sdd::order<C>>
   const noexcept
   {
     using namespace sdd::hash;
-    return seed(o.nodes_ptr_.get()) (val(o.head_));
+    return seed(o.head_);
   }
 };
 
@@ -48,8 +48,8 @@ private:
 
     /// @brief The node's next variable.
     ///
-    /// If nullptr, this node is the last one.
-    const node_ptr next;
+    /// If nullptr, this node is the last one. It's only modified by the destructor.
+    node_ptr next;
 
     /// @brief Constructor.
     node(order_identifier<C> id, node_ptr nst, node_ptr nxt)
@@ -57,6 +57,19 @@ private:
       , nested{std::move(nst)}
       , next{std::move(nxt)}
     {}
+
+    /// @brief Destructor.
+    ///
+    /// The following nodes only owned by this one are released in a loop rather than recursively,
+    /// as a flat order may be longer than the stack can hold destructors.
+    ~node()
+    {
+      auto current = std::move(next);
+      while (current and current.use_count() == 1)
+      {
+        current = std::move(current->next);
+      }
+    }
   };
 
   /// @brief The concrete order.
@@ -228,17 +241,14 @@ private:
   node_size(std::size_t& acc, node_ptr ptr)
   noexcept
   {
-    if (ptr)
+    // Only nested orders are visited recursively, a flat order may be longer than the stack.
+    for (; ptr; ptr = ptr->next)
     {
       ++acc;
       if (ptr->nested)
       {
         node_size(acc, ptr->nested);
       }
-      if (ptr->next)
-      {
-        node_size(acc, ptr->next);
-      }
     }
   }
 
@@ -0,0 +1,196 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // sort, unique
+#include <cstdint>   // uint32_t
+#include <limits>
+#include <vector>
+
+#include "sdd/order/strategies/force_flat_hypergraph.hh"
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd { namespace force {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The graph obtained by linking all vertices which share an hyperedge.
+///
+/// Used by ordering strategies defined on graphs rather than on hypergraphs, such as bandwidth
+/// minimization. An hyperedge of n vertices yields n*(n-1) adjacencies, thus it's not meant for
+/// hypergraphs with huge hyperedges.
+template <typename C>
+class adjacency
+{
+public:
+
+  /// @brief The index of a vertex.
+  using index_type = std::uint32_t;
+
+  /// @brief Mark unreached vertices in breadth-first searches.
+  static constexpr index_type unreached = std::numeric_limits<index_type>::max();
+
+private:
+
+  /// @brief A compact copy of the hypergraph.
+  const flat_hypergraph<C> graph_;
+
+  /// @brief Where the neighbors of a vertex start in neighbors_.
+  std::vector<std::size_t> offsets_;
+
+  /// @brief The neighbors of all vertices, sorted by index.
+  std::vector<index_type> neighbors_;
+
+public:
+
+  /// @brief Constructor.
+  adjacency(const hypergraph<C>& g)
+    : graph_(g), offsets_(), neighbors_()
+  {
+    offsets_.reserve(graph_.nb_vertices() + 1);
+    std::vector<index_type> tmp;
+    for (index_type v = 0; v < graph_.nb_vertices(); ++v)
+    {
+      offsets_.push_back(neighbors_.size());
+      tmp.clear();
+      for (auto e = graph_.vertex_begin(v); e != graph_.vertex_end(v); ++e)
+      {
+        for (auto n = graph_.edge_begin(*e); n != graph_.edge_end(*e); ++n)
+        {
+          if (*n != v)
+          {
+            tmp.push_back(*n);
+          }
+        }
+      }
+      std::sort(tmp.begin(), tmp.end());
+      tmp.erase(std::unique(tmp.begin(), tmp.end()), tmp.end());
+      neighbors_.insert(neighbors_.end(), tmp.begin(), tmp.end());
+    }
+    offsets_.push_back(neighbors_.size());
+  }
+
+  /// @brief Get the number of vertices.
+  std::size_t
+  nb_vertices()
+  const noexcept
+  {
+    return graph_.nb_vertices();
+  }
+
+  /// @brief Get the identifier of a vertex.
+  const typename C::Identifier&
+  identifier(index_type v)
+  const noexcept
+  {
+    return graph_.identifier(v);
+  }
+
+  /// @brief Get the first neighbor of a vertex.
+  const index_type*
+  begin(index_type v)
+  const noexcept
+  {
+    return neighbors_.data() + offsets_[v];
+  }
+
+  /// @brief Get the end of the neighbors of a vertex.
+  const index_type*
+  end(index_type v)
+  const noexcept
+  {
+    return neighbors_.data() + offsets_[v + 1];
+  }
+
+  /// @brief Get the number of neighbors of a vertex.
+  std::size_t
+  degree(index_type v)
+  const noexcept
+  {
+    return offsets_[v + 1] - offsets_[v];
+  }
+
+  /// @brief Compute the distance of all vertices to a vertex.
+  /// @param distances Reached vertices get their distance, others are left untouched.
+  /// @return The reached vertices, in breadth-first order.
+  std::vector<index_type>
+  distances(index_type start, std::vector<index_type>& distances)
+  const
+  {
+    std::vector<index_type> queue{start};
+    distances[start] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+      const auto v = queue[head];
+      for (auto n = begin(v); n != end(v); ++n)
+      {
+        if (distances[*n] == unreached)
+        {
+          distances[*n] = distances[v] + 1;
+          queue.push_back(*n);
+        }
+      }
+    }
+    return queue;
+  }
+
+  /// @brief Find a pseudo-peripheral vertex in the connected component of a vertex.
+  /// @param scratch Distances of all vertices, all unreached before and after the call.
+  ///
+  /// Start from a vertex and jump to a vertex of the last level of minimal degree, as long as the
+  /// eccentricity grows (George and Liu).
+  index_type
+  pseudo_peripheral(index_type start, std::vector<index_type>& scratch)
+  const
+  {
+    auto reached = distances(start, scratch);
+    auto eccentricity = scratch[reached.back()];
+    while (true)
+    {
+      auto candidate = reached.back();
+      for ( auto rit = reached.rbegin()
+          ; rit != reached.rend() and scratch[*rit] == eccentricity; ++rit)
+      {
+        if (degree(*rit) < degree(candidate))
+        {
+          candidate = *rit;
+        }
+      }
+      reset(reached, scratch);
+      reached = distances(candidate, scratch);
+      const auto candidate_eccentricity = scratch[reached.back()];
+      if (candidate_eccentricity <= eccentricity)
+      {
+        reset(reached, scratch);
+        return start;
+      }
+      start = candidate;
+      eccentricity = candidate_eccentricity;
+    }
+  }
+
+  /// @brief Set the distances of some vertices back to unreached.
+  static
+  void
+  reset(const std::vector<index_type>& vertices, std::vector<index_type>& distances)
+  noexcept
+  {
+    for (const auto v : vertices)
+    {
+      distances[v] = unreached;
+    }
+  }
+};
+
+/// @brief Definition of the constant, needed when it's bound to a reference.
+template <typename C>
+constexpr typename adjacency<C>::index_type adjacency<C>::unreached;
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::force
@@ -6,12 +6,21 @@
 
 #pragma once
 
-#include <functional> // reference_wrapper
+#include <algorithm>  // max, min, minmax_element, shuffle, stable_sort
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>    // uint32_t
+#include <deque>
+#include <functional> // function
 #include <limits>
-#include <numeric>    // accumulate
+#include <mutex>
+#include <numeric>    // accumulate, iota
+#include <random>
+#include <thread>
 #include <vector>
 
 #include "sdd/order/order_builder.hh"
+#include "sdd/order/strategies/force_flat_hypergraph.hh"
 #include "sdd/order/strategies/force_hyperedge.hh"
 #include "sdd/order/strategies/force_hypergraph.hh"
 #include "sdd/order/strategies/force_vertex.hh"
@@ -20,9 +29,371 @@ namespace sdd { namespace force {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Parameters of the FORCE ordering strategy.
+struct options
+{
+  /// @brief The maximal number of iterations of a run.
+  unsigned int iterations = 200;
+
+  /// @brief The number of independent runs.
+  ///
+  /// The first run starts from the order of insertion of identifiers in the hypergraph, the
+  /// others start from random permutations. The order with the smallest span among all runs wins.
+  unsigned int runs = 1;
+
+  /// @brief The number of threads.
+  ///
+  /// Runs are distributed among threads. Remaining threads, if any, share the work of each
+  /// iteration of a run.
+  unsigned int threads = 1;
+
+  /// @brief Stop a run after this number of iterations without improvement of the span.
+  ///
+  /// 0 disables early stop. A run always stops when an iteration doesn't change the order, as
+  /// it's then a fixed point.
+  unsigned int patience = 20;
+
+  /// @brief The seed of the random permutations of runs.
+  std::uint32_t seed = 0;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Threads which share the work of the iterations of a run.
+///
+/// They are started once for the whole run and wait for work between two steps of an iteration,
+/// as starting threads at each step would cost more than the work itself on small hypergraphs.
+class thread_pool
+{
+  // Can't copy a thread_pool.
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+private:
+
+  /// @brief Don't split ranges smaller than this size.
+  static constexpr std::size_t min_chunk = 4096;
+
+  /// @brief Process a chunk of the current range, given its index.
+  std::function<void(std::size_t)> task_;
+
+  /// @brief The number of chunks of the current range, the first one is processed by the caller.
+  std::size_t nb_chunks_;
+
+  /// @brief Incremented each time a new range is submitted.
+  std::size_t generation_;
+
+  /// @brief The number of chunks of the current range not processed yet by the pool's threads.
+  std::size_t pending_;
+
+  /// @brief Ask the threads to stop.
+  bool stop_;
+
+  /// @brief Protect the state shared with the threads.
+  std::mutex mutex_;
+
+  /// @brief Wake up the threads when a range is submitted or when they should stop.
+  std::condition_variable start_cv_;
+
+  /// @brief Wake up the caller when all chunks have been processed.
+  std::condition_variable done_cv_;
+
+  /// @brief The threads, in addition to the caller's one.
+  std::vector<std::thread> threads_;
+
+public:
+
+  /// @brief Constructor.
+  ///
+  /// The caller's thread counts as one of the threads: a pool of 1 thread doesn't start any.
+  thread_pool(unsigned int threads)
+    : task_(), nb_chunks_(0), generation_(0), pending_(0), stop_(false), mutex_(), start_cv_()
+    , done_cv_(), threads_()
+  {
+    threads_.reserve(threads > 1 ? threads - 1 : 0);
+    for (std::size_t i = 1; i < threads; ++i)
+    {
+      threads_.emplace_back([this, i]{work(i);});
+    }
+  }
+
+  /// @brief Destructor.
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& t : threads_)
+    {
+      t.join();
+    }
+  }
+
+  /// @brief Get the number of threads, including the caller's one.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return threads_.size() + 1;
+  }
+
+  /// @brief Apply a function to [0, size) split into contiguous ranges handled by the threads.
+  ///
+  /// Small ranges are not split as waking threads up would cost more than the work itself.
+  template <typename Function>
+  void
+  parallel_for(std::size_t size, Function&& f)
+  {
+    const auto nb_chunks = std::max<std::size_t>(1, std::min(this->size(), size / min_chunk));
+    if (nb_chunks == 1)
+    {
+      f(0, size, 0);
+      return;
+    }
+    const auto chunk = (size + nb_chunks - 1) / nb_chunks;
+    const auto process = [&f, chunk, size](std::size_t i)
+    {
+      f(i * chunk, std::min(size, (i + 1) * chunk), i);
+    };
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = process;
+      nb_chunks_ = nb_chunks;
+      pending_ = nb_chunks - 1;
+      ++generation_;
+    }
+    start_cv_.notify_all();
+    process(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]{return pending_ == 0;});
+    // The task refers to the caller's stack.
+    task_ = nullptr;
+  }
+
+private:
+
+  /// @brief The loop of the i-th thread, which processes the i-th chunk of each range.
+  void
+  work(std::size_t i)
+  {
+    std::size_t seen = 0;
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_cv_.wait(lock, [&]{return stop_ or generation_ != seen;});
+        if (stop_)
+        {
+          return;
+        }
+        seen = generation_;
+        if (i >= nb_chunks_)
+        {
+          continue;
+        }
+      }
+      // The task is not modified until all its chunks are processed.
+      task_(i);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+      {
+        done_cv_.notify_one();
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief One run of FORCE, from an initial permutation of the vertices.
+template <typename C>
+class run
+{
+private:
+
+  using index_type = typename flat_hypergraph<C>::index_type;
+
+  /// @brief The shared hypergraph.
+  const flat_hypergraph<C>& graph_;
+
+  /// @brief Vertices sorted by location.
+  std::vector<index_type> sorted_;
+
+  /// @brief Locations, indexed by vertices.
+  std::vector<double> locations_;
+
+  /// @brief Centers of gravity, indexed by hyperedges.
+  std::vector<double> cogs_;
+
+  /// @brief The order with the smallest span.
+  std::vector<index_type> best_;
+
+  /// @brief The smallest span.
+  double best_span_;
+
+  /// @brief All computed total spans, one per iteration.
+  std::deque<double> spans_;
+
+public:
+
+  /// @brief Constructor.
+  run(const flat_hypergraph<C>& graph, std::vector<index_type>&& initial)
+    : graph_(graph), sorted_(std::move(initial)), locations_(graph.nb_vertices())
+    , cogs_(graph.nb_hyperedges()), best_(), best_span_(), spans_()
+  {
+    assign_locations();
+    best_ = sorted_;
+    thread_pool sequential(1);
+    best_span_ = total_span(sequential);
+  }
+
+  /// @brief Iterate until convergence or until the maximal number of iterations is reached.
+  void
+  operator()(const options& opt, unsigned int threads)
+  {
+    thread_pool pool(threads);
+    auto without_improvement = 0u;
+    auto previous = sorted_;
+    for (auto i = 0u; i < opt.iterations; ++i)
+    {
+      // Compute the new center of gravity for every hyperedge.
+      pool.parallel_for(cogs_.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (auto e = begin; e < end; ++e)
+        {
+          const auto first = graph_.edge_begin(e);
+          const auto last = graph_.edge_end(e);
+          auto acc = 0.0;
+          for (auto v = first; v != last; ++v)
+          {
+            acc += locations_[*v];
+          }
+          cogs_[e] = acc / (last - first);
+        }
+      });
+
+      // Compute the tentative new location of every vertex.
+      pool.parallel_for(locations_.size(), [&](std::size_t begin, std::size_t end, std::size_t)
+      {
+        for (auto v = begin; v < end; ++v)
+        {
+          const auto first = graph_.vertex_begin(v);
+          const auto last = graph_.vertex_end(v);
+          if (first == last)
+          {
+            continue;
+          }
+          auto acc = 0.0;
+          for (auto e = first; e != last; ++e)
+          {
+            acc += cogs_[*e] * graph_.weight(*e);
+          }
+          locations_[v] = acc / (last - first);
+        }
+      });
+
+      // Sort tentative vertex locations and assign integer indices to the vertices.
+      std::stable_sort( sorted_.begin(), sorted_.end()
+                      , [this](index_type lhs, index_type rhs)
+                          {return locations_[lhs] < locations_[rhs];});
+      assign_locations();
+
+      const auto span = total_span(pool);
+      spans_.push_back(span);
+      if (span < best_span_)
+      {
+        // We keep the order that minimizes the span.
+        best_span_ = span;
+        best_ = sorted_;
+        without_improvement = 0;
+      }
+      else if (opt.patience != 0 and ++without_improvement >= opt.patience)
+      {
+        break;
+      }
+
+      if (sorted_ == previous)
+      {
+        // A fixed point: next iterations would compute the same order.
+        break;
+      }
+      previous = sorted_;
+    }
+  }
+
+  /// @brief Get the order with the smallest span.
+  const std::vector<index_type>&
+  best()
+  const noexcept
+  {
+    return best_;
+  }
+
+  /// @brief Get the smallest span.
+  double
+  best_span()
+  const noexcept
+  {
+    return best_span_;
+  }
+
+  /// @brief Get all computed total spans.
+  const std::deque<double>&
+  spans()
+  const noexcept
+  {
+    return spans_;
+  }
+
+private:
+
+  /// @brief Set the location of each vertex to its rank.
+  void
+  assign_locations()
+  noexcept
+  {
+    for (std::size_t pos = 0; pos < sorted_.size(); ++pos)
+    {
+      locations_[sorted_[pos]] = pos;
+    }
+  }
+
+  /// @brief Add the span of all hyperedges.
+  double
+  total_span(thread_pool& pool)
+  const
+  {
+    std::vector<double> partial(pool.size(), 0);
+    pool.parallel_for(cogs_.size(), [&](std::size_t begin, std::size_t end, std::size_t chunk)
+    {
+      auto acc = 0.0;
+      for (auto e = begin; e < end; ++e)
+      {
+        const auto minmax
+          = std::minmax_element( graph_.edge_begin(e), graph_.edge_end(e)
+                               , [this](index_type lhs, index_type rhs)
+                                   {return locations_[lhs] < locations_[rhs];});
+        acc += locations_[*minmax.second] - locations_[*minmax.first];
+      }
+      partial[chunk] = acc;
+    });
+    return std::accumulate(partial.begin(), partial.end(), 0.0);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief An implementation of the FORCE ordering strategy
 /// @see http://dx.doi.org/10.1145/764808.764839
+///
+/// Several runs can be started concurrently from random permutations, and the work of each
+/// iteration can be split among threads. All runs share a read-only compact copy of the
+/// hypergraph.
 template <typename C>
 class worker
 {
@@ -30,16 +401,19 @@ private:
 
   using id_type = typename C::Identifier;
   using vertex_type = vertex<id_type>;
-  using hyperedge_type = hyperedge<id_type>;
+  using index_type = typename flat_hypergraph<C>::index_type;
 
-  /// @brief
+  /// @brief The hypergraph to order, its vertices get the location of the best order.
   std::deque<vertex_type>& vertices_;
 
-  /// @brief The hyperedges that link together vertices.
-  std::deque<hyperedge_type>& hyperedges_;
+  /// @brief A compact copy of the hypergraph.
+  const flat_hypergraph<C> graph_;
 
-  /// @brief Keep all computed total spans for statistics.
-  std::deque<double> spans_;
+  /// @brief Keep all computed total spans for statistics, indexed by runs.
+  std::vector<std::deque<double>> spans_;
+
+  /// @brief The run which found the order with the smallest span.
+  std::size_t best_run_;
 
   /// @brief Reverse order.
   bool reverse_;
@@ -48,95 +422,143 @@ public:
 
   /// @brief Constructor.
   worker(hypergraph<C>& graph, bool reverse = false)
-    : vertices_(graph.vertices()), hyperedges_(graph.hyperedges()), spans_(), reverse_(reverse)
+    : vertices_(graph.vertices()), graph_(graph), spans_(1), best_run_(0), reverse_(reverse)
   {}
 
-  /// @brief Effectively apply the FORCE ordering strategy.
+  /// @brief Effectively apply the FORCE ordering strategy, with a single run.
+  ///
+  /// All iterations are done, unless the order reaches a fixed point: there is no early stop
+  /// after iterations without improvement.
   order_builder<C>
   operator()(unsigned int iterations)
   {
-    auto sorted_vertices
-      = std::vector<std::reference_wrapper<vertex_type>>{vertices_.begin(), vertices_.end()};
+    options opt;
+    opt.iterations = iterations;
+    opt.patience = 0;
+    return (*this)(opt);
+  }
 
-    // Keep a copy of the order with the smallest span.
-    auto best_order = std::vector<std::reference_wrapper<vertex_type>>{sorted_vertices};
-    const auto smallest_span = std::numeric_limits<double>::max();
+  /// @brief Effectively apply the FORCE ordering strategy.
+  order_builder<C>
+  operator()(const options& opt)
+  {
+    const auto nb_runs = std::max(opt.runs, 1u);
+    const auto threads = std::max(opt.threads, 1u);
 
-    while (iterations-- != 0)
+    std::vector<run<C>> runs;
+    runs.reserve(nb_runs);
+    for (auto r = 0u; r < nb_runs; ++r)
     {
-      // Compute the new center of gravity for every hyperedge.
-      for (auto& edge : hyperedges_)
+      std::vector<index_type> initial(graph_.nb_vertices());
+      std::iota(initial.begin(), initial.end(), 0);
+      if (r != 0)
       {
-        edge.compute_center_of_gravity();
+        std::mt19937 gen(opt.seed + r);
+        std::shuffle(initial.begin(), initial.end(), gen);
       }
+      runs.emplace_back(graph_, std::move(initial));
+    }
 
-      // Compute the tentative new location of every vertex.
-      for (auto& vertex : vertices_)
-      {
-        if (vertex.hyperedges().empty())
-        {
-          continue;
-        }
-        vertex.location() = std::accumulate( vertex.hyperedges().cbegin()
-                                           , vertex.hyperedges().cend()
-                                           , 0
-                                           , [](double acc, const hyperedge_type* e)
-                                               {return acc + e->center_of_gravity() * e->weight();}
-                                           ) / vertex.hyperedges().size();
-      }
-
-      // Sort tentative vertex locations.
-      std::sort( sorted_vertices.begin(), sorted_vertices.end()
-               , [](vertex_type& lhs, vertex_type& rhs){return lhs.location() < rhs.location();});
-
-      // Assign integer indices to the vertices.
-      auto pos = 0ul;
-      std::for_each( sorted_vertices.begin(), sorted_vertices.end()
-                   , [&pos](vertex_type& v){v.location() = pos++;});
+    // Runs are distributed among threads, the remaining threads help within runs.
+    const auto concurrent_runs = std::min(nb_runs, threads);
+    const auto threads_per_run = threads / concurrent_runs;
+    parallel_for_runs(runs, concurrent_runs, [&](run<C>& r){r(opt, threads_per_run);});
 
-      const auto span = get_total_span();
-      spans_.push_back(span);
-      if (span < smallest_span)
+    spans_.clear();
+    best_run_ = 0;
+    for (std::size_t r = 0; r < runs.size(); ++r)
+    {
+      spans_.push_back(runs[r].spans());
+      if (runs[r].best_span() < runs[best_run_].best_span())
       {
-        // We keep the order that minimizes the span.
-        best_order = sorted_vertices;
+        best_run_ = r;
       }
     }
+    const auto& best_order = runs[best_run_].best();
+
+    // Report the locations of the best order into the hypergraph.
+    for (std::size_t pos = 0; pos < best_order.size(); ++pos)
+    {
+      vertices_[best_order[pos]].location() = pos;
+    }
 
     auto ob = order_builder<C>{};
     if (reverse_)
     {
       for (auto rcit = best_order.rbegin(); rcit != best_order.rend(); ++rcit)
       {
-        ob.push(rcit->get().id());
+        ob.push(graph_.identifier(*rcit));
       }
     }
     else
     {
-      for (const auto& vertex : best_order)
+      for (const auto v : best_order)
       {
-        ob.push(vertex.get().id());
+        ob.push(graph_.identifier(v));
       }
     }
     return ob;
   }
 
+  /// @brief Get all computed total spans of the run which found the best order.
   const std::deque<double>&
   spans()
   const noexcept
   {
-    return spans_;
+    return spans_[best_run_];
   }
 
-private:
+  /// @brief Get all computed total spans of a run.
+  const std::deque<double>&
+  spans(std::size_t run)
+  const noexcept
+  {
+    return spans_[run];
+  }
 
-  /// @brief Add the span of all hyperedges.
-  double
-  get_total_span()
+  /// @brief Get the number of runs of the last application.
+  std::size_t
+  nb_runs()
+  const noexcept
+  {
+    return spans_.size();
+  }
+
+  /// @brief Get the run which found the order with the smallest span.
+  std::size_t
+  best_run()
   const noexcept
   {
-    return std::accumulate( hyperedges_.cbegin(), hyperedges_.cend(), 0
-                          , [](double acc, const hyperedge_type& h){return acc + h.span();});
+    return best_run_;
+  }
+
+private:
+
+  /// @brief Execute runs on a pool of threads.
+  template <typename Function>
+  static
+  void
+  parallel_for_runs(std::vector<run<C>>& runs, unsigned int threads, Function&& f)
+  {
+    std::atomic<std::size_t> next(0);
+    const auto loop = [&]
+    {
+      for (auto r = next++; r < runs.size(); r = next++)
+      {
+        f(runs[r]);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (auto i = 1u; i < threads; ++i)
+    {
+      workers.emplace_back(loop);
+    }
+    loop();
+    for (auto& w : workers)
+    {
+      w.join();
+    }
   }
 };
 
@@ -0,0 +1,171 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <cstdint>       // uint32_t
+#include <unordered_map>
+#include <vector>
+
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd { namespace force {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A read-only and compact representation of an hypergraph.
+///
+/// Vertices and hyperedges are numbered contiguously, and adjacencies are stored in contiguous
+/// arrays indexed by offsets (compressed sparse rows), rather than scattered in deques of objects
+/// linked by pointers. It makes iterations of FORCE cache-friendly and easy to split among
+/// threads.
+template <typename C>
+class flat_hypergraph
+{
+public:
+
+  /// @brief The user identifier type.
+  using identifier_type = typename C::Identifier;
+
+  /// @brief The index of a vertex or of an hyperedge.
+  using index_type = std::uint32_t;
+
+private:
+
+  /// @brief Identifiers, indexed by vertices.
+  std::vector<identifier_type> identifiers_;
+
+  /// @brief Where the vertices of an hyperedge start in edge_vertices_.
+  std::vector<std::size_t> edge_offsets_;
+
+  /// @brief The vertices of all hyperedges.
+  std::vector<index_type> edge_vertices_;
+
+  /// @brief Weights, indexed by hyperedges.
+  std::vector<double> weights_;
+
+  /// @brief Where the hyperedges of a vertex start in vertex_edges_.
+  std::vector<std::size_t> vertex_offsets_;
+
+  /// @brief The hyperedges of all vertices.
+  std::vector<index_type> vertex_edges_;
+
+public:
+
+  /// @brief Constructor.
+  ///
+  /// Vertices keep their order of insertion in the hypergraph.
+  flat_hypergraph(const hypergraph<C>& graph)
+    : identifiers_(), edge_offsets_(), edge_vertices_(), weights_(), vertex_offsets_()
+    , vertex_edges_()
+  {
+    std::unordered_map<const void*, index_type> vertex_index;
+    vertex_index.reserve(graph.vertices().size());
+    identifiers_.reserve(graph.vertices().size());
+    for (const auto& v : graph.vertices())
+    {
+      vertex_index.emplace(&v, identifiers_.size());
+      identifiers_.push_back(v.id());
+    }
+
+    std::unordered_map<const void*, index_type> edge_index;
+    edge_index.reserve(graph.hyperedges().size());
+    edge_offsets_.reserve(graph.hyperedges().size() + 1);
+    weights_.reserve(graph.hyperedges().size());
+    for (const auto& e : graph.hyperedges())
+    {
+      edge_index.emplace(&e, weights_.size());
+      edge_offsets_.push_back(edge_vertices_.size());
+      weights_.push_back(e.weight());
+      for (const auto vertex_ptr : e.vertices())
+      {
+        edge_vertices_.push_back(vertex_index[vertex_ptr]);
+      }
+    }
+    edge_offsets_.push_back(edge_vertices_.size());
+
+    vertex_offsets_.reserve(identifiers_.size() + 1);
+    vertex_edges_.reserve(edge_vertices_.size());
+    for (const auto& v : graph.vertices())
+    {
+      vertex_offsets_.push_back(vertex_edges_.size());
+      for (const auto edge_ptr : v.hyperedges())
+      {
+        vertex_edges_.push_back(edge_index[edge_ptr]);
+      }
+    }
+    vertex_offsets_.push_back(vertex_edges_.size());
+  }
+
+  /// @brief Get the number of vertices.
+  std::size_t
+  nb_vertices()
+  const noexcept
+  {
+    return identifiers_.size();
+  }
+
+  /// @brief Get the number of hyperedges.
+  std::size_t
+  nb_hyperedges()
+  const noexcept
+  {
+    return weights_.size();
+  }
+
+  /// @brief Get the identifier of a vertex.
+  const identifier_type&
+  identifier(index_type v)
+  const noexcept
+  {
+    return identifiers_[v];
+  }
+
+  /// @brief Get the weight of an hyperedge.
+  double
+  weight(index_type e)
+  const noexcept
+  {
+    return weights_[e];
+  }
+
+  /// @brief Get the first vertex of an hyperedge.
+  const index_type*
+  edge_begin(index_type e)
+  const noexcept
+  {
+    return edge_vertices_.data() + edge_offsets_[e];
+  }
+
+  /// @brief Get the end of the vertices of an hyperedge.
+  const index_type*
+  edge_end(index_type e)
+  const noexcept
+  {
+    return edge_vertices_.data() + edge_offsets_[e + 1];
+  }
+
+  /// @brief Get the first hyperedge of a vertex.
+  const index_type*
+  vertex_begin(index_type v)
+  const noexcept
+  {
+    return vertex_edges_.data() + vertex_offsets_[v];
+  }
+
+  /// @brief Get the end of the hyperedges of a vertex.
+  const index_type*
+  vertex_end(index_type v)
+  const noexcept
+  {
+    return vertex_edges_.data() + vertex_offsets_[v + 1];
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::force
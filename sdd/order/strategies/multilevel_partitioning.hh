@@ -0,0 +1,608 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm>  // fill, max, min, shuffle, sort, unique
+#include <array>
+#include <cmath>      // ceil
+#include <cstdint>    // uint8_t, uint32_t
+#include <limits>
+#include <numeric>    // accumulate, iota, partial_sum
+#include <queue>      // priority_queue
+#include <random>
+#include <utility>    // pair
+#include <vector>
+
+#include "sdd/order/order_builder.hh"
+#include "sdd/order/strategies/force_flat_hypergraph.hh"
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd {
+
+namespace partitioning {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A weighted hypergraph, at some level of coarsening.
+///
+/// Vertices are weighted by the number of original vertices they stand for. Hyperedges with less
+/// than two pins are dropped as they can't be cut.
+struct graph
+{
+  using index_type = std::uint32_t;
+
+  /// @brief Weights, indexed by vertices.
+  std::vector<unsigned int> vertex_weights;
+
+  /// @brief Where the pins of an hyperedge start in pins.
+  std::vector<std::size_t> edge_offsets;
+
+  /// @brief The pins of all hyperedges.
+  std::vector<index_type> pins;
+
+  /// @brief Weights, indexed by hyperedges.
+  std::vector<double> edge_weights;
+
+  /// @brief Where the hyperedges of a vertex start in incidences.
+  std::vector<std::size_t> vertex_offsets;
+
+  /// @brief The hyperedges of all vertices.
+  std::vector<index_type> incidences;
+
+  /// @brief Constructor.
+  graph(std::vector<unsigned int>&& weights)
+    : vertex_weights(std::move(weights)), edge_offsets(1, 0), pins(), edge_weights()
+    , vertex_offsets(), incidences()
+  {}
+
+  std::size_t nb_vertices() const noexcept {return vertex_weights.size();}
+  std::size_t nb_edges()    const noexcept {return edge_weights.size();}
+
+  const index_type* pins_begin(index_type e)  const noexcept {return pins.data() + edge_offsets[e];}
+  const index_type* pins_end(index_type e)    const noexcept {return pins_begin(e + 1);}
+
+  const index_type*
+  edges_begin(index_type v)
+  const noexcept
+  {
+    return incidences.data() + vertex_offsets[v];
+  }
+
+  const index_type*
+  edges_end(index_type v)
+  const noexcept
+  {
+    return edges_begin(v + 1);
+  }
+
+  /// @brief Add an hyperedge, duplicate pins are removed.
+  void
+  add_edge(std::vector<index_type>& edge_pins, double weight)
+  {
+    std::sort(edge_pins.begin(), edge_pins.end());
+    edge_pins.erase(std::unique(edge_pins.begin(), edge_pins.end()), edge_pins.end());
+    if (edge_pins.size() < 2)
+    {
+      return;
+    }
+    pins.insert(pins.end(), edge_pins.begin(), edge_pins.end());
+    edge_offsets.push_back(pins.size());
+    edge_weights.push_back(weight);
+  }
+
+  /// @brief Compute the hyperedges of each vertex, once all hyperedges have been added.
+  void
+  finalize()
+  {
+    std::vector<std::size_t> degrees(nb_vertices() + 1, 0);
+    for (const auto p : pins)
+    {
+      degrees[p + 1] += 1;
+    }
+    std::partial_sum(degrees.begin(), degrees.end(), degrees.begin());
+    vertex_offsets = degrees;
+    incidences.resize(pins.size());
+    for (index_type e = 0; e < nb_edges(); ++e)
+    {
+      for (auto p = pins_begin(e); p != pins_end(e); ++p)
+      {
+        incidences[degrees[*p]++] = e;
+      }
+    }
+  }
+
+  /// @brief The sum of the weights of all vertices.
+  unsigned int
+  total_weight()
+  const noexcept
+  {
+    return std::accumulate(vertex_weights.begin(), vertex_weights.end(), 0u);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Cluster pairs of strongly connected vertices.
+/// @return The coarser graph and the cluster of each vertex of the finer graph.
+///
+/// The rating of two vertices is the sum, over their common hyperedges e, of w(e)/(|e|-1): it
+/// favors heavy and small hyperedges.
+template <typename Random>
+std::pair<graph, std::vector<graph::index_type>>
+coarsen(const graph& g, unsigned int max_cluster_weight, Random& rnd)
+{
+  using index_type = graph::index_type;
+  static constexpr index_type unmatched = std::numeric_limits<index_type>::max();
+
+  std::vector<index_type> visit(g.nb_vertices());
+  std::iota(visit.begin(), visit.end(), 0);
+  std::shuffle(visit.begin(), visit.end(), rnd);
+
+  std::vector<index_type> cluster(g.nb_vertices(), unmatched);
+  std::vector<unsigned int> weights;
+  std::vector<double> rating(g.nb_vertices(), 0);
+  std::vector<index_type> touched;
+  for (const auto u : visit)
+  {
+    if (cluster[u] != unmatched)
+    {
+      continue;
+    }
+    touched.clear();
+    for (auto e = g.edges_begin(u); e != g.edges_end(u); ++e)
+    {
+      const auto size = g.pins_end(*e) - g.pins_begin(*e);
+      const auto score = g.edge_weights[*e] / (size - 1);
+      for (auto v = g.pins_begin(*e); v != g.pins_end(*e); ++v)
+      {
+        if (*v != u and cluster[*v] == unmatched
+            and g.vertex_weights[u] + g.vertex_weights[*v] <= max_cluster_weight)
+        {
+          if (rating[*v] == 0)
+          {
+            touched.push_back(*v);
+          }
+          rating[*v] += score;
+        }
+      }
+    }
+    auto best = unmatched;
+    auto best_rating = 0.0;
+    for (const auto v : touched)
+    {
+      if (rating[v] > best_rating)
+      {
+        best = v;
+        best_rating = rating[v];
+      }
+      rating[v] = 0;
+    }
+    cluster[u] = weights.size();
+    weights.push_back(g.vertex_weights[u]);
+    if (best != unmatched)
+    {
+      cluster[best] = cluster[u];
+      weights.back() += g.vertex_weights[best];
+    }
+  }
+
+  graph coarse(std::move(weights));
+  std::vector<index_type> edge_pins;
+  for (index_type e = 0; e < g.nb_edges(); ++e)
+  {
+    edge_pins.clear();
+    for (auto v = g.pins_begin(e); v != g.pins_end(e); ++v)
+    {
+      edge_pins.push_back(cluster[*v]);
+    }
+    coarse.add_edge(edge_pins, g.edge_weights[e]);
+  }
+  coarse.finalize();
+  return std::make_pair(std::move(coarse), std::move(cluster));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Improve a bisection with passes of Fiduccia-Mattheyses.
+///
+/// Each pass moves every vertex at most once, always choosing the move with the best gain which
+/// respects the balance, then rolls back to the best cut seen during the pass.
+/// @return The cut of the refined bisection.
+inline
+double
+refine( const graph& g, std::vector<std::uint8_t>& part, unsigned int max_weight
+      , unsigned int max_passes)
+{
+  using index_type = graph::index_type;
+
+  std::vector<std::array<unsigned int, 2>> counts(g.nb_edges(), {{0, 0}});
+  unsigned int weights[2] = {0, 0};
+  for (index_type v = 0; v < g.nb_vertices(); ++v)
+  {
+    weights[part[v]] += g.vertex_weights[v];
+    for (auto e = g.edges_begin(v); e != g.edges_end(v); ++e)
+    {
+      counts[*e][part[v]] += 1;
+    }
+  }
+  double cut = 0;
+  for (index_type e = 0; e < g.nb_edges(); ++e)
+  {
+    if (counts[e][0] != 0 and counts[e][1] != 0)
+    {
+      cut += g.edge_weights[e];
+    }
+  }
+
+  const auto gain = [&](index_type v)
+  {
+    const auto from = part[v];
+    auto res = 0.0;
+    for (auto e = g.edges_begin(v); e != g.edges_end(v); ++e)
+    {
+      if (counts[*e][from] == 1)
+      {
+        res += g.edge_weights[*e];
+      }
+      else if (counts[*e][1 - from] == 0)
+      {
+        res -= g.edge_weights[*e];
+      }
+    }
+    return res;
+  };
+  const auto move = [&](index_type v)
+  {
+    const auto from = part[v];
+    cut -= gain(v);
+    part[v] = 1 - from;
+    weights[from] -= g.vertex_weights[v];
+    weights[1 - from] += g.vertex_weights[v];
+    for (auto e = g.edges_begin(v); e != g.edges_end(v); ++e)
+    {
+      counts[*e][from] -= 1;
+      counts[*e][1 - from] += 1;
+    }
+  };
+  const auto balanced = [&]{return weights[0] <= max_weight and weights[1] <= max_weight;};
+
+  std::vector<double> gains(g.nb_vertices());
+  std::vector<bool> locked(g.nb_vertices());
+  std::vector<index_type> moves;
+  for (auto pass = 0u; pass < max_passes; ++pass)
+  {
+    std::priority_queue<std::pair<double, index_type>> queue;
+    for (index_type v = 0; v < g.nb_vertices(); ++v)
+    {
+      gains[v] = gain(v);
+      locked[v] = false;
+      queue.emplace(gains[v], v);
+    }
+    moves.clear();
+    const auto initial_cut = cut;
+    auto best_cut = balanced() ? cut : std::numeric_limits<double>::max();
+    auto best_prefix = 0ul;
+    const auto max_useless_moves = std::max<std::size_t>(50, g.nb_vertices() / 8);
+    while (not queue.empty() and moves.size() - best_prefix < max_useless_moves)
+    {
+      const auto top = queue.top();
+      queue.pop();
+      const auto v = top.second;
+      if (locked[v] or top.first != gains[v])
+      {
+        continue;
+      }
+      const auto from = part[v];
+      if (weights[1 - from] + g.vertex_weights[v] > max_weight and weights[from] <= max_weight)
+      {
+        continue;
+      }
+      move(v);
+      locked[v] = true;
+      moves.push_back(v);
+      if (balanced() and cut < best_cut)
+      {
+        best_cut = cut;
+        best_prefix = moves.size();
+      }
+      for (auto e = g.edges_begin(v); e != g.edges_end(v); ++e)
+      {
+        for (auto n = g.pins_begin(*e); n != g.pins_end(*e); ++n)
+        {
+          if (not locked[*n])
+          {
+            const auto new_gain = gain(*n);
+            if (new_gain != gains[*n])
+            {
+              gains[*n] = new_gain;
+              queue.emplace(new_gain, *n);
+            }
+          }
+        }
+      }
+    }
+    // Roll back to the best cut.
+    while (moves.size() > best_prefix)
+    {
+      move(moves.back());
+      moves.pop_back();
+    }
+    if (cut >= initial_cut)
+    {
+      break;
+    }
+  }
+  return cut;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Bisect the coarsest graph by growing a region from several random vertices.
+template <typename Random>
+std::vector<std::uint8_t>
+initial_bisection(const graph& g, unsigned int max_weight, Random& rnd)
+{
+  using index_type = graph::index_type;
+  static constexpr unsigned int tries = 8;
+
+  const auto target = g.total_weight() / 2;
+  std::vector<std::uint8_t> best;
+  auto best_cut = std::numeric_limits<double>::max();
+  std::vector<std::uint8_t> part(g.nb_vertices());
+  std::vector<index_type> queue;
+  std::uniform_int_distribution<index_type> pick(0, g.nb_vertices() - 1);
+  for (auto t = 0u; t < tries; ++t)
+  {
+    // Grow part 0 in breadth-first order, part 1 is what remains.
+    std::fill(part.begin(), part.end(), 1);
+    auto weight = 0u;
+    queue.clear();
+    auto head = 0ul;
+    while (weight < target)
+    {
+      if (head == queue.size())
+      {
+        // Start from a new random vertex, the graph may be disconnected.
+        auto seed = pick(rnd);
+        while (part[seed] == 0)
+        {
+          seed = (seed + 1) % g.nb_vertices();
+        }
+        part[seed] = 0;
+        weight += g.vertex_weights[seed];
+        queue.push_back(seed);
+        continue;
+      }
+      const auto v = queue[head++];
+      for (auto e = g.edges_begin(v); e != g.edges_end(v) and weight < target; ++e)
+      {
+        for (auto n = g.pins_begin(*e); n != g.pins_end(*e) and weight < target; ++n)
+        {
+          if (part[*n] == 1)
+          {
+            part[*n] = 0;
+            weight += g.vertex_weights[*n];
+            queue.push_back(*n);
+          }
+        }
+      }
+    }
+    const auto cut = refine(g, part, max_weight, 4);
+    if (cut < best_cut)
+    {
+      best_cut = cut;
+      best = part;
+    }
+  }
+  return best;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Multilevel bisection: coarsen, bisect the coarsest graph, then uncoarsen and refine.
+template <typename Random>
+std::vector<std::uint8_t>
+bisect(const graph& g, double imbalance, Random& rnd)
+{
+  static constexpr std::size_t coarsest = 64;
+
+  const auto total = g.total_weight();
+  const auto max_weight
+    = static_cast<unsigned int>(std::ceil((1 + imbalance) * std::ceil(total / 2.0)));
+  const auto max_cluster_weight = std::max(1u, total / 32);
+
+  // Coarsening phase.
+  std::vector<graph> levels;
+  std::vector<std::vector<graph::index_type>> clusters;
+  const graph* current = &g;
+  while (current->nb_vertices() > coarsest)
+  {
+    auto coarse = coarsen(*current, max_cluster_weight, rnd);
+    if (coarse.first.nb_vertices() > 0.9 * current->nb_vertices())
+    {
+      // Not worth it.
+      break;
+    }
+    levels.push_back(std::move(coarse.first));
+    clusters.push_back(std::move(coarse.second));
+    current = &levels.back();
+  }
+
+  // Initial partitioning phase.
+  auto part = initial_bisection(*current, max_weight, rnd);
+
+  // Uncoarsening phase.
+  while (not levels.empty())
+  {
+    levels.pop_back();
+    const auto& finer = levels.empty() ? g : levels.back();
+    std::vector<std::uint8_t> finer_part(finer.nb_vertices());
+    for (std::size_t v = 0; v < finer_part.size(); ++v)
+    {
+      finer_part[v] = part[clusters.back()[v]];
+    }
+    clusters.pop_back();
+    part = std::move(finer_part);
+    refine(finer, part, max_weight, 4);
+  }
+  return part;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace partitioning
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Build an hierarchical order which follows a recursive partitioning of an hypergraph.
+///
+/// Identifiers are recursively split in two parts which share as few hyperedges as possible, using
+/// a multilevel bisection (coarsening, initial bisection, uncoarsening with Fiduccia-Mattheyses
+/// refinement). Each part becomes an hierarchical level of an artificial identifier, until parts
+/// have at most leaf_size identifiers. Thus, tightly coupled identifiers end under the same
+/// hierarchical node. Within a part, identifiers keep their order of insertion in the hypergraph.
+template <typename C>
+class multilevel_partitioning
+{
+private:
+
+  using identifier_type = typename C::Identifier;
+  using index_type = partitioning::graph::index_type;
+
+  /// @brief Mark vertices which don't belong to the partitioned set.
+  static constexpr index_type absent = std::numeric_limits<index_type>::max();
+
+  /// @brief A compact copy of the hypergraph.
+  const force::flat_hypergraph<C> graph_;
+
+  /// @brief The maximal number of identifiers in a leaf of the partition tree.
+  const unsigned int leaf_size_;
+
+  /// @brief The tolerated imbalance between the weights of two parts.
+  const double imbalance_;
+
+  /// @brief The seed of the random generator.
+  const std::uint32_t seed_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param leaf_size The maximal number of identifiers per hierarchical level.
+  /// @param imbalance A part may be (1 + imbalance) times larger than the half of its parent.
+  multilevel_partitioning( const force::hypergraph<C>& graph, unsigned int leaf_size
+                         , double imbalance = 0.1, std::uint32_t seed = 0)
+    : graph_(graph), leaf_size_(std::max(leaf_size, 1u)), imbalance_(imbalance), seed_(seed)
+  {}
+
+  /// @brief Compute the hierarchical order.
+  order_builder<C>
+  operator()()
+  const
+  {
+    std::vector<index_type> all(graph_.nb_vertices());
+    std::iota(all.begin(), all.end(), 0);
+    std::mt19937 rnd(seed_);
+    std::vector<index_type> local(graph_.nb_vertices(), absent);
+    std::vector<bool> edge_seen(graph_.nb_hyperedges());
+    return build(all, rnd, local, edge_seen);
+  }
+
+private:
+
+  /// @brief Recursively partition a set of vertices, sorted by index.
+  order_builder<C>
+  build( const std::vector<index_type>& vertices, std::mt19937& rnd
+       , std::vector<index_type>& local, std::vector<bool>& edge_seen)
+  const
+  {
+    if (vertices.size() <= leaf_size_)
+    {
+      order_builder<C> ob;
+      for (auto rcit = vertices.rbegin(); rcit != vertices.rend(); ++rcit)
+      {
+        ob.push(graph_.identifier(*rcit));
+      }
+      return ob;
+    }
+
+    // Extract the sub-hypergraph induced by vertices.
+    partitioning::graph g(std::vector<unsigned int>(vertices.size(), 1));
+    for (index_type i = 0; i < vertices.size(); ++i)
+    {
+      local[vertices[i]] = i;
+    }
+    std::vector<index_type> seen_edges;
+    std::vector<index_type> edge_pins;
+    for (const auto v : vertices)
+    {
+      for (auto e = graph_.vertex_begin(v); e != graph_.vertex_end(v); ++e)
+      {
+        if (edge_seen[*e])
+        {
+          continue;
+        }
+        edge_seen[*e] = true;
+        seen_edges.push_back(*e);
+        edge_pins.clear();
+        for (auto p = graph_.edge_begin(*e); p != graph_.edge_end(*e); ++p)
+        {
+          if (local[*p] != absent)
+          {
+            edge_pins.push_back(local[*p]);
+          }
+        }
+        g.add_edge(edge_pins, graph_.weight(*e));
+      }
+    }
+    for (const auto e : seen_edges)
+    {
+      edge_seen[e] = false;
+    }
+    g.finalize();
+
+    auto part = partitioning::bisect(g, imbalance_, rnd);
+    for (const auto v : vertices)
+    {
+      local[v] = absent;
+    }
+
+    std::vector<index_type> parts[2];
+    for (index_type i = 0; i < vertices.size(); ++i)
+    {
+      parts[static_cast<int>(part[i])].push_back(vertices[i]);
+    }
+    if (parts[0].empty() or parts[1].empty())
+    {
+      // Can't do better than splitting in the middle.
+      parts[0].assign(vertices.begin(), vertices.begin() + vertices.size() / 2);
+      parts[1].assign(vertices.begin() + vertices.size() / 2, vertices.end());
+    }
+    // The part with the first identifier in the hypergraph goes first.
+    if (parts[1].front() < parts[0].front())
+    {
+      std::swap(parts[0], parts[1]);
+    }
+
+    order_builder<C> ob;
+    ob.push(order_identifier<C>(), build(parts[1], rnd, local, edge_seen));
+    ob.push(order_identifier<C>(), build(parts[0], rnd, local, edge_seen));
+    return ob;
+  }
+};
+
+/// @brief Definition of the constant, needed when it's bound to a reference.
+template <typename C>
+constexpr typename multilevel_partitioning<C>::index_type multilevel_partitioning<C>::absent;
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
@@ -0,0 +1,94 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // sort
+#include <vector>
+
+#include "sdd/order/order_builder.hh"
+#include "sdd/order/strategies/adjacency.hh"
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Order identifiers with the reverse Cuthill-McKee algorithm.
+///
+/// Identifiers are linked when they share an hyperedge. Each connected component is traversed in
+/// breadth-first numbering from a pseudo-peripheral identifier, visiting neighbors by increasing
+/// degree; the resulting numbering is then reversed. It reduces the bandwidth, i.e. the maximal
+/// distance between linked identifiers.
+template <typename C>
+class reverse_cuthill_mckee
+{
+private:
+
+  using index_type = typename force::adjacency<C>::index_type;
+
+  /// @brief The graph of identifiers.
+  const force::adjacency<C> graph_;
+
+public:
+
+  /// @brief Constructor.
+  reverse_cuthill_mckee(const force::hypergraph<C>& g)
+    : graph_(g)
+  {}
+
+  /// @brief Compute the numbering.
+  order_builder<C>
+  operator()()
+  const
+  {
+    std::vector<index_type> numbering;
+    numbering.reserve(graph_.nb_vertices());
+    std::vector<bool> visited(graph_.nb_vertices(), false);
+    std::vector<index_type> neighbors;
+    std::vector<index_type> scratch(graph_.nb_vertices(), force::adjacency<C>::unreached);
+    for (index_type root = 0; root < graph_.nb_vertices(); ++root)
+    {
+      if (visited[root])
+      {
+        continue;
+      }
+      const auto start = graph_.pseudo_peripheral(root, scratch);
+      visited[start] = true;
+      auto head = numbering.size();
+      numbering.push_back(start);
+      for (; head < numbering.size(); ++head)
+      {
+        const auto v = numbering[head];
+        neighbors.clear();
+        for (auto n = graph_.begin(v); n != graph_.end(v); ++n)
+        {
+          if (not visited[*n])
+          {
+            visited[*n] = true;
+            neighbors.push_back(*n);
+          }
+        }
+        std::stable_sort( neighbors.begin(), neighbors.end()
+                        , [this](index_type lhs, index_type rhs)
+                            {return graph_.degree(lhs) < graph_.degree(rhs);});
+        numbering.insert(numbering.end(), neighbors.begin(), neighbors.end());
+      }
+    }
+
+    // Pushing reverses the order: the last visited identifier goes on top.
+    order_builder<C> ob;
+    for (const auto v : numbering)
+    {
+      ob.push(graph_.identifier(v));
+    }
+    return ob;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
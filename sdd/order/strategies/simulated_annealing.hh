@@ -0,0 +1,209 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // max, min, minmax_element
+#include <cmath>     // exp, log
+#include <cstdint>   // uint32_t
+#include <numeric>   // iota
+#include <random>
+#include <vector>
+
+#include "sdd/order/order_builder.hh"
+#include "sdd/order/strategies/force_flat_hypergraph.hh"
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Minimize the total span of hyperedges by simulated annealing.
+///
+/// The span of an hyperedge is the distance between its first and its last identifiers in the
+/// order, like for FORCE. A move swaps two identifiers; it's always accepted when it doesn't
+/// increase the total span, and with a probability which decreases with the temperature
+/// otherwise. The search starts from the order of insertion of identifiers in the hypergraph, thus
+/// it can refine the result of another strategy.
+template <typename C>
+class simulated_annealing
+{
+private:
+
+  using index_type = typename force::flat_hypergraph<C>::index_type;
+
+  /// @brief A compact copy of the hypergraph.
+  const force::flat_hypergraph<C> graph_;
+
+  /// @brief The number of tried moves, per identifier.
+  const unsigned int moves_per_identifier_;
+
+  /// @brief The temperature is multiplied by this factor after each round of moves.
+  const double cooling_;
+
+  /// @brief The seed of the random generator.
+  const std::uint32_t seed_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param moves_per_identifier Bound the search to this number of moves per identifier.
+  /// @param cooling The temperature decreases by this factor after each round of as many moves as
+  /// there are identifiers.
+  simulated_annealing( const force::hypergraph<C>& g, unsigned int moves_per_identifier = 100
+                     , double cooling = 0.95, std::uint32_t seed = 0)
+    : graph_(g), moves_per_identifier_(moves_per_identifier), cooling_(cooling), seed_(seed)
+  {}
+
+  /// @brief Compute the order.
+  order_builder<C>
+  operator()()
+  const
+  {
+    const auto n = graph_.nb_vertices();
+    std::vector<index_type> at(n);          // identifiers, indexed by positions
+    std::iota(at.begin(), at.end(), 0);
+    std::vector<index_type> position(at);   // positions, indexed by identifiers
+
+    if (n > 1)
+    {
+      anneal(at, position);
+    }
+
+    order_builder<C> ob;
+    for (auto rit = at.rbegin(); rit != at.rend(); ++rit)
+    {
+      ob.push(graph_.identifier(*rit));
+    }
+    return ob;
+  }
+
+private:
+
+  /// @brief Compute the span of an hyperedge.
+  long
+  span(index_type e, const std::vector<index_type>& position)
+  const noexcept
+  {
+    const auto minmax = std::minmax_element( graph_.edge_begin(e), graph_.edge_end(e)
+                                           , [&](index_type lhs, index_type rhs)
+                                               {return position[lhs] < position[rhs];});
+    return static_cast<long>(position[*minmax.second]) - position[*minmax.first];
+  }
+
+  /// @brief Search an order, starting from the given one.
+  void
+  anneal(std::vector<index_type>& at, std::vector<index_type>& position)
+  const
+  {
+    const auto n = at.size();
+    std::mt19937 rnd(seed_);
+    std::uniform_int_distribution<index_type> pick(0, n - 1);
+    std::uniform_real_distribution<double> coin(0, 1);
+
+    // Hyperedges touched by a move, marked to count them once.
+    std::vector<bool> marked(graph_.nb_hyperedges(), false);
+    std::vector<index_type> touched;
+    const auto touch = [&](index_type v)
+    {
+      for (auto e = graph_.vertex_begin(v); e != graph_.vertex_end(v); ++e)
+      {
+        if (not marked[*e])
+        {
+          marked[*e] = true;
+          touched.push_back(*e);
+        }
+      }
+    };
+    const auto swap = [&](index_type u, index_type v)
+    {
+      std::swap(at[position[u]], at[position[v]]);
+      std::swap(position[u], position[v]);
+    };
+    // Try to swap two identifiers, return the variation of the total span.
+    const auto delta = [&](index_type u, index_type v)
+    {
+      touched.clear();
+      touch(u);
+      touch(v);
+      long before = 0;
+      for (const auto e : touched)
+      {
+        before += span(e, position);
+      }
+      swap(u, v);
+      long after = 0;
+      for (const auto e : touched)
+      {
+        after += span(e, position);
+        marked[e] = false;
+      }
+      return after - before;
+    };
+
+    long cost = 0;
+    for (index_type e = 0; e < graph_.nb_hyperedges(); ++e)
+    {
+      cost += span(e, position);
+    }
+    auto best_cost = cost;
+    auto best = at;
+
+    // The initial temperature accepts an average degradation with a probability of 1/2.
+    double temperature = 0;
+    {
+      long sum = 0;
+      unsigned int nb = 0;
+      for (auto i = 0u; i < std::min<std::size_t>(n, 100); ++i)
+      {
+        const auto u = pick(rnd);
+        const auto v = pick(rnd);
+        const auto d = delta(u, v);
+        swap(u, v);
+        if (d > 0)
+        {
+          sum += d;
+          nb += 1;
+        }
+      }
+      temperature = nb == 0 ? 1 : (static_cast<double>(sum) / nb) / std::log(2.0);
+    }
+
+    for (auto round = 0u; round < moves_per_identifier_; ++round)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        const auto u = pick(rnd);
+        const auto v = pick(rnd);
+        if (u == v)
+        {
+          continue;
+        }
+        const auto d = delta(u, v);
+        if (d <= 0 or coin(rnd) < std::exp(-d / temperature))
+        {
+          cost += d;
+        }
+        else
+        {
+          swap(u, v);
+        }
+      }
+      // Only check at the end of a round, to avoid copying the order at each improvement.
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best = at;
+      }
+      temperature *= cooling_;
+    }
+    at = std::move(best);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
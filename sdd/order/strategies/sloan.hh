@@ -0,0 +1,160 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <queue>   // priority_queue
+#include <utility> // pair
+#include <vector>
+
+#include "sdd/order/order_builder.hh"
+#include "sdd/order/strategies/adjacency.hh"
+#include "sdd/order/strategies/force_hypergraph.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Order identifiers with the algorithm of Sloan.
+/// @see http://dx.doi.org/10.1002/nme.1620230208
+///
+/// Identifiers are linked when they share an hyperedge. Each connected component is numbered from
+/// a pseudo-peripheral identifier towards the end of its longest path. The next identifier is the
+/// one with the highest priority, which balances the distance to the end (global) against the
+/// number of identifiers that numbering it would activate (local). It reduces the profile and the
+/// wavefront, i.e. the number of identifiers linked to both numbered and unnumbered ones.
+template <typename C>
+class sloan
+{
+private:
+
+  using index_type = typename force::adjacency<C>::index_type;
+
+  /// @brief The graph of identifiers.
+  const force::adjacency<C> graph_;
+
+  /// @brief The weight of the distance to the end.
+  const int global_weight_;
+
+  /// @brief The weight of the degree.
+  const int local_weight_;
+
+  /// @brief The status of a vertex.
+  enum class status {inactive, preactive, active, postactive};
+
+public:
+
+  /// @brief Constructor.
+  /// @param global_weight The weight of the distance to the end of a component.
+  /// @param local_weight The weight of the degree of an identifier.
+  sloan(const force::hypergraph<C>& g, int global_weight = 1, int local_weight = 2)
+    : graph_(g), global_weight_(global_weight), local_weight_(local_weight)
+  {}
+
+  /// @brief Compute the order.
+  order_builder<C>
+  operator()()
+  const
+  {
+    constexpr auto unreached = force::adjacency<C>::unreached;
+    std::vector<index_type> numbering;
+    numbering.reserve(graph_.nb_vertices());
+    std::vector<status> statuses(graph_.nb_vertices(), status::inactive);
+    std::vector<long> priorities(graph_.nb_vertices(), 0);
+    std::vector<index_type> distances(graph_.nb_vertices(), unreached);
+    std::vector<index_type> scratch(graph_.nb_vertices(), unreached);
+
+    for (index_type root = 0; root < graph_.nb_vertices(); ++root)
+    {
+      if (statuses[root] != status::inactive)
+      {
+        continue;
+      }
+
+      // The start and the end of a longest path of the component.
+      const auto start = graph_.pseudo_peripheral(root, scratch);
+      const auto from_start = graph_.distances(start, scratch);
+      const auto end = from_start.back();
+      graph_.reset(from_start, scratch);
+      const auto component = graph_.distances(end, distances);
+      for (const auto v : component)
+      {
+        priorities[v] = global_weight_ * static_cast<long>(distances[v])
+                      - local_weight_ * static_cast<long>(graph_.degree(v) + 1);
+      }
+
+      std::priority_queue<std::pair<long, index_type>> queue;
+      const auto increase = [&](index_type v)
+      {
+        priorities[v] += local_weight_;
+        queue.emplace(priorities[v], v);
+      };
+
+      statuses[start] = status::preactive;
+      queue.emplace(priorities[start], start);
+      while (not queue.empty())
+      {
+        const auto top = queue.top();
+        queue.pop();
+        const auto v = top.second;
+        if (statuses[v] == status::postactive or top.first != priorities[v])
+        {
+          continue;
+        }
+        if (statuses[v] == status::preactive)
+        {
+          for (auto n = graph_.begin(v); n != graph_.end(v); ++n)
+          {
+            if (statuses[*n] == status::postactive)
+            {
+              continue;
+            }
+            if (statuses[*n] == status::inactive)
+            {
+              statuses[*n] = status::preactive;
+            }
+            increase(*n);
+          }
+        }
+        statuses[v] = status::postactive;
+        numbering.push_back(v);
+        for (auto n = graph_.begin(v); n != graph_.end(v); ++n)
+        {
+          if (statuses[*n] != status::preactive)
+          {
+            continue;
+          }
+          statuses[*n] = status::active;
+          increase(*n);
+          for (auto m = graph_.begin(*n); m != graph_.end(*n); ++m)
+          {
+            if (statuses[*m] == status::postactive)
+            {
+              continue;
+            }
+            if (statuses[*m] == status::inactive)
+            {
+              statuses[*m] = status::preactive;
+            }
+            increase(*m);
+          }
+        }
+      }
+    }
+
+    // The first numbered identifier goes on top.
+    order_builder<C> ob;
+    for (auto rit = numbering.rbegin(); rit != numbering.rend(); ++rit)
+    {
+      ob.push(graph_.identifier(*rit));
+    }
+    return ob;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
@@ -7,10 +7,10 @@
 #pragma once
 
 #include <map>
-#include <unordered_set>
 #include <utility> // pair
 
 #include "sdd/dd/definition.hh"
+#include "sdd/tools/visited.hh"
 
 namespace sdd { namespace tools {
 
@@ -29,49 +29,49 @@ struct arcs_visitor
 {
   /// @brief A cache is necessary to to know if a node has already been encountered.
   ///
-  /// We use the addresses of nodes as key. It's legit because nodes are unified and immutable.
-  std::unordered_set<const void*> visited_;
+  /// We use the identifiers of nodes as key. It's legit because nodes are unified and immutable.
+  visited_set<C> visited_;
 
   /// @brief Stores the frequency of apparition of a number of arcs.
   arcs_frequency_type map_;
 
   /// @brief |0|.
   void
-  operator()(const zero_terminal<C>&)
+  operator()(const zero_terminal<C>&, const SDD<C>&)
   const
   {}
 
   /// @brief |1|.
   void
-  operator()(const one_terminal<C>&)
+  operator()(const one_terminal<C>&, const SDD<C>&)
   const
   {}
 
   /// @brief Flat SDD.
   void
-  operator()(const flat_node<C>& n)
+  operator()(const flat_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       map_[n.size()].first += 1;
       for (const auto& arc : n)
       {
-        visit(*this, arc.successor());
+        visit(*this, arc.successor(), arc.successor());
       }
     }
   }
 
   /// @brief Hierarchical SDD.
   void
-  operator()(const hierarchical_node<C>& n)
+  operator()(const hierarchical_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       map_[n.size()].second += 1;
       for (const auto& arc : n)
       {
-        visit(*this, arc.valuation());
-        visit(*this, arc.successor());
+        visit(*this, arc.valuation(), arc.valuation());
+        visit(*this, arc.successor(), arc.successor());
       }
     }
   }
@@ -88,7 +88,7 @@ arcs_frequency_type
 arcs(const SDD<C>& x)
 {
   arcs_visitor<C> visitor;
-  visit(visitor, x);
+  visit(visitor, x, x);
   return std::move(visitor.map_);
 }
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstdint> // uint64_t
 #include <sstream>
 #include <string>
 
@@ -13,17 +14,27 @@
 #include <cereal/external/rapidjson/prettywriter.h>
 
 #include "sdd/hom/definition.hh"
+#include "sdd/hom/profiler.hh"
 
 namespace sdd { namespace tools {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+template <typename C>
+void
+hom_to_json( const homomorphism<C>&, rapidjson::Value&, rapidjson::Document::AllocatorType&
+           , const hom::profiler<C>*);
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C>
 struct hom_to_json_visitor
 {
   rapidjson::Value& value;
   rapidjson::Document::AllocatorType& allocator;
+  const hom::profiler<C>* profiler;
 
   void
   operator()(const hom::_composition<C>& h)
@@ -32,10 +43,10 @@ struct hom_to_json_visitor
     value.AddMember("name", "o", allocator);
     rapidjson::Value children(rapidjson::kArrayType);
     rapidjson::Value left_child(rapidjson::kObjectType);
-    visit(hom_to_json_visitor{left_child, allocator}, h.left);
+    hom_to_json(h.left, left_child, allocator, profiler);
     children.PushBack(left_child, allocator);
     rapidjson::Value right_child(rapidjson::kObjectType);
-    visit(hom_to_json_visitor{right_child, allocator}, h.right);
+    hom_to_json(h.right, right_child, allocator, profiler);
     children.PushBack(right_child, allocator);
     value.AddMember("children", children, allocator);
   }
@@ -44,10 +55,18 @@ struct hom_to_json_visitor
   operator()(const hom::_fixpoint<C>& h)
   const
   {
-    value.AddMember("name", "*", allocator);
+    std::stringstream ss;
+    ss << "*";
+    if (h.mode != fixpoint_mode::frontier)
+    {
+      ss << "[" << h.mode << "]";
+    }
+    rapidjson::Value s;
+    s.SetString(ss.str().c_str(), static_cast<rapidjson::SizeType>(ss.str().size()), allocator);
+    value.AddMember("name", s, allocator);
     rapidjson::Value children(rapidjson::kArrayType);
     rapidjson::Value child(rapidjson::kObjectType);
-    visit(hom_to_json_visitor{child, allocator}, h.h);
+    hom_to_json(h.h, child, allocator, profiler);
     children.PushBack(child, allocator);
     value.AddMember("children", children, allocator);
   }
@@ -80,7 +99,7 @@ struct hom_to_json_visitor
     value.AddMember("name", s, allocator);
     rapidjson::Value children(rapidjson::kArrayType);
     rapidjson::Value child(rapidjson::kObjectType);
-    visit(hom_to_json_visitor{child, allocator}, h.h);
+    hom_to_json(h.h, child, allocator, profiler);
     children.PushBack(child, allocator);
     value.AddMember("children", children, allocator);
   }
@@ -94,7 +113,7 @@ struct hom_to_json_visitor
     for (const auto& operand : h)
     {
       rapidjson::Value child(rapidjson::kObjectType);
-      visit(hom_to_json_visitor{child, allocator}, operand);
+      hom_to_json(operand, child, allocator, profiler);
       children.PushBack(child, allocator);
     }
     value.AddMember("children", children, allocator);
@@ -111,12 +130,57 @@ struct hom_to_json_visitor
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Add the profile of an homomorphism to its JSON object.
+inline
+void
+profile_to_json( const hom::hom_profile& p, rapidjson::Value& value
+               , rapidjson::Document::AllocatorType& allocator)
+{
+  rapidjson::Value profile(rapidjson::kObjectType);
+  const auto add = [&](const char* name, std::uint64_t x)
+  {
+    rapidjson::Value v(x);
+    profile.AddMember(name, v, allocator);
+  };
+  add("calls", p.calls);
+  add("hits", p.hits);
+  add("misses", p.misses);
+  add("inclusive_ns", static_cast<std::uint64_t>(p.inclusive.count()));
+  add("exclusive_ns", static_cast<std::uint64_t>(p.exclusive.count()));
+  add("input_arcs", p.input_arcs);
+  add("output_arcs", p.output_arcs);
+  value.AddMember("profile", profile, allocator);
+}
+
+/// @internal
+/// @brief Fill a JSON object with an homomorphism and, if any, its profile.
+template <typename C>
+void
+hom_to_json( const homomorphism<C>& h, rapidjson::Value& value
+           , rapidjson::Document::AllocatorType& allocator, const hom::profiler<C>* profiler)
+{
+  visit(hom_to_json_visitor<C>{value, allocator, profiler}, h);
+  if (profiler)
+  {
+    if (const auto p = (*profiler)[h])
+    {
+      profile_to_json(*p, value, allocator);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C>
 struct hom_to_js
 {
   const homomorphism<C> h_;
 
+  /// @brief If not nullptr, the profile of each homomorphism is added to its node.
+  const hom::profiler<C>* profiler_;
+
   friend
   std::ostream&
   operator<<(std::ostream& os, const hom_to_js& manip)
@@ -126,7 +190,7 @@ struct hom_to_js
 
     rapidjson::Document document(&allocator, 1024);
     document.SetObject();
-    visit(hom_to_json_visitor<C>{document, allocator}, manip.h_);
+    hom_to_json(manip.h_, document, allocator, manip.profiler_);
 
     // write directly to os
     struct _stream
@@ -150,7 +214,18 @@ template <typename C>
 hom_to_js<C>
 js(const homomorphism<C>& h)
 {
-  return {h};
+  return {h, nullptr};
+}
+
+/// @internal
+/// @brief Export an homomorphism with the profile of each of its nodes.
+///
+/// Nodes have a "profile" member if they were applied, see hom::hom_profile.
+template <typename C>
+hom_to_js<C>
+js(const homomorphism<C>& h, const hom::profiler<C>& profiler)
+{
+  return {h, &profiler};
 }
 
 /*------------------------------------------------------------------------------------------------*/
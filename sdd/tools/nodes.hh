@@ -6,9 +6,11 @@
 
 #pragma once
 
-#include <unordered_set>
+#include <utility> // pair
 
 #include "sdd/dd/definition.hh"
+#include "sdd/util/deep_call.hh"
+#include "sdd/tools/visited.hh"
 
 namespace sdd { namespace tools {
 
@@ -22,12 +24,12 @@ struct nb_nodes_visitor
 
   /// @brief A cache is necessary to to know if a node has already been encountered.
   ///
-  /// We use the addresses of nodes as key. It's legit because nodes are unified and immutable.
-  std::unordered_set<const void*> visited_;
+  /// We use the identifiers of nodes as key. It's legit because nodes are unified and immutable.
+  visited_set<C> visited_;
 
   /// @brief |0|.
   result_type
-  operator()(const zero_terminal<C>&)
+  operator()(const zero_terminal<C>&, const SDD<C>&)
   const
   {
     return std::make_pair(0, 0);
@@ -35,7 +37,7 @@ struct nb_nodes_visitor
 
   /// @brief |1|.
   result_type
-  operator()(const one_terminal<C>&)
+  operator()(const one_terminal<C>&, const SDD<C>&)
   const
   {
     return std::make_pair(0, 0);
@@ -43,14 +45,14 @@ struct nb_nodes_visitor
 
   /// @brief Flat SDD.
   result_type
-  operator()(const flat_node<C>& n)
+  operator()(const flat_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       result_type res {1, 0};
       for (const auto& arc : n)
       {
-        accumulate_pair(res, visit(*this, arc.successor()));
+        accumulate_pair(res, deep_visit(arc.successor()));
       }
       return res;
     }
@@ -62,15 +64,15 @@ struct nb_nodes_visitor
 
   /// @brief Hierarchical SDD.
   result_type
-  operator()(const hierarchical_node<C>& n)
+  operator()(const hierarchical_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       result_type res {0, 1};
       for (const auto& arc : n)
       {
-        accumulate_pair(res, visit(*this, arc.valuation()));
-        accumulate_pair(res, visit(*this, arc.successor()));
+        accumulate_pair(res, visit(*this, arc.valuation(), arc.valuation()));
+        accumulate_pair(res, deep_visit(arc.successor()));
       }
       return res;
     }
@@ -82,6 +84,13 @@ struct nb_nodes_visitor
 
 private:
 
+  /// @brief Visit a successor, the recursion may be as deep as the order.
+  result_type
+  deep_visit(const SDD<C>& x)
+  {
+    return util::deep_call([&]{return visit(*this, x, x);});
+  }
+
   static
   void
   accumulate_pair(result_type& lhs, result_type&& rhs)
@@ -101,7 +110,7 @@ template <typename C>
 std::pair<unsigned int, unsigned int>
 nodes(const SDD<C>& x)
 {
-  return visit(nb_nodes_visitor<C>(), x);
+  return visit(nb_nodes_visitor<C>(), x, x);
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,126 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // max
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>   // pair
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/internal_manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/order/order_builder.hh"
+#include "sdd/tools/nodes.hh"
+
+namespace sdd { namespace tools {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief What happened when a model was explored with a candidate order.
+struct order_evaluation
+{
+  /// @brief The name of the candidate order.
+  std::string name;
+
+  /// @brief The number of nodes of the initial SDD.
+  std::size_t initial_nodes;
+
+  /// @brief The number of nodes of the last computed SDD.
+  std::size_t final_nodes;
+
+  /// @brief The largest number of nodes of all computed SDD.
+  std::size_t peak_nodes;
+
+  /// @brief The number of performed iterations.
+  unsigned int iterations;
+
+  /// @brief Tell if the fixpoint was reached within the bounded number of iterations.
+  bool fixpoint;
+
+  /// @brief The number of states of the last computed SDD.
+  boost::multiprecision::cpp_int states;
+
+  /// @brief The time spent building the initial SDD and iterating.
+  std::chrono::duration<double> time;
+};
+
+/// @related order_evaluation
+inline
+std::ostream&
+operator<<(std::ostream& os, const order_evaluation& e)
+{
+  return os << e.name << ": "
+            << e.initial_nodes << " initial nodes, "
+            << e.final_nodes << " final nodes, "
+            << e.peak_nodes << " peak nodes, "
+            << e.states << " states, "
+            << e.iterations << " iterations" << (e.fixpoint ? " (fixpoint), " : ", ")
+            << std::chrono::duration_cast<std::chrono::milliseconds>(e.time).count() << "ms";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Explore a model with several candidate orders.
+/// @param candidates The orders to evaluate, with their names.
+/// @param model Given an order, returns the initial SDD and the homomorphism of one step of the
+/// exploration, as a std::pair<SDD<C>, homomorphism<C>>.
+/// @param max_iterations The step is applied at most this number of times.
+///
+/// For each candidate, the initial SDD is built and the step is applied until a fixpoint is reached
+/// or the bound is hit, reporting node counts and time. It gives data to choose an ordering
+/// strategy for a model, with a bounded cost. Caches are cleared between candidates so that each
+/// one starts from the same state.
+template <typename C, typename Model>
+std::vector<order_evaluation>
+evaluate_orders( const std::vector<std::pair<std::string, order_builder<C>>>& candidates
+               , Model&& model, unsigned int max_iterations)
+{
+  std::vector<order_evaluation> res;
+  res.reserve(candidates.size());
+  for (const auto& candidate : candidates)
+  {
+    global<C>().sdd_context.clear();
+    global<C>().hom_context.clear();
+
+    const auto start = std::chrono::steady_clock::now();
+    const order<C> o(candidate.second);
+    const auto initial_step = model(o);
+    SDD<C> x = initial_step.first;
+    const auto& step = initial_step.second;
+
+    const auto count = [](const SDD<C>& s){const auto n = nodes(s); return n.first + n.second;};
+    order_evaluation e{candidate.first, count(x), 0, 0, 0, false, 0, {}};
+    e.peak_nodes = e.initial_nodes;
+    while (e.iterations < max_iterations)
+    {
+      const auto next = step(o, x);
+      e.iterations += 1;
+      if (next == x)
+      {
+        e.fixpoint = true;
+        break;
+      }
+      x = next;
+      e.peak_nodes = std::max<std::size_t>(e.peak_nodes, count(x));
+    }
+    e.final_nodes = count(x);
+    e.states = x.size();
+    e.time = std::chrono::steady_clock::now() - start;
+    res.push_back(std::move(e));
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::tools
@@ -0,0 +1,174 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <ostream>
+#include <unordered_set>
+#include <vector>
+
+#include "sdd/internal_manager_fwd.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/saturation_state.hh"
+
+namespace sdd { namespace tools {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief How an operand of a Saturation Fixpoint behaved during evaluations.
+template <typename C>
+struct saturation_operand_profile
+{
+  /// @brief The variable of the Saturation Fixpoint.
+  typename C::variable_type variable;
+
+  /// @brief The operand.
+  homomorphism<C> operand;
+
+  /// @brief The number of times it was applied.
+  std::size_t firings;
+
+  /// @brief The number of times it produced new states.
+  std::size_t productive;
+};
+
+/// @related saturation_operand_profile
+template <typename C>
+std::ostream&
+operator<<(std::ostream& os, const saturation_operand_profile<C>& p)
+{
+  return os << "@" << p.variable << " " << p.operand << ": " << p.firings << " firings, "
+            << p.productive << " productive";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+template <typename C>
+struct saturation_profile_visitor
+{
+  /// @brief Nodes are unified and immutable, their addresses identify them.
+  mutable std::unordered_set<const void*> visited_;
+
+  /// @brief The states of the Saturation Fixpoints, where counters are.
+  const hom::saturation_states<C>& states_;
+
+  /// @brief Where operands are reported.
+  std::vector<saturation_operand_profile<C>>& res_;
+
+  void
+  operator()(const hom::_composition<C>& h, const homomorphism<C>&)
+  const
+  {
+    if (not visited(h))
+    {
+      visit(*this, h.left, h.left);
+      visit(*this, h.right, h.right);
+    }
+  }
+
+  void
+  operator()(const hom::_fixpoint<C>& h, const homomorphism<C>&)
+  const
+  {
+    if (not visited(h))
+    {
+      visit(*this, h.h, h.h);
+    }
+  }
+
+  void
+  operator()(const hom::_if_then_else<C>& h, const homomorphism<C>&)
+  const
+  {
+    if (not visited(h))
+    {
+      visit(*this, h.h_if, h.h_if);
+      visit(*this, h.h_then, h.h_then);
+      visit(*this, h.h_else, h.h_else);
+    }
+  }
+
+  void
+  operator()(const hom::_local<C>& h, const homomorphism<C>&)
+  const
+  {
+    if (not visited(h))
+    {
+      visit(*this, h.h, h.h);
+    }
+  }
+
+  void
+  operator()(const hom::_saturation_fixpoint<C>& h, const homomorphism<C>& self)
+  const
+  {
+    if (not visited(h))
+    {
+      visit(*this, h.F, h.F);
+      // A Saturation Fixpoint which was never evaluated has no counters yet.
+      const auto state = states_[self];
+      std::size_t i = 0;
+      for (const auto& g : h)
+      {
+        const auto counters = state ? state->counters[i++] : hom::saturation_counters{0, 0};
+        res_.push_back({h.variable, g, counters.firings, counters.productive});
+        visit(*this, g, g);
+      }
+      visit(*this, h.L, h.L);
+    }
+  }
+
+  void
+  operator()(const hom::_sum<C>& h, const homomorphism<C>&)
+  const
+  {
+    if (not visited(h))
+    {
+      for (const auto& operand : h)
+      {
+        visit(*this, operand, operand);
+      }
+    }
+  }
+
+  template <typename T>
+  void
+  operator()(const T&, const homomorphism<C>&)
+  const noexcept
+  {}
+
+private:
+
+  template <typename H>
+  bool
+  visited(const H& h)
+  const
+  {
+    return not visited_.emplace(&h).second;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Get the counters of the operands of all Saturation Fixpoints of an homomorphism.
+///
+/// Counters accumulate over all evaluations of a Saturation Fixpoint in the homomorphisms context
+/// of the library. They tell which operands of the G part actually discover new states, which can
+/// guide the design of a model.
+template <typename C>
+std::vector<saturation_operand_profile<C>>
+saturation_profile(const homomorphism<C>& h)
+{
+  std::vector<saturation_operand_profile<C>> res;
+  const auto& states = global<C>().hom_context.saturations();
+  visit(saturation_profile_visitor<C>{{}, states, res}, h, h);
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::tools
@@ -6,43 +6,247 @@
 
 #pragma once
 
+#include <map>
 #include <utility> // pair
+#include <vector>
 
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "sdd/dd/definition.hh"
 #include "sdd/tools/arcs.hh"
-#include "sdd/tools/nodes.hh"
-#include "sdd/tools/size.hh"
+#include "sdd/tools/visited.hh"
+#include "sdd/values/size.hh"
 
 namespace sdd { namespace tools {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Select the metrics computed by statistics().
+///
+/// The number of nodes is always computed as it costs nothing more than the traversal itself.
+struct statistics_request
+{
+  /// @brief Compute the memory footprint.
+  bool bytes = true;
+
+  /// @brief Compute the frequency of the number of arcs.
+  bool arcs = true;
+
+  /// @brief Compute the number of nodes and arcs per variable.
+  bool variables = true;
+
+  /// @brief Compute the number of paths.
+  ///
+  /// Disabled by default as it requires arbitrary precision arithmetic on every node.
+  bool paths = false;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 template <typename C>
 class sdd_statistics
 {
+public:
+
+  /// @brief Number of nodes and of arcs, for a variable.
+  using variables_type = std::map<typename C::variable_type, std::pair<unsigned int, unsigned int>>;
+
 private:
 
   std::size_t bytes_;
   arcs_frequency_type arcs_frequency_;
   std::pair<unsigned int, unsigned int> all_nodes_;
   std::pair<unsigned int, unsigned int> all_arcs_;
+  variables_type variables_;
+  boost::multiprecision::cpp_int paths_;
+
+  template <typename> friend struct statistics_visitor;
 
 public:
 
+  /// @brief Compute all metrics, but the number of paths.
   sdd_statistics(const SDD<C>& x)
-    : bytes_(size(x))
-    , arcs_frequency_(arcs(x))
-    , all_nodes_(nodes(x))
-    , all_arcs_(number_of_arcs(arcs_frequency_))
+    : sdd_statistics(x, statistics_request())
   {}
 
+  /// @brief Compute the metrics selected by a request.
+  sdd_statistics(const SDD<C>& x, const statistics_request& request);
+
   std::size_t bytes()                                   const noexcept {return bytes_;}
   const arcs_frequency_type& arcs_frequency()           const noexcept {return arcs_frequency_;}
   std::pair<unsigned int, unsigned int> all_nodes()     const noexcept {return all_nodes_;}
   std::pair<unsigned int, unsigned int> all_arcs()      const noexcept {return all_arcs_;}
+  const variables_type& variables()                     const noexcept {return variables_;}
+  const boost::multiprecision::cpp_int& paths()         const noexcept {return paths_;}
 };
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Compute all requested metrics in a single traversal.
+///
+/// Each node is visited once, whatever the number of requested metrics.
+template <typename C>
+struct statistics_visitor
+{
+  /// @brief The metrics to compute.
+  const statistics_request& request_;
+
+  /// @brief Where to store the results.
+  sdd_statistics<C>& stats_;
+
+  /// @brief Already visited nodes.
+  visited_set<C> visited_;
+
+  /// @brief Number of paths of already visited nodes, indexed by their identifiers.
+  std::vector<boost::multiprecision::cpp_int> paths_;
+
+  statistics_visitor(const statistics_request& request, sdd_statistics<C>& stats)
+    : request_(request), stats_(stats), visited_(global<C>().sdd_unique_table.identifiers_bound())
+    , paths_(request.paths ? global<C>().sdd_unique_table.identifiers_bound() : 0)
+  {}
+
+  /// @brief |0|.
+  void
+  operator()(const zero_terminal<C>&, const SDD<C>& x)
+  {
+    if (visited_.insert(x) and request_.bytes)
+    {
+      stats_.bytes_ += sizeof(zero_terminal<C>);
+    }
+  }
+
+  /// @brief |1|.
+  void
+  operator()(const one_terminal<C>&, const SDD<C>& x)
+  {
+    if (visited_.insert(x))
+    {
+      if (request_.bytes)
+      {
+        stats_.bytes_ += sizeof(one_terminal<C>);
+      }
+      if (request_.paths)
+      {
+        path(x) = 1;
+      }
+    }
+  }
+
+  /// @brief Flat SDD.
+  void
+  operator()(const flat_node<C>& n, const SDD<C>& x)
+  {
+    if (not visited_.insert(x))
+    {
+      return;
+    }
+    stats_.all_nodes_.first += 1;
+    stats_.all_arcs_.first += n.size();
+    if (request_.bytes)
+    {
+      stats_.bytes_ += sizeof(typename SDD<C>::unique_type) // size of a ref_counted
+                     + n.size() * sizeof(typename flat_node<C>::arc_type); // arcs
+    }
+    if (request_.arcs)
+    {
+      stats_.arcs_frequency_[n.size()].first += 1;
+    }
+    if (request_.variables)
+    {
+      auto& var = stats_.variables_[n.variable()];
+      var.first += 1;
+      var.second += n.size();
+    }
+    using values::size; // to let users define the size of their own sets of values
+    boost::multiprecision::cpp_int res = 0;
+    for (const auto& arc : n)
+    {
+      visit(*this, arc.successor(), arc.successor());
+      if (request_.paths)
+      {
+        res += size(arc.valuation()) * path(arc.successor());
+      }
+    }
+    if (request_.paths)
+    {
+      path(x) = std::move(res);
+    }
+  }
+
+  /// @brief Hierarchical SDD.
+  void
+  operator()(const hierarchical_node<C>& n, const SDD<C>& x)
+  {
+    if (not visited_.insert(x))
+    {
+      return;
+    }
+    stats_.all_nodes_.second += 1;
+    stats_.all_arcs_.second += n.size();
+    if (request_.bytes)
+    {
+      stats_.bytes_ += sizeof(typename SDD<C>::unique_type) // size of a ref_counted
+                     + n.size() * sizeof(typename hierarchical_node<C>::arc_type); // arcs
+    }
+    if (request_.arcs)
+    {
+      stats_.arcs_frequency_[n.size()].second += 1;
+    }
+    if (request_.variables)
+    {
+      auto& var = stats_.variables_[n.variable()];
+      var.first += 1;
+      var.second += n.size();
+    }
+    boost::multiprecision::cpp_int res = 0;
+    for (const auto& arc : n)
+    {
+      visit(*this, arc.valuation(), arc.valuation());
+      visit(*this, arc.successor(), arc.successor());
+      if (request_.paths)
+      {
+        res += path(arc.valuation()) * path(arc.successor());
+      }
+    }
+    if (request_.paths)
+    {
+      path(x) = std::move(res);
+    }
+  }
+
+private:
+
+  /// @brief Get the memoized number of paths of an SDD.
+  boost::multiprecision::cpp_int&
+  path(const SDD<C>& x)
+  {
+    const auto id = x.ptr()->id();
+    if (id >= paths_.size())
+    {
+      paths_.resize(id + 1);
+    }
+    return paths_[id];
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+sdd_statistics<C>::sdd_statistics(const SDD<C>& x, const statistics_request& request)
+  : bytes_(0), arcs_frequency_(), all_nodes_(0, 0), all_arcs_(0, 0), variables_(), paths_(0)
+{
+  statistics_visitor<C> visitor(request, *this);
+  visit(visitor, x, x);
+  if (request.paths and not x.empty())
+  {
+    paths_ = visitor.paths_[x.ptr()->id()];
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Compute all metrics of an SDD, but the number of paths, in a single traversal.
 template <typename C>
 sdd_statistics<C>
 statistics(const SDD<C>& s)
@@ -50,6 +254,14 @@ statistics(const SDD<C>& s)
   return {s};
 }
 
+/// @brief Compute the requested metrics of an SDD in a single traversal.
+template <typename C>
+sdd_statistics<C>
+statistics(const SDD<C>& s, const statistics_request& request)
+{
+  return {s, request};
+}
+
 /*------------------------------------------------------------------------------------------------*/
 
 }} // namespace sdd::tools
@@ -6,11 +6,9 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
-#include <utility> // pair
-
 #include "sdd/dd/definition.hh"
+#include "sdd/util/deep_call.hh"
+#include "sdd/tools/visited.hh"
 
 namespace sdd { namespace tools {
 
@@ -22,14 +20,14 @@ struct size_visitor
 {
   /// @brief A cache is necessary to to know if a node has already been encountered.
   ///
-  /// We use the addresses of nodes as key. It's legit because nodes are unified and immutable.
-  std::unordered_set<const void*> visited_;
+  /// We use the identifiers of nodes as key. It's legit because nodes are unified and immutable.
+  visited_set<C> visited_;
 
   /// @brief |0|.
   std::size_t
-  operator()(const zero_terminal<C>& n)
+  operator()(const zero_terminal<C>&, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       return sizeof(zero_terminal<C>);
     }
@@ -41,9 +39,9 @@ struct size_visitor
 
   /// @brief |1|.
   std::size_t
-  operator()(const one_terminal<C>& n)
+  operator()(const one_terminal<C>&, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       return sizeof(one_terminal<C>);
     }
@@ -55,15 +53,15 @@ struct size_visitor
 
   /// @brief Flat SDD.
   std::size_t
-  operator()(const flat_node<C>& n)
+  operator()(const flat_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       std::size_t res = sizeof(typename SDD<C>::unique_type) // size of a ref_counted
                       + n.size() * sizeof(typename flat_node<C>::arc_type); // arcs
       for (const auto& arc : n)
       {
-        res += visit(*this, arc.successor());
+        res += deep_visit(arc.successor());
       }
       return res;
     }
@@ -75,16 +73,16 @@ struct size_visitor
 
   /// @brief Hierarchical SDD.
   std::size_t
-  operator()(const hierarchical_node<C>& n)
+  operator()(const hierarchical_node<C>& n, const SDD<C>& x)
   {
-    if (visited_.emplace(&n).second)
+    if (visited_.insert(x))
     {
       std::size_t res = sizeof(typename SDD<C>::unique_type) // size of a ref_counted
                       + n.size() * sizeof(typename hierarchical_node<C>::arc_type); // arcs
       for (const auto& arc : n)
       {
-        res += visit(*this, arc.valuation());
-        res += visit(*this, arc.successor());
+        res += visit(*this, arc.valuation(), arc.valuation());
+        res += deep_visit(arc.successor());
       }
       return res;
     }
@@ -93,6 +91,15 @@ struct size_visitor
       return 0;
     }
   }
+
+private:
+
+  /// @brief Visit a successor, the recursion may be as deep as the order.
+  std::size_t
+  deep_visit(const SDD<C>& x)
+  {
+    return util::deep_call([&]{return visit(*this, x, x);});
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -102,7 +109,7 @@ template <typename C>
 std::size_t
 size(const SDD<C>& x)
 {
-  return visit(size_visitor<C>(), x);
+  return visit(size_visitor<C>(), x, x);
 }
 
 /*------------------------------------------------------------------------------------------------*/
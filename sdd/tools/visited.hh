@@ -0,0 +1,71 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // max
+#include <cstdint>   // uint32_t
+#include <vector>
+
+#include "sdd/dd/definition.hh"
+
+namespace sdd { namespace tools {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Keep track of already visited SDD nodes during a traversal.
+///
+/// It's a dense bitmap indexed by the identifiers given to nodes by the unique table. As these
+/// identifiers are recycled, the bitmap never exceeds one bit per node ever alive at the same
+/// time, which is far less than a hash set of addresses.
+template <typename C>
+class visited_set
+{
+private:
+
+  /// @brief One bit per possible node identifier.
+  std::vector<bool> bits_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param capacity The number of identifiers to reserve room for, the set grows on demand.
+  visited_set(std::size_t capacity = 0)
+    : bits_(capacity, false)
+  {}
+
+  /// @brief Mark an SDD as visited.
+  /// @return true if it was not already visited.
+  bool
+  insert(const SDD<C>& x)
+  {
+    const std::uint32_t id = x.ptr()->id();
+    if (id >= bits_.size())
+    {
+      bits_.resize(std::max<std::size_t>(id + 1, bits_.size() * 2), false);
+    }
+    if (bits_[id])
+    {
+      return false;
+    }
+    bits_[id] = true;
+    return true;
+  }
+
+  /// @brief Tell if an SDD has already been visited.
+  bool
+  contains(const SDD<C>& x)
+  const noexcept
+  {
+    const std::uint32_t id = x.ptr()->id();
+    return id < bits_.size() and bits_[id];
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::tools
@@ -0,0 +1,145 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <cstddef>   // size_t
+#include <exception> // current_exception, exception_ptr, rethrow_exception
+#include <utility>   // move
+
+#include <boost/optional.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105600
+#include <boost/coroutine/asymmetric_coroutine.hpp>
+#else
+#include <boost/coroutine/all.hpp>
+#endif
+
+namespace sdd { namespace util {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The size, in bytes, of the stack segments allocated on the heap by deep_call().
+constexpr std::size_t stack_segment_size = 1024 * 1024;
+
+/// @internal
+/// @brief The number of bytes of a stack segment kept for the calls between two deep_call().
+///
+/// A recursion continues on a new segment once it has used stack_segment_size - stack_red_zone
+/// bytes of the current one.
+constexpr std::size_t stack_red_zone = 256 * 1024;
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The start of the stack segment used by deep_call() on the current thread.
+///
+/// nullptr when no deep_call() is running on this thread.
+inline
+const char*&
+stack_segment_start()
+noexcept
+{
+  static thread_local const char* start = nullptr;
+  return start;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Restore the start of the stack segment of the current thread when leaving a scope.
+struct stack_segment_restorer
+{
+  const char* const start;
+
+  ~stack_segment_restorer()
+  {
+    stack_segment_start() = start;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Call a function on a new stack segment allocated on the heap.
+///
+/// Exceptions are transported to the caller's stack.
+template <typename Function>
+auto
+on_new_stack_segment(Function&& f)
+-> decltype(f())
+{
+#if BOOST_VERSION >= 105600
+  using coroutine_type = boost::coroutines::asymmetric_coroutine<void>::pull_type;
+#else
+  using coroutine_type = boost::coroutines::coroutine<void>::pull_type;
+#endif
+  stack_segment_restorer _{stack_segment_start()};
+  boost::optional<decltype(f())> res;
+  std::exception_ptr error;
+  {
+    // The coroutine runs until its completion as soon as it's constructed.
+    coroutine_type coroutine( [&](auto& /* push_type */)
+                              {
+                                stack_segment_start()
+                                  = static_cast<const char*>(__builtin_frame_address(0));
+                                try
+                                {
+                                  res = f();
+                                }
+                                catch (...)
+                                {
+                                  error = std::current_exception();
+                                }
+                              }
+                            , boost::coroutines::attributes(stack_segment_size));
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  return std::move(*res);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Call a function in a recursion which depth is given by the data, like the length of an
+/// order.
+///
+/// The function is directly called, unless the recursion has used most of the current stack
+/// segment: the call is then made on a new segment allocated on the heap. Thus, the depth of a
+/// recursion is only bounded by the memory, and a shallow one only pays for a comparison. The
+/// stack of a thread is measured from its outermost deep_call().
+template <typename Function>
+auto
+deep_call(Function&& f)
+-> decltype(f())
+{
+  const auto here = static_cast<const char*>(__builtin_frame_address(0));
+  auto& start = stack_segment_start();
+  if (start == nullptr)
+  {
+    start = here;
+    stack_segment_restorer _{nullptr};
+    return f();
+  }
+  // Don't assume the direction in which the stack grows.
+  const std::size_t used = start > here ? start - here : here - start;
+  if (used < stack_segment_size - stack_red_zone)
+  {
+    return f();
+  }
+  else
+  {
+    return on_new_stack_segment(f);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::util
@@ -0,0 +1,433 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>   // uint64_t
+#include <limits>
+#include <memory>    // unique_ptr
+#include <ostream>
+#include <stdexcept> // runtime_error
+#include <thread>
+
+#include "sdd/util/next_power.hh"
+
+namespace sdd { namespace trace {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A recorded event.
+///
+/// Names are string literals, thus only a pointer is stored.
+struct event
+{
+  /// @brief The name of the event.
+  const char* name;
+
+  /// @brief The phase of the event: 'B' (begin), 'E' (end) or 'i' (instant).
+  char phase;
+
+  /// @brief The date of the event, in nanoseconds since the start of the tracer.
+  std::uint64_t date;
+
+  /// @brief The name of the argument of the event, nullptr if it has no argument.
+  const char* arg_name;
+
+  /// @brief The value of the argument of the event.
+  std::uint64_t arg;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A lock-free ring buffer of events, for one producer and one consumer.
+class ring_buffer
+{
+  // Can't copy a ring_buffer.
+  ring_buffer(const ring_buffer&) = delete;
+  ring_buffer& operator=(const ring_buffer&) = delete;
+
+private:
+
+  /// @brief The storage of events.
+  const std::unique_ptr<event[]> events_;
+
+  /// @brief Used to get the index of an event from a position (the capacity is a power of 2).
+  const std::size_t mask_;
+
+  /// @brief The position of the next event to write, only modified by the producer.
+  alignas(64) std::atomic<std::size_t> head_;
+
+  /// @brief The position of the next event to read, only modified by the consumer.
+  alignas(64) std::atomic<std::size_t> tail_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param capacity The number of events, rounded up to a power of 2.
+  ring_buffer(std::size_t capacity)
+    : events_(new event[util::next_power_of_2(capacity < 2 ? 2 : capacity)])
+    , mask_(util::next_power_of_2(capacity < 2 ? 2 : capacity) - 1)
+    , head_(0)
+    , tail_(0)
+  {}
+
+  /// @brief Add an event, return false if the buffer is full.
+  ///
+  /// Must only be called by the producer.
+  bool
+  push(const event& e)
+  noexcept
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) > mask_)
+    {
+      return false;
+    }
+    events_[head & mask_] = e;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Give all available events to a function, then remove them.
+  ///
+  /// Must only be called by the consumer.
+  template <typename Function>
+  void
+  drain(Function&& fun)
+  {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+    {
+      fun(events_[tail & mask_]);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Stream the events of SDD and homomorphism operations in the Chrome trace-event format.
+///
+/// The resulting file can be loaded in chrome://tracing or https://ui.perfetto.dev. Events are
+/// only recorded when the library is compiled with LIBSDD_TRACE, and while a tracer exists. The
+/// library records events in a ring buffer, which is written to the stream by a background thread.
+/// When the buffer is full, events of new operations are dropped; the number of dropped events is
+/// written at the end of the trace.
+///
+/// Operations only record events in the tracer from a single thread at a time. When homomorphisms
+/// are applied asynchronously by the manager, a tracer must thus be created and destroyed while
+/// holding manager::lock(), so that no evaluation uses it meanwhile.
+class tracer
+{
+  // Can't copy a tracer.
+  tracer(const tracer&) = delete;
+  tracer& operator=(const tracer&) = delete;
+
+public:
+
+  /// @brief The clock used to date events.
+  using clock = std::chrono::steady_clock;
+
+private:
+
+  /// @brief Where events are written.
+  std::ostream& os_;
+
+  /// @brief The events not written yet.
+  ring_buffer buffer_;
+
+  /// @brief Only one out of sampling spans of sampled operations is recorded.
+  const unsigned int sampling_;
+
+  /// @brief Spans nested deeper than this limit are not recorded.
+  const unsigned int max_depth_;
+
+  /// @brief The date of the creation of this tracer.
+  const clock::time_point start_;
+
+  /// @brief The current number of nested spans, recorded or not.
+  unsigned int depth_;
+
+  /// @brief Count the sampled spans.
+  unsigned int sampled_;
+
+  /// @brief The number of events dropped because the buffer was full.
+  std::uint64_t dropped_;
+
+  /// @brief Tell if no event was written yet.
+  bool first_;
+
+  /// @brief Ask the background thread to stop.
+  std::atomic<bool> stop_;
+
+  /// @brief Write the recorded events.
+  std::thread thread_;
+
+public:
+
+  /// @brief Start tracing.
+  /// @param os Where events are written, it must outlive the tracer.
+  /// @param capacity The number of events that can wait to be written.
+  /// @param sampling Record only one out of sampling spans of frequent operations.
+  /// @param max_depth Don't record spans nested deeper than this limit.
+  /// @param period How often events are written.
+  /// @throw std::runtime_error if there is already a tracer.
+  tracer( std::ostream& os, std::size_t capacity = 1 << 16, unsigned int sampling = 1
+        , unsigned int max_depth = std::numeric_limits<unsigned int>::max()
+        , std::chrono::milliseconds period = std::chrono::milliseconds(10))
+    : os_(os)
+    , buffer_(capacity)
+    , sampling_(sampling == 0 ? 1 : sampling)
+    , max_depth_(max_depth)
+    , start_(clock::now())
+    , depth_(0)
+    , sampled_(0)
+    , dropped_(0)
+    , first_(true)
+    , stop_(false)
+    , thread_()
+  {
+    if (current().load(std::memory_order_acquire) != nullptr)
+    {
+      throw std::runtime_error("A tracer already exists.");
+    }
+    os_ << "{\"traceEvents\":[";
+    thread_ = std::thread([this, period]
+                          {
+                            while (not stop_.load(std::memory_order_acquire))
+                            {
+                              flush();
+                              std::this_thread::sleep_for(period);
+                            }
+                          });
+    current().store(this, std::memory_order_release);
+  }
+
+  /// @brief Stop tracing and write the remaining events.
+  ~tracer()
+  {
+    current().store(nullptr, std::memory_order_release);
+    stop_.store(true, std::memory_order_release);
+    thread_.join();
+    flush();
+    os_ << "\n],\"otherData\":{\"dropped\":" << dropped_ << "}}\n";
+    os_.flush();
+  }
+
+  /// @brief Get the number of events dropped so far because the buffer was full.
+  std::uint64_t
+  dropped()
+  const noexcept
+  {
+    return dropped_;
+  }
+
+  /// @internal
+  /// @brief Get the current tracer, nullptr if there is none.
+  ///
+  /// Atomic, as it's read by the thread which evaluates asynchronous operations.
+  static
+  std::atomic<tracer*>&
+  current()
+  noexcept
+  {
+    static std::atomic<tracer*> current{nullptr};
+    return current;
+  }
+
+  /// @internal
+  /// @brief Open a span, return true if it was recorded.
+  bool
+  begin(const char* name, bool sampled, const char* arg_name, std::uint64_t arg)
+  noexcept
+  {
+    ++depth_;
+    if (depth_ > max_depth_ or (sampled and sampled_++ % sampling_ != 0))
+    {
+      return false;
+    }
+    if (not buffer_.push({name, 'B', date(), arg_name, arg}))
+    {
+      ++dropped_;
+      return false;
+    }
+    return true;
+  }
+
+  /// @internal
+  /// @brief Close a span.
+  ///
+  /// The end of a recorded span is never dropped, to keep the trace well-formed.
+  void
+  end(const char* name, bool recorded, const char* arg_name, std::uint64_t arg)
+  noexcept
+  {
+    --depth_;
+    if (recorded)
+    {
+      const event e{name, 'E', date(), arg_name, arg};
+      while (not buffer_.push(e))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /// @internal
+  /// @brief Record an instant event.
+  void
+  instant(const char* name)
+  noexcept
+  {
+    if (not buffer_.push({name, 'i', date(), nullptr, 0}))
+    {
+      ++dropped_;
+    }
+  }
+
+private:
+
+  /// @brief Get the current date.
+  std::uint64_t
+  date()
+  const noexcept
+  {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start_).count());
+  }
+
+  /// @brief Write all recorded events.
+  void
+  flush()
+  {
+    buffer_.drain([this](const event& e)
+                  {
+                    os_ << (first_ ? "\n" : ",\n");
+                    first_ = false;
+                    // Dates are in microseconds.
+                    os_ << "{\"name\":\"" << e.name << "\",\"ph\":\"" << e.phase
+                        << "\",\"ts\":" << e.date / 1000 << '.' << (e.date % 1000) / 100
+                        << (e.date % 100) / 10 << e.date % 10 << ",\"pid\":1,\"tid\":1";
+                    if (e.phase == 'i')
+                    {
+                      os_ << ",\"s\":\"g\"";
+                    }
+                    if (e.arg_name)
+                    {
+                      os_ << ",\"args\":{\"" << e.arg_name << "\":" << e.arg << '}';
+                    }
+                    os_ << '}';
+                  });
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Record a span for the time of its scope.
+///
+/// Without LIBSDD_TRACE, it does nothing and is optimized away.
+class scope
+{
+  // Can't copy a scope.
+  scope(const scope&) = delete;
+  scope& operator=(const scope&) = delete;
+
+#ifdef LIBSDD_TRACE
+private:
+
+  /// @brief The tracer when this scope was opened.
+  tracer* const tracer_;
+
+  /// @brief The name of the span.
+  const char* const name_;
+
+  /// @brief Tell if the beginning of the span was recorded.
+  const bool recorded_;
+
+  /// @brief The name of the argument of the end of the span.
+  const char* arg_name_;
+
+  /// @brief The value of the argument of the end of the span.
+  std::uint64_t arg_;
+#endif
+
+public:
+
+  /// @brief Open a span.
+  /// @param name A string literal.
+  /// @param sampled Tell if this span is subject to sampling, because it's frequent.
+  /// @param arg_name If not nullptr, the name of the argument of the beginning of the span.
+  /// @param arg The value of the argument of the beginning of the span.
+  scope( const char* name, bool sampled = true, const char* arg_name = nullptr
+       , std::uint64_t arg = 0)
+  noexcept
+#ifdef LIBSDD_TRACE
+    : tracer_(tracer::current().load(std::memory_order_acquire))
+    , name_(name)
+    , recorded_(tracer_ and tracer_->begin(name, sampled, arg_name, arg))
+    , arg_name_(nullptr)
+    , arg_(0)
+  {}
+#else
+  {
+    (void)name; (void)sampled; (void)arg_name; (void)arg;
+  }
+#endif
+
+  /// @brief Set the argument of the end of the span.
+  void
+  result(const char* arg_name, std::uint64_t arg)
+  noexcept
+  {
+#ifdef LIBSDD_TRACE
+    arg_name_ = arg_name;
+    arg_ = arg;
+#else
+    (void)arg_name; (void)arg;
+#endif
+  }
+
+  /// @brief Close the span.
+  ~scope()
+  {
+#ifdef LIBSDD_TRACE
+    if (tracer_ and tracer_ == tracer::current().load(std::memory_order_acquire))
+    {
+      tracer_->end(name_, recorded_, arg_name_, arg_);
+    }
+#endif
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Record an instant event.
+/// @param name A string literal.
+inline
+void
+instant(const char* name)
+noexcept
+{
+#ifdef LIBSDD_TRACE
+  if (const auto t = tracer::current().load(std::memory_order_acquire))
+  {
+    t->instant(name);
+  }
+#else
+  (void)name;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::trace
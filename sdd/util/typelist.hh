@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <type_traits> // false_type, true_type
+
 namespace sdd { namespace util {
 
 /*------------------------------------------------------------------------------------------------*/
@@ -101,4 +103,26 @@ struct join<list<Xs...>, list<Ys...>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Tell if a type belongs to a list.
+template <typename T, typename List>
+struct contains;
+
+template <typename T>
+struct contains<T, list<>>
+  : std::false_type
+{};
+
+template <typename T, typename... Xs>
+struct contains<T, list<T, Xs...>>
+  : std::true_type
+{};
+
+template <typename T, typename X, typename... Xs>
+struct contains<T, list<X, Xs...>>
+  : contains<T, list<Xs...>>
+{};
+
+/*------------------------------------------------------------------------------------------------*/
+
 }} // namespace sdd::util
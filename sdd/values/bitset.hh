@@ -42,6 +42,13 @@ public:
   noexcept
     : content_{b.content_}
   {}
+
+  /// @brief Copy operator.
+  ///
+  /// Explicitly defaulted, as the implicit one is deprecated because of the copy constructor.
+  bitset&
+  operator=(const bitset&)
+  noexcept = default;
   
   bitset(const std::bitset<Size>& std_b)
   noexcept
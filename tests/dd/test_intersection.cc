@@ -434,3 +434,17 @@ TYPED_TEST(intersection_test, operators)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(intersection_test, binary)
+{
+  const SDD x(1, SDD('a', {0,1}, one), SDD(0, {0}, one));
+  const SDD y(1, SDD('a', {1,2}, one), SDD(0, {0,1}, one));
+  ASSERT_EQ(SDD(1, SDD('a', {1}, one), SDD(0, {0}, one)), intersection(cxt, x, y));
+  ASSERT_EQ(intersection(cxt, {cxt, {x, y}}), intersection(cxt, y, x));
+  ASSERT_EQ(x, intersection(cxt, x, x));
+  ASSERT_EQ(zero, intersection(cxt, x, zero));
+  ASSERT_EQ(zero, intersection(cxt, zero, x));
+  ASSERT_THROW(intersection(cxt, x, one), sdd::top<conf>);
+}
+
+/*------------------------------------------------------------------------------------------------*/
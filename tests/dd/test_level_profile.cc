@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct level_profile_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  level_profile_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(level_profile_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(level_profile_test, terminals)
+{
+  ASSERT_TRUE(this->m.sdd_level_profile().empty());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(level_profile_test, flat_sdd)
+{
+  const auto& profile = this->m.sdd_level_profile();
+  {
+    const SDD x(1, {0}, SDD(0, {0}, one));
+    const SDD y(1, {1}, SDD(0, {1}, one));
+    ASSERT_EQ(2u, profile.size());
+    ASSERT_EQ(2u, profile[0].nodes);
+    ASSERT_EQ(2u, profile[0].arcs);
+    ASSERT_EQ(2u, profile[1].nodes);
+    ASSERT_EQ(2u, profile[1].arcs);
+    ASSERT_LT(0u, profile[1].bytes);
+
+    const auto hits = profile[0].hits;
+    const SDD z(0, {0}, one);
+    ASSERT_EQ(hits + 1, profile[0].hits);
+    ASSERT_EQ(2u, profile[0].nodes);
+  }
+  ASSERT_EQ(0u, profile[0].nodes);
+  ASSERT_EQ(0u, profile[0].arcs);
+  ASSERT_EQ(0u, profile[0].bytes);
+  ASSERT_EQ(0u, profile[1].nodes);
+  ASSERT_EQ(0u, profile[1].arcs);
+  ASSERT_EQ(0u, profile[1].bytes);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(level_profile_test, hierarchical_sdd)
+{
+  const auto& profile = this->m.sdd_level_profile();
+  {
+    const SDD nested(0, {0}, one);
+    const SDD x(1, nested, SDD(0, nested, one));
+    // Statistics are per variable number: the nested node and the top-level node of variable 0
+    // are merged.
+    ASSERT_EQ(2u, profile.size());
+    ASSERT_EQ(2u, profile[0].nodes);
+    ASSERT_EQ(1u, profile[1].nodes);
+  }
+  ASSERT_EQ(0u, profile[0].nodes);
+  ASSERT_EQ(0u, profile[1].nodes);
+}
+
+/*------------------------------------------------------------------------------------------------*/
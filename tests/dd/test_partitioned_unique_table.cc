@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct partitioned_unique_table_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  partitioned_unique_table_test()
+    : m(sdd::init(partitioned_conf()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+
+  static
+  C
+  partitioned_conf()
+  {
+    auto c = small_conf<C>();
+    c.sdd_unique_table_partitioned = true;
+    c.sdd_unique_table_partition_size = 16;
+    return c;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(partitioned_unique_table_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(partitioned_unique_table_test, partitions)
+{
+  {
+    const SDD x = SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+                + SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one)));
+    const auto stats = this->m.sdd_partitions_stats();
+    ASSERT_EQ(4u, stats.size());
+    ASSERT_EQ(2u, stats[0].size); // terminals
+    ASSERT_LE(2u, stats[1].size);
+    ASSERT_LE(2u, stats[2].size);
+    ASSERT_LE(1u, stats[3].size);
+    ASSERT_EQ(x, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+               + SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one))));
+  }
+  {
+    // Trigger rehashes of partitions.
+    SDD x = zero;
+    for (unsigned int i = 0; i < 64; ++i)
+    {
+      x = x + SDD(1, {i % 8}, SDD(0, {i / 8}, one));
+    }
+    ASSERT_EQ(64, x.size());
+    const auto stats = this->m.sdd_partitions_stats();
+    ASSERT_LE(8u, stats[1].size);
+    ASSERT_LT(0u, stats[1].rehash);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
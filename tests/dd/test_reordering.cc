@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sdd/dd/reordering.hh"
+#include "sdd/manager.hh"
+#include "sdd/tools/nodes.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct reordering_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  reordering_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+
+  /// @brief Build the SDD of a set of flat assignments.
+  static
+  sdd::SDD<C>
+  mk(const sdd::order<C>& o, const std::vector<std::map<std::string, unsigned int>>& assignments)
+  {
+    auto res = sdd::zero<C>();
+    for (const auto& a : assignments)
+    {
+      res += sdd::SDD<C>(o, [&](const std::string& i){return typename C::Values{a.at(i)};});
+    }
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(reordering_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(reordering_test, swap)
+{
+  const std::vector<std::map<std::string, unsigned int>> assignments
+    = { {{"a", 0}, {"b", 1}, {"c", 2}}
+      , {{"a", 1}, {"b", 1}, {"c", 0}}
+      , {{"a", 1}, {"b", 2}, {"c", 2}}
+      , {{"a", 2}, {"b", 0}, {"c", 0}}
+      };
+  order o(order_builder {"a", "b", "c"});
+  SDD x = this->mk(o, assignments);
+
+  sdd::reordering<conf> r(o);
+  r.add_root(x);
+
+  r.swap("a");
+  ASSERT_EQ("b", o.identifier().user());
+  ASSERT_EQ("a", o.next().identifier().user());
+  ASSERT_EQ(this->mk(order(order_builder {"b", "a", "c"}), assignments), x);
+
+  r.swap("a");
+  ASSERT_EQ(this->mk(order(order_builder {"b", "c", "a"}), assignments), x);
+
+  r.swap("b");
+  ASSERT_EQ(this->mk(order(order_builder {"c", "b", "a"}), assignments), x);
+  ASSERT_EQ(3u, r.nb_swaps());
+
+  ASSERT_THROW(r.swap("a"), std::invalid_argument);
+  ASSERT_THROW(r.swap("z"), std::invalid_argument);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(reordering_test, swap_hierarchical)
+{
+  order_builder nested {"x", "y"};
+  order_builder ob;
+  ob.push("b").push("h", nested).push("a");
+  order o(ob);
+
+  const auto init = [](unsigned int a, unsigned int x, unsigned int y, unsigned int b)
+  {
+    return [=](const std::string& i)
+    {
+      return i == "a" ? values_type{a} : i == "x" ? values_type{x}
+           : i == "y" ? values_type{y} : values_type{b};
+    };
+  };
+  const auto mk = [&](const order& ord)
+  {
+    return SDD(ord, init(0, 0, 1, 2)) + SDD(ord, init(1, 0, 1, 2)) + SDD(ord, init(1, 1, 1, 0));
+  };
+
+  SDD x = mk(o);
+  sdd::reordering<conf> r(o);
+  r.add_root(x);
+  r.swap("a");
+
+  order_builder expected_ob;
+  expected_ob.push("b").push("a").push("h", nested);
+  const order expected(expected_ob);
+  ASSERT_EQ("h", o.identifier().user());
+  ASSERT_EQ(mk(expected), x);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(reordering_test, sift)
+{
+  // a_i must be equal to b_i: the best orders interleave a_i and b_i.
+  std::vector<std::map<std::string, unsigned int>> assignments;
+  for (unsigned int a0 = 0; a0 < 4; ++a0)
+  {
+    for (unsigned int a1 = 0; a1 < 4; ++a1)
+    {
+      for (unsigned int a2 = 0; a2 < 4; ++a2)
+      {
+        assignments.push_back({ {"a0", a0}, {"a1", a1}, {"a2", a2}
+                              , {"b0", a0}, {"b1", a1}, {"b2", a2}});
+      }
+    }
+  }
+  order o(order_builder {"a0", "a1", "a2", "b0", "b1", "b2"});
+  SDD x = this->mk(o, assignments);
+  const auto before = sdd::tools::nodes(x).first;
+
+  sdd::reordering<conf> r(o);
+  r.add_root(x);
+  ASSERT_EQ(before, r.size());
+
+  r.sift();
+  const auto after = sdd::tools::nodes(x).first;
+  ASSERT_LT(after, before);
+  ASSERT_EQ(after, r.size());
+  ASSERT_EQ(this->mk(o, assignments), x);
+  ASSERT_EQ(64, x.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(reordering_test, maybe_sift)
+{
+  order o(order_builder {"a", "b"});
+  SDD x = this->mk(o, {{{"a", 0}, {"b", 1}}, {{"a", 1}, {"b", 0}}});
+  {
+    sdd::reordering<conf> r(o);
+    r.add_root(x);
+    ASSERT_FALSE(r.maybe_sift());
+  }
+  {
+    sdd::reordering<conf> r(o, 0);
+    r.add_root(x);
+    ASSERT_TRUE(r.maybe_sift());
+    ASSERT_LT(0u, r.threshold());
+  }
+  ASSERT_EQ(this->mk(o, {{{"a", 0}, {"b", 1}}, {{"a", 1}, {"b", 0}}}), x);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(reordering_test, unregistered)
+{
+  const std::vector<std::map<std::string, unsigned int>> assignments
+    = {{{"a", 0}, {"b", 1}}, {{"a", 1}, {"b", 0}}};
+  order o(order_builder {"a", "b"});
+  SDD x = this->mk(o, assignments);
+  sdd::reordering<conf> r(o);
+  r.add_root(x);
+  {
+    // A copy of a root would keep the previous order.
+    const SDD y = x;
+    ASSERT_THROW(r.swap("a"), std::logic_error);
+    ASSERT_THROW(r.sift(), std::logic_error);
+  }
+  {
+    const SDD z = this->mk(o, {{{"a", 2}, {"b", 2}}});
+    ASSERT_THROW(r.swap("a"), std::logic_error);
+  }
+  ASSERT_EQ("a", o.identifier().user());
+  ASSERT_EQ(0u, r.nb_swaps());
+  ASSERT_EQ(this->mk(o, assignments), x);
+
+  r.swap("a");
+  ASSERT_EQ("b", o.identifier().user());
+  ASSERT_EQ(this->mk(o, assignments), x);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -276,3 +276,29 @@ TYPED_TEST(sum_test, operators)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(sum_test, binary)
+{
+  const SDD x(1, SDD('a', {0}, one), SDD(0, {0}, one));
+  const SDD y(1, SDD('a', {1}, one), SDD(0, {0,1}, one));
+  const SDD z(1, SDD('a', {0}, one), SDD(0, {1}, one));
+  const SDD xy = sum(cxt, x, y);
+  ASSERT_EQ(xy, sum(cxt, {cxt, {x, y}}));
+  ASSERT_EQ(sum(cxt, {cxt, {x, y, z}}), sum(cxt, xy, z));
+  ASSERT_EQ(sum(cxt, {cxt, {x, z}}), sum(cxt, z, x));
+  ASSERT_EQ(x, sum(cxt, x, x));
+  ASSERT_EQ(x, sum(cxt, x, zero));
+  ASSERT_EQ(x, sum(cxt, zero, x));
+  ASSERT_THROW(sum(cxt, x, one), sdd::top<conf>);
+
+  // x + y, y + x and the n-ary sum of x and y share the same cache entry.
+  const auto& stats = sdd::global<conf>().sdd_context.sum_cache().statistics();
+  const auto hits = stats.hits;
+  const auto misses = stats.misses;
+  ASSERT_EQ(xy, sum(cxt, y, x));
+  ASSERT_EQ(xy, sum(cxt, {cxt, {y, x}}));
+  ASSERT_EQ(hits + 2, stats.hits);
+  ASSERT_EQ(misses, stats.misses);
+}
+
+/*------------------------------------------------------------------------------------------------*/
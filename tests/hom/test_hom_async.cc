@@ -0,0 +1,177 @@
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_async_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_async_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+// Handles may outlive the manager, thus this test doesn't use a fixture which holds one.
+TEST(hom_async_lifetime_test, result_outlives_manager)
+{
+  std::vector<sdd::hom::async_evaluation<conf1>> results;
+  {
+    auto m = sdd::init(small_conf<conf1>());
+    const sdd::order<conf1> o(sdd::order_builder<conf1> {"a"});
+    const sdd::SDD<conf1> s0(0, {0}, sdd::one<conf1>());
+    const auto h = fixpoint(sum(o, { inductive<conf1>(targeted_incr<conf1>("a", 1))
+                                   , sdd::id<conf1>()}));
+    results.push_back(m.apply_async(h, o, s0));
+    ASSERT_TRUE(results.back().wait_for(std::chrono::seconds(60)));
+  }
+  // The result was released with the library.
+  ASSERT_THROW(results.back().get(), sdd::interrupted);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_async_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_async_test, evaluation)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  const auto h0 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("a", 1)), id}));
+  const auto h1 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("b", 1)), id}));
+
+  auto r0 = this->m.apply_async(h0, o, s0);
+  auto r1 = this->m.apply_async(h1, o, s0);
+  const auto x1 = r1.get();
+  const auto x0 = r0.get();
+
+  const auto lock = this->m.lock();
+  ASSERT_EQ(SDD(1, {0,1,2}, SDD(0, {0}, one)), x0);
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {0,1,2}, one)), x1);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_async_test, cancellation)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  const auto h0 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("a", 1)), id}));
+  const auto h1 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("b", 1)), id}));
+
+  std::vector<sdd::hom::async_evaluation<conf>> results;
+  {
+    // The background thread can't start evaluations before the lock is released.
+    const auto lock = this->m.lock();
+    results.push_back(this->m.apply_async(h0, o, s0));
+    results.push_back(this->m.apply_async(h1, o, s0));
+    results.push_back(this->m.apply_async(h1, o, s0));
+    results[1].cancel();
+  }
+  ASSERT_TRUE(results[0].wait_for(std::chrono::seconds(60)));
+  const auto x0 = results[0].get();
+  try
+  {
+    results[1].get();
+    FAIL();
+  }
+  catch (const sdd::interrupted& e)
+  {
+    ASSERT_EQ(sdd::interrupted::cause::cancelled, e.why());
+  }
+  const auto x2 = results[2].get();
+
+  const auto lock = this->m.lock();
+  ASSERT_EQ(SDD(1, {0,1,2}, SDD(0, {0}, one)), x0);
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {0,1,2}, one)), x2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_async_test, exception)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  const auto h0 = inductive<conf>(targeted_incr<conf>("a", 1));
+  const auto h1 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("b", 1)), id}));
+
+  this->m.interruption().deadline(std::chrono::steady_clock::now());
+  auto r0 = this->m.apply_async(h1, o, s0);
+  ASSERT_THROW(r0.get(), sdd::interrupted);
+  {
+    const auto lock = this->m.lock();
+    this->m.interruption().reset();
+  }
+  // Unretrieved results are cancelled.
+  this->m.apply_async(h0, o, s0);
+  auto r2 = this->m.apply_async(h0, o, s0);
+  const auto x2 = r2.get();
+
+  const auto lock = this->m.lock();
+  ASSERT_EQ(SDD(1, {1}, SDD(0, {0}, one)), x2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_async_test, moved_operands)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  auto h = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("a", 1)), id}));
+  auto x = s0;
+
+  // Another thread holds the library lock.
+  std::promise<void> locked;
+  std::promise<void> release;
+  std::thread holder([&]
+                     {
+                       const auto lock = this->m.lock();
+                       locked.set_value();
+                       release.get_future().wait();
+                     });
+  locked.get_future().wait();
+
+  // Moving operands doesn't need the library lock.
+  auto queued = std::async( std::launch::async
+                          , [&]{return this->m.apply_async(std::move(h), o, std::move(x));});
+  const auto returned = queued.wait_for(std::chrono::seconds(60)) == std::future_status::ready;
+  release.set_value();
+  holder.join();
+  ASSERT_TRUE(returned);
+
+  auto r = queued.get();
+  const auto x0 = r.get();
+  const auto lock = this->m.lock();
+  ASSERT_EQ(SDD(1, {0,1,2}, SDD(0, {0}, one)), x0);
+}
+
+/*------------------------------------------------------------------------------------------------*/
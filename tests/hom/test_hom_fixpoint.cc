@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <sstream>
+
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
 #include "sdd/hom/rewrite.hh"
@@ -59,6 +61,11 @@ TYPED_TEST(hom_fixpoint_test, construction)
              , fixpoint(fixpoint(inductive<conf>(targeted_incr<conf>("0",1))))
              );
   }
+  {
+    ASSERT_NE( fixpoint(inductive<conf>(targeted_incr<conf>("0",1)))
+             , fixpoint(inductive<conf>(targeted_incr<conf>("0",1)), sdd::fixpoint_mode::whole)
+             );
+  }
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -74,3 +81,58 @@ TYPED_TEST(hom_fixpoint_test, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_fixpoint_test, modes)
+{
+  {
+    const order o(order_builder {"a", "b", "c"});
+    SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+    const auto h = sum<conf>(o, { inductive<conf>(targeted_incr<conf>("c", 1))
+                                , inductive<conf>(targeted_incr<conf>("b", 2))
+                                , inductive<conf>(targeted_incr<conf>("a", 1))
+                                , id});
+    const auto whole = fixpoint(h, sdd::fixpoint_mode::whole);
+    const auto frontier = fixpoint(h, sdd::fixpoint_mode::frontier);
+    const auto chaining = fixpoint(h, sdd::fixpoint_mode::chaining);
+    ASSERT_EQ(SDD(2, {0,1,2}, SDD(1, {0,2}, SDD(0, {0,1,2}, one))), whole(o, s0));
+    ASSERT_EQ(whole(o, s0), frontier(o, s0));
+    ASSERT_EQ(whole(o, s0), chaining(o, s0));
+    ASSERT_EQ(whole(o, zero), frontier(o, zero));
+  }
+  {
+    order o(order_builder().push("c").push("b", order_builder {"x"}).push("a"));
+    SDD s0(2, {0}, SDD(1, SDD(0, {0}, one), SDD(0, {0}, one)));
+    const auto h = sum<conf>(o, { inductive<conf>(targeted_incr<conf>("c", 1))
+                                , local("b", o, inductive<conf>(targeted_incr<conf>("x", 2)))
+                                , id});
+    const auto whole = fixpoint(h, sdd::fixpoint_mode::whole);
+    ASSERT_EQ(whole(o, s0), fixpoint(h, sdd::fixpoint_mode::frontier)(o, s0));
+    ASSERT_EQ(whole(o, s0), fixpoint(h, sdd::fixpoint_mode::chaining)(o, s0));
+  }
+  {
+    // Without Id, the whole set is used.
+    const order o(order_builder {"0"});
+    SDD s0(0, {0}, one);
+    const auto h = inductive<conf>(targeted_incr<conf>("0", 1));
+    ASSERT_EQ(SDD(0, {2}, one), fixpoint(h)(o, s0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_fixpoint_test, print)
+{
+  const order o(order_builder {"a"});
+  const auto h = sum<conf>(o, {inductive<conf>(targeted_incr<conf>("a", 1)), id});
+  std::stringstream frontier;
+  frontier << fixpoint(h);
+  std::stringstream whole;
+  whole << fixpoint(h, sdd::fixpoint_mode::whole);
+  std::stringstream chaining;
+  chaining << fixpoint(h, sdd::fixpoint_mode::chaining);
+  ASSERT_EQ(frontier.str() + "[whole]", whole.str());
+  ASSERT_EQ(frontier.str() + "[chaining]", chaining.str());
+  ASSERT_EQ('*', frontier.str().back());
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,192 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/footprint.hh"
+#include "sdd/hom/rewrite.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_footprint_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_footprint_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct add_value
+{
+  const unsigned int value_;
+
+  bool
+  selector()
+  const noexcept
+  {
+    return false;
+  }
+
+  template <typename T>
+  typename C::Values
+  operator()(const T& val)
+  const
+  {
+    T new_val = val;
+    new_val.insert(value_);
+    return new_val;
+  }
+
+  bool
+  operator==(const add_value& other)
+  const noexcept
+  {
+    return value_ == other.value_;
+  }
+};
+
+template <typename C>
+std::ostream&
+operator<<(std::ostream& os, const add_value<C>& f)
+{
+  return os << "add_value(" << f.value_ << ")";
+}
+
+namespace std {
+
+template <typename C>
+struct hash<add_value<C>>
+{
+  std::size_t
+  operator()(const add_value<C>& f)
+  const noexcept
+  {
+    return std::hash<unsigned int>()(f.value_);
+  }
+};
+
+} // namespace std
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_footprint_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_footprint_test, exact)
+{
+  // a is variable 2, c is variable 0.
+  const order o(order_builder {"a", "b", "c"});
+  {
+    const auto f = sdd::hom::get_footprint(o, id);
+    ASSERT_TRUE(f.variables.empty());
+    ASSERT_FALSE(f.open);
+  }
+  {
+    const auto f = sdd::hom::get_footprint(o, function<conf>(o, "b", add_value<conf>{2}));
+    ASSERT_EQ(std::vector<unsigned int>({1}), f.variables);
+    ASSERT_FALSE(f.open);
+  }
+  {
+    const auto h = sum<conf>(o, { function<conf>(o, "a", add_value<conf>{2})
+                                , function<conf>(o, "c", add_value<conf>{2})});
+    const auto f = sdd::hom::get_footprint(o, h);
+    ASSERT_EQ(std::vector<unsigned int>({0, 2}), f.variables);
+    ASSERT_FALSE(f.open);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_footprint_test, inductive)
+{
+  const order o(order_builder {"a", "b", "c"});
+  {
+    // Starts at the first variable it doesn't skip.
+    const auto f = sdd::hom::get_footprint(o, inductive<conf>(targeted_incr<conf>("b", 1)));
+    ASSERT_TRUE(f.variables.empty());
+    ASSERT_TRUE(f.open);
+    ASSERT_EQ(1u, f.top);
+  }
+  {
+    const auto h = composition( function<conf>(o, "a", add_value<conf>{2})
+                              , inductive<conf>(targeted_incr<conf>("c", 1)));
+    const auto f = sdd::hom::get_footprint(o, h);
+    ASSERT_EQ(std::vector<unsigned int>({2}), f.variables);
+    ASSERT_TRUE(f.open);
+    ASSERT_EQ(0u, f.top);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_footprint_test, meet)
+{
+  const order o(order_builder {"a", "b", "c"});
+  const auto fa = sdd::hom::get_footprint(o, function<conf>(o, "a", add_value<conf>{2}));
+  const auto fb = sdd::hom::get_footprint(o, function<conf>(o, "b", add_value<conf>{2}));
+  const auto ib = sdd::hom::get_footprint(o, inductive<conf>(targeted_incr<conf>("b", 1)));
+  const auto ic = sdd::hom::get_footprint(o, inductive<conf>(targeted_incr<conf>("c", 1)));
+  const auto none = sdd::hom::get_footprint(o, id);
+
+  ASSERT_TRUE(meet(fb, fb));
+  ASSERT_FALSE(meet(fa, fb));
+  ASSERT_FALSE(meet(fa, ib));
+  ASSERT_TRUE(meet(fb, ib));
+  ASSERT_TRUE(meet(ib, fb));
+  ASSERT_FALSE(meet(fb, ic));
+  ASSERT_TRUE(meet(ib, ic));
+  ASSERT_FALSE(meet(none, ib));
+  ASSERT_FALSE(meet(none, none));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_footprint_test, saturation)
+{
+  const order o(order_builder {"a", "b", "c"});
+  SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+
+  // F only touches c, G only touches b: they don't enable each other.
+  const auto f = fixpoint(sum<conf>(o, {inductive<conf>(targeted_incr<conf>("c", 1)), id}));
+  const std::vector<homomorphism> g{function<conf>(o, "b", add_value<conf>{2})};
+  const auto h = saturation_fixpoint(1, f, g.begin(), g.end(), id);
+
+  const auto fp = sdd::hom::get_footprint(o.next(), h);
+  ASSERT_EQ(std::vector<unsigned int>({1}), fp.variables);
+  ASSERT_TRUE(fp.open);
+  ASSERT_EQ(0u, fp.top);
+  ASSERT_FALSE(meet( sdd::hom::get_footprint(o.next(), f)
+                   , sdd::hom::get_footprint(o.next(), g.front())));
+
+  const auto r = fixpoint(sum<conf>(o, { inductive<conf>(targeted_incr<conf>("c", 1))
+                                      , function<conf>(o, "b", add_value<conf>{2})
+                                      , id}));
+  ASSERT_EQ(r(o, s0), h(o, s0));
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0,2}, SDD(0, {0,1,2}, one))), h(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
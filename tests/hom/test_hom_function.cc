@@ -35,6 +35,40 @@ struct hom_function_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+template <typename C>
+C
+function_cache_conf()
+noexcept
+{
+  auto c = small_conf<C>();
+  c.hom_function_cache_size = 1000;
+  return c;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_function_cache_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_function_cache_test()
+    : m(sdd::init(function_cache_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 template <typename C, bool Selector>
 struct threshold_fun
 {
@@ -114,6 +148,7 @@ struct hash<threshold_fun<C, Selector>>
 /*------------------------------------------------------------------------------------------------*/
 
 TYPED_TEST_CASE(hom_function_test, configurations);
+TYPED_TEST_CASE(hom_function_cache_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -240,3 +275,30 @@ TYPED_TEST(hom_function_test, evaluation_no_selector)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_function_cache_test, evaluation)
+{
+  const order o(order_builder {"a", "b", "c"});
+  // Two nodes of "b" with the same valuation.
+  const SDD s0 = SDD(2, {0}, SDD(1, {1,2,3}, SDD(0, {0}, one)))
+               + SDD(2, {1}, SDD(1, {1,2,3}, SDD(0, {1}, one)));
+  const auto h0 = function<conf>(o, "b", threshold_fun<conf, true>(2));
+  const SDD s1 = SDD(2, {0}, SDD(1, {1,2}, SDD(0, {0}, one)))
+               + SDD(2, {1}, SDD(1, {1,2}, SDD(0, {1}, one)));
+  ASSERT_EQ(s1, h0(o, s0));
+  ASSERT_EQ(1u, this->m.hom_function_cache_stats().misses);
+  ASSERT_EQ(1u, this->m.hom_function_cache_stats().hits);
+
+  // Another function on the same valuation.
+  const auto h1 = function<conf>(o, "b", threshold_fun<conf, false>(1));
+  const SDD s2 = SDD(2, {0}, SDD(1, {1}, SDD(0, {0}, one)))
+               + SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one)));
+  ASSERT_EQ(s2, h1(o, s0));
+  ASSERT_EQ(2u, this->m.hom_function_cache_stats().misses);
+  ASSERT_EQ(2u, this->m.hom_function_cache_stats().hits);
+
+  this->m.reset_hom_cache();
+  ASSERT_EQ(0u, this->m.hom_function_cache_stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
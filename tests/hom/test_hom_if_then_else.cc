@@ -264,3 +264,73 @@ TYPED_TEST(hom_if_then_else, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_if_then_else, split)
+{
+  auto& hom_cxt = sdd::global<conf>().hom_context;
+  const auto check = [&](const homomorphism& h, const order& o, const SDD& x)
+  {
+    const auto parts = sdd::hom::split(hom_cxt, h, o, x);
+    ASSERT_EQ(h(o, x), parts.accepted);
+    ASSERT_EQ(x - h(o, x), parts.rejected);
+  };
+  {
+    const order o(order_builder {"a", "b", "c"});
+    const auto s0 = SDD(2, {0}, SDD(1, {0}, SDD(0, {0,1,2}, one)))
+                  + SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one)))
+                  + SDD(2, {2}, SDD(1, {0,2}, SDD(0, {2}, one)))
+                  ;
+    const auto f_a = function(o, "a", filter(1));
+    const auto f_b = function(o, "b", filter(2));
+    const auto f_c = function(o, "c", filter(1));
+    check(f_a, o, s0);
+    check(f_b, o, s0);
+    check(f_c, o, s0);
+    check(sum(o, {f_a, f_c}), o, s0);
+    check(intersection(o, {f_a, f_c}), o, s0);
+    check(composition(f_b, f_c), o, s0);
+    check(if_then_else(f_a, f_b, f_c), o, s0);
+    check(if_then_else(f_a, id, f_c), o, s0);
+    check(id, o, s0);
+    check(f_a, o, one);
+    check(f_a, o, zero);
+
+    // A second split is found in the cache.
+    const auto hits = this->m.hom_split_cache_stats().hits;
+    check(f_a, o, s0);
+    ASSERT_LT(hits, this->m.hom_split_cache_stats().hits);
+
+    // Native splits don't compute differences of SDD.
+    const auto differences = this->m.sdd_difference_cache_stats().misses;
+    const auto s1 = SDD(2, {0,1,2,3}, SDD(1, {0,1,2,3}, SDD(0, {0,1,2,3}, one)));
+    const auto parts = sdd::hom::split(hom_cxt, intersection(o, {f_a, f_c}), o, s1);
+    ASSERT_EQ(SDD(2, {1,2,3}, SDD(1, {0,1,2,3}, SDD(0, {1,2,3}, one))), parts.accepted);
+    ASSERT_EQ(differences, this->m.sdd_difference_cache_stats().misses);
+  }
+  {
+    using ob = order_builder;
+    const order o(ob("x", ob("a")) << ob("y", ob("b")));
+    const SDD s0 = SDD(1, SDD(0, {0,1}, one), SDD(0, SDD(0, {1,2}, one), one))
+                 + SDD(1, SDD(0, {2}, one), SDD(0, SDD(0, {0}, one), one));
+    const auto f_a = function(o, "a", filter(1));
+    const auto f_b = function(o, "b", filter(1));
+    check(f_a, o, s0);
+    check(f_b, o, s0);
+    check(intersection(o, {f_a, f_b}), o, s0);
+    check(sum(o, {f_a, f_b}), o, s0);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_if_then_else, selectors_intersection)
+{
+  const order o(order_builder {"a", "b"});
+  const auto s0 = SDD(1, {0,1,2}, SDD(0, {0,1,2}, one));
+  const auto f_a = function(o, "a", filter(1));
+  const auto f_b = function(o, "b", filter(2));
+  ASSERT_EQ(SDD(1, {1,2}, SDD(0, {2}, one)), intersection(o, {f_a, f_b})(o, s0));
+  ASSERT_EQ(f_a(o, s0) & f_b(o, s0), intersection(o, {f_a, f_b})(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -384,7 +384,23 @@ struct hash<consume<C>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+// f0 and f1 are static inductives, cut is not.
+template <typename C>
+struct static_inductives_conf
+  : public C
+{
+  using static_inductives = sdd::util::list<f0<static_inductives_conf>, f1<static_inductives_conf>>;
+};
+
+template <typename C>
+struct hom_static_inductive_test
+  : public hom_inductive_test<static_inductives_conf<C>>
+{};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(hom_inductive_test, configurations);
+TYPED_TEST_CASE(hom_static_inductive_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -497,3 +513,51 @@ TYPED_TEST(hom_inductive_test, cut_path)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_static_inductive_test, construction)
+{
+  using static_f0 = sdd::hom::_static_inductive<conf, f0<conf>>;
+  {
+    const auto h1 = inductive<conf>(f0<conf>());
+    const auto h2 = inductive<conf>(f0<conf>());
+    ASSERT_EQ(h1, h2);
+    ASSERT_TRUE(sdd::mem::is<static_f0>(*h1));
+  }
+  {
+    const auto h1 = inductive<conf>(f0<conf>());
+    const auto h2 = inductive<conf>(f1<conf>());
+    ASSERT_NE(h1, h2);
+  }
+  {
+    const auto h1 = inductive<conf>(cut<conf>());
+    ASSERT_TRUE(sdd::mem::is<sdd::hom::_inductive<conf>>(*h1));
+    ASSERT_NE(h1, inductive<conf>(f0<conf>()));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_static_inductive_test, evaluation)
+{
+  {
+    order o (order_builder {"0", "1"});
+    const auto h1 = inductive<conf>(f0<conf>());
+    const auto h2 = inductive<conf>(f1<conf>());
+    ASSERT_TRUE(h1.selector() == false);
+    ASSERT_EQ( SDD(1, {1,2,3}, SDD(0, {2,3,4}, one))
+             , h2(o, h1(o, SDD(1, {0,1,2}, SDD(0, {0,1,2}, one)))));
+  }
+  {
+    order o (order_builder {"1", "0"});
+    const auto h1 = inductive<conf>(f1<conf>());
+    ASSERT_EQ(       SDD(1, {3,4,5}, SDD(0, {1,2,3}, one))
+             , h1(o, SDD(1, {1,2,3}, SDD(0, {1,2,3}, one))));
+  }
+  {
+    order o (order_builder {"a"});
+    const auto h1 = inductive<conf>(cut<conf>());
+    ASSERT_EQ(zero, h1(o, SDD(0, {0}, one)));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 
+#include <chrono>
 #include <stdexcept>
+#include <vector>
 
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
@@ -273,3 +275,93 @@ TYPED_TEST(hom_interruption_test, saturation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_interruption_test, cancellation)
+{
+  order o(order_builder {"2", "1", "0"});
+  SDD s0(o, [](const std::string&){return values_type{0};});
+  const SDD s1(2, {0}, SDD(1, {0}, SDD(0, {0,1,2}, one)));
+  const homomorphism h0 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("0", 1)), id}));
+  const homomorphism h1 = sdd::rewrite(o, h0);
+
+  sdd::cancellation_token token;
+  this->m.interruption().cancel_with(token);
+  token.cancel();
+  ASSERT_THROW(h0(o, s0), sdd::interrupted);
+  try
+  {
+    h1(o, s0);
+    FAIL();
+  }
+  catch (const sdd::interrupted& e)
+  {
+    ASSERT_EQ(sdd::interrupted::cause::cancelled, e.why());
+  }
+
+  // Evaluations can start again.
+  token.reset();
+  ASSERT_EQ(s1, h0(o, s0));
+  ASSERT_EQ(s1, h1(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_interruption_test, deadline)
+{
+  order o(order_builder {"2", "1", "0"});
+  SDD s0(o, [](const std::string&){return values_type{0};});
+  const SDD s1(2, {0}, SDD(1, {0}, SDD(0, {0,1,2}, one)));
+  const homomorphism h0 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("1", 1)), id}));
+  const homomorphism h1 = sdd::rewrite(o, h0);
+
+  this->m.interruption().deadline(std::chrono::steady_clock::now());
+  try
+  {
+    h0(o, s0);
+    FAIL();
+  }
+  catch (const sdd::interrupted& e)
+  {
+    ASSERT_EQ(sdd::interrupted::cause::deadline, e.why());
+  }
+  ASSERT_THROW(h1(o, s0), sdd::interrupted);
+
+  this->m.interruption().reset();
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0,1,2}, SDD(0, {0}, one))), h0(o, s0));
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0,1,2}, SDD(0, {0}, one))), h1(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_interruption_test, progress)
+{
+  order o(order_builder {"2", "1", "0"});
+  SDD s0(o, [](const std::string&){return values_type{0};});
+  const homomorphism h0 = fixpoint(sum(o, {inductive<conf>(targeted_incr<conf>("0", 1)), id}));
+
+  std::vector<sdd::hom::progress<conf>> reports;
+  this->m.interruption().on_progress( [&](const sdd::hom::progress<conf>& p){reports.push_back(p);}
+                                    , std::chrono::seconds(0));
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0}, SDD(0, {0,1,2}, one))), h0(o, s0));
+  ASSERT_FALSE(reports.empty());
+  ASSERT_EQ(1u, reports.front().iterations);
+  // The fixpoint is propagated to the level of "0".
+  ASSERT_EQ(SDD(0, {0}, one), reports.front().current);
+  ASSERT_EQ(1u, reports.front().nodes());
+  ASSERT_LE(1u, reports.front().live_nodes);
+  ASSERT_LT(reports.front().iterations, reports.back().iterations);
+  ASSERT_LE(reports.front().evaluations, reports.back().evaluations);
+  ASSERT_LE(reports.front().elapsed, reports.back().elapsed);
+
+  // The callback can stop the evaluation.
+  this->m.interruption().on_progress([](const sdd::hom::progress<conf>& p)
+                                     {
+                                       if (p.iterations > 1)
+                                       {
+                                         throw std::runtime_error("");
+                                       }
+                                     });
+  ASSERT_THROW(h0(o, SDD(o, [](const std::string&){return values_type{1};})), std::runtime_error);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/profiler.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_profiler_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_profiler_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_profiler_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_profiler_test, scopes)
+{
+  using profiler_type = sdd::hom::profiler<conf>;
+  using scope = typename profiler_type::scope;
+  profiler_type p;
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0,1}, one));
+  const auto h1 = inductive<conf>(targeted_incr<conf>("a", 1));
+  const auto h2 = inductive<conf>(targeted_incr<conf>("b", 1));
+
+  ASSERT_EQ(nullptr, p[h1]);
+  {
+    scope outer(p, h1, s0);
+    p.evaluated();
+    {
+      // A nested application of the same homomorphism.
+      scope inner(p, h1, s0);
+      p.evaluated();
+      {
+        scope other(p, h2, one);
+        other(SDD(one));
+      }
+      inner(SDD(s0));
+    }
+    {
+      // Found in the cache.
+      scope other(p, h2, one);
+      other(SDD(one));
+    }
+    outer(SDD(s0));
+  }
+
+  ASSERT_EQ(2u, p.profiles().size());
+
+  const auto p1 = p[h1];
+  ASSERT_NE(nullptr, p1);
+  ASSERT_EQ(2u, p1->calls);
+  ASSERT_EQ(0u, p1->hits);
+  ASSERT_EQ(2u, p1->misses);
+  ASSERT_EQ(2u, p1->input_arcs);
+  ASSERT_EQ(2u, p1->output_arcs);
+
+  const auto p2 = p[h2];
+  ASSERT_NE(nullptr, p2);
+  ASSERT_EQ(2u, p2->calls);
+  ASSERT_EQ(2u, p2->hits);
+  ASSERT_EQ(0u, p2->misses);
+  ASSERT_EQ(0u, p2->input_arcs);
+  ASSERT_EQ(0u, p2->output_arcs);
+  ASSERT_EQ(p2->inclusive, p2->exclusive);
+
+  // The time of the nested application of h1 is counted once, and the time of h2 is not part of
+  // the exclusive time of h1.
+  ASSERT_EQ(p1->inclusive, p1->exclusive + p2->inclusive);
+
+  p.clear();
+  ASSERT_EQ(nullptr, p[h1]);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_profiler_test, nested_rehash)
+{
+  using profiler_type = sdd::hom::profiler<conf>;
+  using scope = typename profiler_type::scope;
+  profiler_type p;
+  const SDD s0(0, {0,1}, one);
+  const auto h = sdd::constant<conf>(s0);
+  {
+    scope outer(p, h, s0);
+    // Enough new profiles to rehash them while the outer application is in progress.
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+      const SDD x(i / 64, {i % 64}, one);
+      scope inner(p, sdd::constant<conf>(x), x);
+      inner(SDD(x));
+    }
+    outer(SDD(s0));
+  }
+  ASSERT_EQ(1001u, p.profiles().size());
+  const auto profile = p[h];
+  ASSERT_NE(nullptr, profile);
+  ASSERT_EQ(1u, profile->calls);
+  ASSERT_EQ(1u, profile->hits);
+  ASSERT_EQ(1u, profile->input_arcs);
+  ASSERT_EQ(1u, profile->output_arcs);
+  ASSERT_LE(profile->exclusive, profile->inclusive);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+#ifdef LIBSDD_PROFILE
+TYPED_TEST(hom_profiler_test, applications)
+{
+  const order o(order_builder {"a", "b"});
+  const SDD s0(1, {0}, SDD(0, {0}, one));
+  const auto h = inductive<conf>(targeted_incr<conf>("b", 1));
+
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {1}, one)), h(o, s0));
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {1}, one)), h(o, s0));
+
+  const auto profile = this->m.hom_profiler()[h];
+  ASSERT_NE(nullptr, profile);
+  // Twice at the root, once on the successor.
+  ASSERT_EQ(3u, profile->calls);
+  ASSERT_EQ(1u, profile->hits);
+  ASSERT_EQ(2u, profile->misses);
+  ASSERT_LE(profile->exclusive, profile->inclusive);
+}
+#endif
+
+/*------------------------------------------------------------------------------------------------*/
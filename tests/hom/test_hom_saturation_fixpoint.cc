@@ -7,6 +7,7 @@
 #include "sdd/hom/rewrite.hh"
 #include "sdd/manager.hh"
 #include "sdd/order/order.hh"
+#include "sdd/tools/saturation_profile.hh"
 
 #include "tests/configuration.hh"
 #include "tests/hom/common.hh"
@@ -93,3 +94,38 @@ TYPED_TEST(hom_saturation_fixpoint_test, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_saturation_fixpoint_test, profile)
+{
+  const order o(order_builder {"a", "b", "c"});
+  SDD s0(2, {0}, SDD(1, {0}, SDD(0, {0}, one)));
+
+  const auto f = fixpoint(sum<conf>(o, {inductive<conf>(targeted_incr<conf>("c", 1)), id}));
+  const auto g0 = inductive<conf>(targeted_incr<conf>("b", 2));
+  const auto g1 = inductive<conf>(targeted_noop<conf>("b"));
+  const std::vector<homomorphism> g{g0, g1};
+  const auto h = saturation_fixpoint(1, f, g.begin(), g.end(), id);
+  ASSERT_EQ(SDD(2, {0}, SDD(1, {0,2}, SDD(0, {0,1,2}, one))), h(o, s0));
+
+  const auto profile = sdd::tools::saturation_profile(h);
+  ASSERT_EQ(2u, profile.size());
+  for (const auto& p : profile)
+  {
+    ASSERT_EQ(1u, p.variable);
+    if (p.operand == g0)
+    {
+      // Productive once, then applied again to the new states.
+      ASSERT_EQ(2u, p.firings);
+      ASSERT_EQ(1u, p.productive);
+    }
+    else
+    {
+      ASSERT_EQ(g1, p.operand);
+      ASSERT_LE(1u, p.firings);
+      ASSERT_GE(2u, p.firings);
+      ASSERT_EQ(0u, p.productive);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,161 @@
+#include <string>
+#include <utility> // make_pair
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/tools/nodes.hh"
+#include "sdd/tools/size.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+C
+skip_conf()
+noexcept
+{
+  auto c = small_conf<C>();
+  c.hom_skip_cache_period = 3;
+  return c;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_skip_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_skip_test()
+    : m(sdd::init(skip_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_skip_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_skip_test, cached_levels)
+{
+  const order o(order_builder {"a", "b", "c", "d", "e"});
+  const SDD x(4, {0}, SDD(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))));
+  const auto h = inductive<conf>(targeted_incr<conf>("e", 1));
+
+  ASSERT_EQ(SDD(4, {0}, SDD(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {1}, one))))), h(o, x));
+  // "b" and "c" are not cached, "a", "d" and "e" are.
+  ASSERT_EQ(3u, this->m.hom_cache_stats().misses);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_skip_test, shared_levels)
+{
+  const order o(order_builder {"a", "b", "c", "d", "e"});
+  const SDD y(1, {0}, SDD(0, {0}, one));
+  const SDD x = SDD(4, {0}, SDD(3, {0}, SDD(2, {0}, y)))
+              + SDD(4, {1}, SDD(3, {1}, SDD(2, {1}, y)));
+  const auto h = inductive<conf>(targeted_incr<conf>("e", 1));
+
+  const SDD z(1, {0}, SDD(0, {1}, one));
+  ASSERT_EQ( SDD(4, {0}, SDD(3, {0}, SDD(2, {0}, z))) + SDD(4, {1}, SDD(3, {1}, SDD(2, {1}, z)))
+           , h(o, x));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_skip_test, deep_flat_order)
+{
+  // Much deeper than the stack can hold one frame per level.
+  const auto depth = 100'000u;
+  std::vector<identifier_type> identifiers;
+  for (auto i = 0u; i < depth; ++i)
+  {
+    identifiers.push_back("v" + std::to_string(i));
+  }
+  const order o(order_builder(identifiers.begin(), identifiers.end()));
+  const auto last = identifiers.back();
+  const SDD x(o, [](const identifier_type&){return values_type {0};});
+  const SDD y(o, [&](const identifier_type& i){return values_type {i == last ? 1u : 0u};});
+
+  // Skip propagation.
+  const auto h = inductive<conf>(targeted_incr<conf>(last, 1));
+  ASSERT_EQ(y, h(o, x));
+
+  // Nested cons.
+  std::vector<order> positions;
+  for (auto current = o; not current.empty(); current = current.next())
+  {
+    positions.push_back(current);
+  }
+  auto cons_chain = id;
+  for (auto rit = positions.rbegin(); rit != positions.rend(); ++rit)
+  {
+    cons_chain = cons(*rit, values_type {0}, cons_chain);
+  }
+  ASSERT_EQ(x, cons_chain(o, one));
+
+  // Visitors.
+  ASSERT_EQ(std::make_pair(depth, 0u), sdd::tools::nodes(x));
+  ASSERT_LT(0u, sdd::tools::size(x));
+  ASSERT_EQ(1u, x.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_skip_test, remembered_positions)
+{
+  std::vector<identifier_type> identifiers;
+  for (auto i = 0u; i < 16; ++i)
+  {
+    identifiers.push_back("v" + std::to_string(i));
+  }
+  const order o(order_builder(identifiers.begin(), identifiers.end()));
+  std::vector<order> positions;
+  for (auto current = o; not current.empty(); current = current.next())
+  {
+    positions.push_back(current);
+  }
+  const auto h = sum(o, { inductive<conf>(targeted_incr<conf>("v5", 1))
+                        , inductive<conf>(targeted_incr<conf>("v11", 1))});
+  const auto skipped = [](const order& p)
+                       {
+                         return p.identifier().user() != "v5" and p.identifier().user() != "v11";
+                       };
+
+  // Positions requested out of order, so intervals are extended on both sides and merged.
+  for (auto i = 0u; i < positions.size(); i += 2)
+  {
+    ASSERT_EQ(skipped(positions[i]), h.skip(positions[i])) << i;
+  }
+  for (auto i = positions.size() - 1; i < positions.size(); i -= 2)
+  {
+    ASSERT_EQ(skipped(positions[i]), h.skip(positions[i])) << i;
+  }
+  for (const auto& p : positions)
+  {
+    ASSERT_EQ(skipped(p), h.skip(p));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -129,3 +129,31 @@ TYPED_TEST(hom_sum_test, evaluation)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_sum_test, predicates)
+{
+  const order o1(order_builder {"a", "b", "c"});
+  const homomorphism h1 = sum(o1, { inductive<conf>(targeted_noop<conf>("a"))
+                                  , inductive<conf>(targeted_noop<conf>("b"))});
+  const homomorphism h2 = sum(o1, { inductive<conf>(targeted_noop<conf>("a"))
+                                  , inductive<conf>(targeted_incr<conf>("b", 1))});
+  ASSERT_TRUE(h1.selector());
+  ASSERT_FALSE(h2.selector());
+
+  // Twice, to get the stored predicates.
+  for (auto i = 0; i < 2; ++i)
+  {
+    ASSERT_FALSE(h1.skip(o1));
+    ASSERT_FALSE(h1.skip(o1.next()));
+    ASSERT_TRUE(h1.skip(o1.next().next()));
+  }
+
+  // The same homomorphism on another order.
+  const order o2(order_builder {"c", "b"});
+  ASSERT_TRUE(h1.skip(o2));
+  ASSERT_FALSE(h1.skip(o2.next()));
+  ASSERT_TRUE(h1.skip(o1.next().next()));
+  ASSERT_FALSE(h1.skip(o1));
+}
+
+/*------------------------------------------------------------------------------------------------*/
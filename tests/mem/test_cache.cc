@@ -45,6 +45,19 @@ struct operation
   }
 };
 
+/// @brief Describe an operation without being one.
+struct key
+{
+  const std::size_t i_;
+
+  bool
+  operator==(const operation& op)
+  const
+  {
+    return i_ == op.i_;
+  }
+};
+
 namespace std {
 
 /*------------------------------------------------------------------------------------------------*/
@@ -60,6 +73,17 @@ struct hash<operation>
   }
 };
 
+template <>
+struct hash<key>
+{
+  std::size_t
+  operator()(const key& k)
+  const noexcept
+  {
+    return std::hash<std::size_t>()(k.i_);
+  }
+};
+
 /*------------------------------------------------------------------------------------------------*/
 
 } // namespace std
@@ -316,3 +340,342 @@ TEST(cache, exception)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, lru)
+{
+  cache<context, operation> c(cxt, 4); // 4 buckets, 3 entries
+  const auto& stats = c.statistics();
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(4u, c(operation(3)));
+  ASSERT_EQ(3u, c.size());
+  ASSERT_EQ(0u, stats.discarded);
+
+  // 1 becomes the most recent entry, 2 is then the oldest one.
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(1u, stats.hits);
+
+  ASSERT_EQ(5u, c(operation(4)));
+  ASSERT_EQ(3u, c.size());
+  ASSERT_EQ(1u, stats.discarded);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(4u, c(operation(3)));
+  ASSERT_EQ(5u, c(operation(4)));
+  ASSERT_EQ(4u, stats.hits);
+
+  // 2 was discarded.
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(4u, stats.hits);
+  ASSERT_EQ(2u, stats.discarded);
+
+  c.clear();
+  ASSERT_EQ(0u, c.size());
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(4u, c(operation(3)));
+  ASSERT_EQ(5u, c(operation(4)));
+  ASSERT_EQ(3u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, clear)
+{
+  cache<context, operation> c(cxt, 4); // 4 buckets, 3 entries
+  const auto& stats = c.statistics();
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(4u, c(operation(3)));
+  ASSERT_EQ(2u, c(operation(1)));
+  c.clear();
+  ASSERT_EQ(0u, c.size());
+
+  // Erased entries are no longer in the LRU order, thus 5 is the oldest entry.
+  ASSERT_EQ(6u, c(operation(5)));
+  ASSERT_EQ(7u, c(operation(6)));
+  ASSERT_EQ(8u, c(operation(7)));
+  ASSERT_EQ(0u, stats.discarded);
+  ASSERT_EQ(9u, c(operation(8))); // discards 5
+  ASSERT_EQ(3u, c.size());
+  ASSERT_EQ(1u, stats.discarded);
+  ASSERT_EQ(7u, c(operation(6)));
+  ASSERT_EQ(8u, c(operation(7)));
+  ASSERT_EQ(9u, c(operation(8)));
+  ASSERT_EQ(4u, stats.hits);
+
+  // Clearing an empty cache, or a cache twice, is harmless.
+  c.clear();
+  c.clear();
+  ASSERT_EQ(0u, c.size());
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(1u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, footprint)
+{
+  cache<context, operation> c(cxt, 100);
+  const auto& stats = c.statistics();
+  ASSERT_GE(stats.bytes_per_entry, sizeof(operation) + sizeof(std::size_t));
+  ASSERT_EQ(stats.bytes_per_entry * 108 + 128 * sizeof(void*), stats.footprint);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, key)
+{
+  cache<context, operation> c(cxt, 100);
+  const auto& stats = c.statistics();
+  unsigned int built = 0;
+  const auto make = [&](std::size_t i){return [&built, i]{++built; return operation(i);};};
+
+  ASSERT_EQ(2u, c(key{1}, make(1)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(1u, stats.misses);
+
+  ASSERT_EQ(2u, c(key{1}, make(1)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(1u, stats.hits);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(2u, stats.hits);
+
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(3u, c(key{2}, make(2)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(3u, stats.hits);
+  ASSERT_EQ(2u, stats.misses);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief An operation which is evaluated by the key describing it.
+struct stored_operation
+{
+  using result_type = std::size_t;
+
+  const std::size_t i_;
+
+  bool
+  operator==(const stored_operation& op)
+  const
+  {
+    return i_ == op.i_;
+  }
+};
+
+/// @brief Describe and evaluate a stored_operation.
+struct evaluating_key
+{
+  const std::size_t& i_;
+
+  std::size_t
+  operator()(context&)
+  const
+  {
+    return i_ + 1;
+  }
+
+  bool
+  operator==(const stored_operation& op)
+  const
+  {
+    return i_ == op.i_;
+  }
+};
+
+struct key_filter_0
+{
+  bool
+  operator()(const evaluating_key& k)
+  const noexcept
+  {
+    return k.i_ != 0;
+  }
+};
+
+namespace std {
+
+template <>
+struct hash<stored_operation>
+{
+  std::size_t
+  operator()(const stored_operation& op)
+  const noexcept
+  {
+    return std::hash<std::size_t>()(op.i_);
+  }
+};
+
+template <>
+struct hash<evaluating_key>
+{
+  std::size_t
+  operator()(const evaluating_key& k)
+  const noexcept
+  {
+    return std::hash<std::size_t>()(k.i_);
+  }
+};
+
+} // namespace std
+
+TEST(cache, evaluating_key)
+{
+  cache<context, stored_operation, key_filter_0> c(cxt, 100);
+  const auto& stats = c.statistics();
+  unsigned int built = 0;
+  const std::size_t zero = 0;
+  const std::size_t one = 1;
+  const auto make = [&](std::size_t i){return [&built, i]{++built; return stored_operation{i};};};
+
+  ASSERT_EQ(2u, c.evaluate(evaluating_key{one}, make(1)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(1u, stats.misses);
+
+  ASSERT_EQ(2u, c.evaluate(evaluating_key{one}, make(1)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(1u, stats.hits);
+
+  ASSERT_EQ(1u, c.evaluate(evaluating_key{zero}, make(0)));
+  ASSERT_EQ(1u, built);
+  ASSERT_EQ(1u, stats.filtered);
+  ASSERT_EQ(1u, c.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, shared_table)
+{
+  const auto table = std::make_shared<computed_table>(3);
+  cache<context, operation> c0(cxt, 100, table, "c0");
+  cache<context, operation> c1(cxt, 100, table, "c1");
+
+  ASSERT_EQ(2u, c0(operation(1)));
+  ASSERT_EQ(3u, c1(operation(2)));
+  ASSERT_EQ(4u, c0(operation(3)));
+  ASSERT_EQ(2u, c0.size());
+  ASSERT_EQ(1u, c1.size());
+
+  // The oldest entry belongs to c0.
+  ASSERT_EQ(2u, c0(operation(1))); // hit, now the most recent
+  ASSERT_EQ(5u, c1(operation(4))); // discards 2 from c1
+  ASSERT_EQ(2u, c0.size());
+  ASSERT_EQ(1u, c1.size());
+  ASSERT_EQ(1u, c1.statistics().discarded);
+  ASSERT_EQ(0u, c0.statistics().discarded);
+
+  ASSERT_EQ(6u, c1(operation(5))); // discards 3 from c0
+  ASSERT_EQ(1u, c0.size());
+  ASSERT_EQ(2u, c1.size());
+  ASSERT_EQ(1u, c0.statistics().discarded);
+
+  const auto stats = table->statistics();
+  ASSERT_EQ(3u, stats.capacity);
+  ASSERT_EQ(3u, stats.size);
+  ASSERT_EQ(2u, stats.discarded);
+  ASSERT_EQ(2u, stats.caches.size());
+  ASSERT_EQ("c0", stats.caches[0].first);
+  ASSERT_EQ(1u, stats.caches[0].second.hits);
+  ASSERT_EQ(2u, stats.caches[0].second.misses);
+  ASSERT_EQ("c1", stats.caches[1].first);
+  ASSERT_EQ(0u, stats.caches[1].second.hits);
+  ASSERT_EQ(3u, stats.caches[1].second.misses);
+
+  c1.clear();
+  ASSERT_EQ(1u, table->statistics().size);
+  ASSERT_EQ(3u, c1(operation(2)));
+  ASSERT_EQ(4u, c1(operation(3)));
+  ASSERT_EQ(1u, c0.size());
+  ASSERT_EQ(2u, c1.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, resize)
+{
+  const auto table = std::make_shared<computed_table>(4);
+  cache<context, operation> c0(cxt, 100, table, "c0");
+  cache<context, operation> c1(cxt, 100, table, "c1");
+
+  c0(operation(1));
+  c1(operation(2));
+  c0(operation(3));
+  c1(operation(4));
+  c0(operation(1)); // most recent
+
+  // Keep the 2 most recent entries.
+  table->resize(2);
+  ASSERT_EQ(2u, table->capacity());
+  ASSERT_EQ(1u, c0.size());
+  ASSERT_EQ(1u, c1.size());
+  ASSERT_EQ(2u, c0(operation(1)));
+  ASSERT_EQ(5u, c1(operation(4)));
+  ASSERT_EQ(2u, c0.statistics().hits);
+  ASSERT_EQ(1u, c1.statistics().hits);
+
+  // Entries are still found after having been relocated.
+  table->resize(8);
+  ASSERT_EQ(2u, c0(operation(1)));
+  ASSERT_EQ(5u, c1(operation(4)));
+  ASSERT_EQ(3u, c0.statistics().hits);
+  ASSERT_EQ(2u, c1.statistics().hits);
+  for (std::size_t i = 10; i < 16; ++i)
+  {
+    c0(operation(i));
+  }
+  ASSERT_EQ(8u, table->statistics().size);
+  ASSERT_EQ(2u, table->statistics().discarded);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(cache, adaptive)
+{
+  const auto budget = std::make_shared<cache_budget>(1024 * 1024);
+  {
+    cache<context, operation> c(cxt, 16, nullptr, "c", budget);
+    const auto initial = c.statistics().capacity;
+    ASSERT_EQ(13u, initial);
+
+    // Each new operation discards an entry, but half of the lookups are hits: grow.
+    for (std::size_t i = 1; i <= computed_table::min_window; ++i)
+    {
+      c(operation(0));
+      c(operation(i));
+    }
+    // Lookups don't resize the cache, it's left to adapt().
+    ASSERT_EQ(initial, c.statistics().capacity);
+    c.adapt();
+    ASSERT_EQ(2 * initial, c.statistics().capacity);
+    ASSERT_EQ(1u, c.statistics().grown);
+    ASSERT_EQ(0u, c.statistics().shrunk);
+    ASSERT_EQ(32u, c.statistics().buckets);
+    ASSERT_EQ(2 * initial * c.statistics().bytes_per_entry, budget->used());
+
+    // No more hits: shrink.
+    for (std::size_t i = 1; i <= computed_table::min_window; ++i)
+    {
+      c(operation(10000 + i));
+    }
+    c.adapt();
+    ASSERT_EQ(initial, c.statistics().capacity);
+    ASSERT_EQ(1u, c.statistics().shrunk);
+    ASSERT_EQ(initial, c.size());
+    ASSERT_EQ(16u, c.statistics().buckets);
+    ASSERT_EQ(initial * c.statistics().bytes_per_entry, budget->used());
+
+    // The most recent entries were kept.
+    const auto hits = c.statistics().hits;
+    const std::size_t last = 10000 + computed_table::min_window;
+    ASSERT_EQ(last + 1, c(operation(last)));
+    ASSERT_EQ(hits + 1, c.statistics().hits);
+  }
+  ASSERT_EQ(0u, budget->used());
+}
+
+/*------------------------------------------------------------------------------------------------*/
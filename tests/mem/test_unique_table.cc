@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <cstdint>
+
 #include "sdd/mem/hash_table.hh"
 #include "sdd/mem/unique_table.hh"
 
@@ -10,9 +12,18 @@ namespace {
 struct foo
 {
   sdd::mem::intrusive_member_hook<foo> hook;
+  std::uint32_t id_;
   int i_;
 
-  foo(int i) : i_(i) {}
+  foo(int i) : id_(0), i_(i) {}
+
+  // Needed by unique_table to give dense identifiers.
+  std::uint32_t
+  id()
+  const noexcept
+  {
+    return id_;
+  }
 
   bool
   operator==(const foo& other)
@@ -37,6 +48,16 @@ struct foo
   }
 };
 
+struct parity_partitioner
+{
+  std::size_t
+  operator()(const foo& f)
+  const noexcept
+  {
+    return static_cast<std::size_t>(f.i_ % 2);
+  }
+};
+
 }
 
 namespace std {
@@ -92,4 +113,73 @@ TEST(unique_table_test, insertion)
   }
 }
 
-/*------------------------------------------------------------------------------------------------*/
\ No newline at end of file
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, identifiers)
+{
+  sdd::mem::unique_table<foo> ut(100);
+
+  const foo& i1 = ut(new (ut.allocate(0)) foo(42), 0);
+  const foo& i2 = ut(new (ut.allocate(0)) foo(43), 0);
+  ASSERT_NE(i1.id(), i2.id());
+  ASSERT_EQ(2u, ut.identifiers_bound());
+
+  const auto id1 = i1.id();
+  ut.erase(&i1);
+  const foo& i3 = ut(new (ut.allocate(0)) foo(44), 0);
+  ASSERT_EQ(id1, i3.id());
+  ASSERT_EQ(2u, ut.identifiers_bound());
+
+  ut.erase(&i2);
+  ut.erase(&i3);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, partitions)
+{
+  {
+    sdd::mem::unique_table<foo, sdd::mem::no_observer, parity_partitioner> ut(100, true);
+
+    const foo& i1 = ut(new (ut.allocate(0, 0)) foo(42), 0);
+    const foo& i2 = ut(new (ut.allocate(0, 1)) foo(43), 0);
+    const foo& i3 = ut(new (ut.allocate(0, 0)) foo(44), 0);
+    const foo& i4 = ut(new (ut.allocate(0, 0)) foo(42), 0);
+    ASSERT_EQ(&i1, &i4);
+
+    ASSERT_EQ(2u, ut.nb_partitions());
+    ASSERT_EQ(3u, ut.stats().size);
+    ASSERT_EQ(1u, ut.stats().hits);
+
+    const auto stats = ut.partitions_stats();
+    ASSERT_EQ(2u, stats.size());
+    ASSERT_EQ(2u, stats[0].size);
+    ASSERT_EQ(1u, stats[0].hits);
+    ASSERT_EQ(2u, stats[0].misses);
+    ASSERT_EQ(1u, stats[1].size);
+    ASSERT_EQ(0u, stats[1].hits);
+
+    int sum = 0;
+    ut.for_each(0, [&](const foo& f){sum += f.i_;});
+    ASSERT_EQ(86, sum);
+
+    ut.erase(&i1);
+    ut.erase(&i2);
+    ut.erase(&i3);
+    ASSERT_EQ(0u, ut.stats().size);
+    ASSERT_EQ(0u, ut.partitions_stats()[0].size);
+  }
+  {
+    // Partitioning disabled.
+    sdd::mem::unique_table<foo, sdd::mem::no_observer, parity_partitioner> ut(100);
+
+    const foo& i1 = ut(new (ut.allocate(0, 0)) foo(42), 0);
+    const foo& i2 = ut(new (ut.allocate(0, 1)) foo(43), 0);
+    ASSERT_EQ(1u, ut.nb_partitions());
+    ASSERT_EQ(2u, ut.partitions_stats()[0].size);
+    ut.erase(&i1);
+    ut.erase(&i2);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
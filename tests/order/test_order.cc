@@ -1,8 +1,10 @@
 #include <algorithm> // shuffle, sort
 #include <random>
+#include <string>
 
 #include "gtest/gtest.h"
 
+#include "sdd/manager.hh"
 #include "sdd/order/order.hh"
 
 #include "tests/configuration.hh"
@@ -14,6 +16,12 @@ struct order_test
   : public testing::Test
 {
   using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  order_test()
+    : m(sdd::init(small_conf<C>()))
+  {}
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -152,3 +160,69 @@ TYPED_TEST(order_test, constructed_order)
 }
 
 /*-------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_test, interning)
+{
+  const auto mk = []
+  {
+    order_builder ob;
+    ob.push("c").push("x", order_builder {"a", "b"});
+    return ob;
+  };
+  const order o0(mk());
+  {
+    const order o1(mk());
+    // Equal orders share the same nodes.
+    ASSERT_EQ(&o0.nodes(), &o1.nodes());
+    ASSERT_EQ(o0, o1);
+    ASSERT_EQ(std::hash<order>()(o0), std::hash<order>()(o1));
+    ASSERT_EQ(o0.next(), o1.next());
+    ASSERT_EQ(o0.nested().next(), o1.nested().next());
+    ASSERT_FALSE(o0 == o0.next());
+  }
+  {
+    order_builder ob;
+    ob.push("c").push("x", order_builder {"b", "a"});
+    const order o1(ob);
+    ASSERT_NE(&o0.nodes(), &o1.nodes());
+    ASSERT_FALSE(o0 == o1);
+    // Same structure up to this level, but different nested identifiers.
+    ASSERT_FALSE(o0.next() == o1.next());
+  }
+  {
+    // Copies own the nodes, cursors given by next() and nested() only borrow them.
+    auto& registry = sdd::global<conf>().order_registry;
+    registry.sweep();
+    const auto nb_orders = registry.size();
+    {
+      const auto o1 = []
+      {
+        const order o(order_builder {"u", "v"});
+        const auto next = o.next();
+        return order(next);
+      }();
+      registry.sweep();
+      ASSERT_EQ(nb_orders + 1, registry.size());
+      ASSERT_EQ("v", o1.identifier().user());
+      ASSERT_EQ(order(order_builder {"u", "v"}).next(), o1);
+    }
+    registry.sweep();
+    ASSERT_EQ(nb_orders, registry.size());
+  }
+  {
+    // Nodes of dead orders are released when new ones are built.
+    auto& registry = sdd::global<conf>().order_registry;
+    registry.sweep();
+    const auto nb_orders = registry.size();
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+      const order o1(order_builder {std::to_string(i)});
+      ASSERT_EQ(std::to_string(i), o1.identifier().user());
+    }
+    ASSERT_LT(registry.size(), nb_orders + 1000);
+  }
+  ASSERT_EQ(order(order_builder()), order(order_builder()));
+  ASSERT_EQ(order(order_builder()), o0.next().next());
+}
+
+/*-------------------------------------------------------------------------------------------*/
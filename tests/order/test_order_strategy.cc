@@ -1,7 +1,19 @@
+#include <algorithm> // min, min_element
+#include <cstdlib>   // abs
+#include <map>
+#include <string>    // to_string
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "sdd/manager.hh"
 #include "sdd/order/order.hh"
 #include "sdd/order/strategies/flatten.hh"
+#include "sdd/order/strategies/force.hh"
+#include "sdd/order/strategies/multilevel_partitioning.hh"
+#include "sdd/order/strategies/reverse_cuthill_mckee.hh"
+#include "sdd/order/strategies/simulated_annealing.hh"
+#include "sdd/order/strategies/sloan.hh"
 
 #include "tests/configuration.hh"
 
@@ -12,6 +24,12 @@ struct order_strategy_test
   : public testing::Test
 {
   using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  order_strategy_test()
+    : m(sdd::init(small_conf<C>()))
+  {}
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -60,4 +78,206 @@ TYPED_TEST(order_strategy_test, strategy_flatten)
   }
 }
 
-/*-------------------------------------------------------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_strategy_test, strategy_force)
+{
+  // A chain a - b - c - d - e - f, inserted in a scrambled order.
+  const std::vector<identifier_type> ids {"c", "f", "a", "d", "b", "e"};
+  const std::vector<std::vector<identifier_type>> edges
+    = {{"a", "b"}, {"b", "c"}, {"c", "d"}, {"d", "e"}, {"e", "f"}};
+  const auto mk_graph = [&]
+  {
+    sdd::force::hypergraph<conf> g(ids.begin(), ids.end());
+    for (const auto& e : edges)
+    {
+      g.add_hyperedge(e.begin(), e.end());
+    }
+    return g;
+  };
+  const auto positions_span = [](const std::vector<identifier_type>& positions)
+  {
+    std::map<identifier_type, int> pos;
+    int p = 0;
+    for (const auto& identifier : positions)
+    {
+      pos[identifier] = p++;
+    }
+    return std::abs(pos["a"] - pos["b"]) + std::abs(pos["b"] - pos["c"])
+         + std::abs(pos["c"] - pos["d"]) + std::abs(pos["d"] - pos["e"])
+         + std::abs(pos["e"] - pos["f"]);
+  };
+  const auto span = [&](const order& o)
+  {
+    std::vector<identifier_type> positions;
+    for (auto cit = o; not cit.empty(); cit = cit.next())
+    {
+      positions.push_back(cit.identifier().user());
+    }
+    return positions_span(positions);
+  };
+
+  {
+    auto g = mk_graph();
+    sdd::force::worker<conf> w(g);
+    const order o(w(100));
+    // The returned order is the best one seen, including the initial one.
+    ASSERT_FALSE(w.spans().empty());
+    const auto best = std::min( static_cast<double>(positions_span(ids))
+                              , *std::min_element(w.spans().begin(), w.spans().end()));
+    ASSERT_EQ(best, span(o));
+    ASSERT_LE(w.spans().size(), 100u);
+    ASSERT_EQ(1u, w.nb_runs());
+  }
+  {
+    // Iterations are split among threads on large hypergraphs, without changing the result.
+    std::vector<identifier_type> chain;
+    for (auto i = 0u; i < 10000; ++i)
+    {
+      chain.push_back(std::to_string((i * 7919) % 10000));
+    }
+    const auto mk_chain = [&]
+    {
+      sdd::force::hypergraph<conf> g(chain.begin(), chain.end());
+      for (auto i = 0u; i + 1 < chain.size(); ++i)
+      {
+        const std::vector<identifier_type> e {std::to_string(i), std::to_string(i + 1)};
+        g.add_hyperedge(e.begin(), e.end());
+      }
+      return g;
+    };
+    auto g0 = mk_chain();
+    auto g1 = mk_chain();
+    sdd::force::options opt;
+    opt.iterations = 20;
+    sdd::force::worker<conf> w0(g0);
+    const order o0(w0(opt));
+    opt.threads = 3;
+    sdd::force::worker<conf> w1(g1);
+    ASSERT_EQ(o0, order(w1(opt)));
+    ASSERT_EQ(w0.spans(), w1.spans());
+  }
+  {
+    auto g = mk_graph();
+    sdd::force::worker<conf> w(g);
+    sdd::force::options opt;
+    opt.iterations = 100;
+    opt.runs = 8;
+    opt.threads = 4;
+    const order o(w(opt));
+    ASSERT_EQ(8u, w.nb_runs());
+    ASSERT_EQ(5, span(o));
+    for (std::size_t r = 0; r < w.nb_runs(); ++r)
+    {
+      for (const auto s : w.spans(r))
+      {
+        ASSERT_LE(5, s);
+      }
+    }
+    ASSERT_EQ(w.spans(w.best_run()), w.spans());
+  }
+  {
+    // Same seed, same result.
+    auto g0 = mk_graph();
+    auto g1 = mk_graph();
+    sdd::force::options opt;
+    opt.runs = 4;
+    opt.threads = 2;
+    ASSERT_EQ( order(sdd::force::worker<conf>(g0)(opt))
+             , order(sdd::force::worker<conf>(g1)(opt)));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_strategy_test, strategy_multilevel_partitioning)
+{
+  // Two cliques, {a, c, e, g} and {b, d, f, h}, linked by a single hyperedge.
+  const std::vector<identifier_type> ids {"a", "b", "c", "d", "e", "f", "g", "h"};
+  sdd::force::hypergraph<conf> g(ids.begin(), ids.end());
+  const std::vector<std::vector<identifier_type>> edges
+    = { {"a", "c"}, {"a", "e"}, {"a", "g"}, {"c", "e"}, {"c", "g"}, {"e", "g"}
+      , {"b", "d"}, {"b", "f"}, {"b", "h"}, {"d", "f"}, {"d", "h"}, {"f", "h"}
+      , {"g", "h"}};
+  for (const auto& e : edges)
+  {
+    g.add_hyperedge(e.begin(), e.end());
+  }
+
+  {
+    const auto ob = sdd::multilevel_partitioning<conf>(g, 4)();
+    ASSERT_EQ(2u, ob.height());
+    ASSERT_TRUE(ob.identifier().artificial());
+    ASSERT_EQ(order(order_builder {"a", "c", "e", "g"}), order(ob.nested()));
+    ASSERT_EQ(order(order_builder {"b", "d", "f", "h"}), order(ob.next().nested()));
+  }
+  {
+    // Leaves have at most 2 identifiers, parts are perfectly balanced.
+    const auto ob = sdd::multilevel_partitioning<conf>(g, 2, 0)();
+    ASSERT_EQ(2u, ob.height());
+    for (const auto& part : {ob.nested(), ob.next().nested()})
+    {
+      ASSERT_EQ(2u, part.height());
+      ASSERT_EQ(2u, part.nested().height());
+      ASSERT_EQ(2u, part.next().nested().height());
+    }
+    const order flat(flatten()(ob.nested()));
+    for (const auto& i : {"a", "c", "e", "g"})
+    {
+      ASSERT_NO_THROW(flat.node(i));
+    }
+  }
+  {
+    // Everything fits in a single leaf.
+    const auto ob = sdd::multilevel_partitioning<conf>(g, 8)();
+    ASSERT_EQ(order(order_builder(ids.begin(), ids.end())), order(ob));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_strategy_test, strategy_bandwidth)
+{
+  // A chain a - b - c - d - e - f, inserted in a scrambled order.
+  const std::vector<identifier_type> ids {"c", "f", "a", "d", "b", "e"};
+  sdd::force::hypergraph<conf> g(ids.begin(), ids.end());
+  const std::vector<std::vector<identifier_type>> edges
+    = {{"a", "b"}, {"b", "c"}, {"c", "d"}, {"d", "e"}, {"e", "f"}};
+  for (const auto& e : edges)
+  {
+    g.add_hyperedge(e.begin(), e.end());
+  }
+  const order chain(order_builder {"a", "b", "c", "d", "e", "f"});
+  const order reversed_chain(order_builder {"f", "e", "d", "c", "b", "a"});
+  const auto is_chain = [&](const order& o){return o == chain or o == reversed_chain;};
+
+  ASSERT_TRUE(is_chain(order(sdd::reverse_cuthill_mckee<conf>(g)())));
+  ASSERT_TRUE(is_chain(order(sdd::sloan<conf>(g)())));
+  ASSERT_TRUE(is_chain(order(sdd::simulated_annealing<conf>(g, 200)())));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_strategy_test, strategy_bandwidth_components)
+{
+  // Two disconnected components and an isolated identifier.
+  const std::vector<identifier_type> ids {"a", "x", "b", "y", "c", "z"};
+  sdd::force::hypergraph<conf> g(ids.begin(), ids.end());
+  const std::vector<std::vector<identifier_type>> edges = {{"a", "b", "c"}, {"x", "y"}};
+  for (const auto& e : edges)
+  {
+    g.add_hyperedge(e.begin(), e.end());
+  }
+  for (const auto& ob : { sdd::reverse_cuthill_mckee<conf>(g)(), sdd::sloan<conf>(g)()
+                        , sdd::simulated_annealing<conf>(g)()})
+  {
+    ASSERT_EQ(6u, ob.size());
+    const order o(ob);
+    for (const auto& i : ids)
+    {
+      ASSERT_NO_THROW(o.node(i));
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,73 @@
+#include <string>
+#include <utility> // pair
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/tools/order_evaluation.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct order_evaluation_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::homomorphism<C> id;
+
+  order_evaluation_test()
+    : m(sdd::init(small_conf<C>()))
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(order_evaluation_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(order_evaluation_test, evaluate)
+{
+  const std::vector<std::pair<std::string, order_builder>> candidates
+    = {{"abc", order_builder {"a", "b", "c"}}, {"acb", order_builder {"a", "c", "b"}}};
+
+  // The step adds a constant set of states: the fixpoint is detected at the second iteration.
+  const auto model = [this](const order& o)
+  {
+    const SDD m0(o, [](const std::string&){return values_type {0};});
+    const SDD m1(o, [](const std::string& i){return i == "b" ? values_type {0} : values_type {1};});
+    return std::make_pair(m0, sdd::sum(o, {id, sdd::constant(m1)}));
+  };
+
+  const auto res = sdd::tools::evaluate_orders<conf>(candidates, model, 10);
+  ASSERT_EQ(2u, res.size());
+  for (const auto& e : res)
+  {
+    ASSERT_EQ(3u, e.initial_nodes);
+    ASSERT_EQ(2u, e.iterations);
+    ASSERT_TRUE(e.fixpoint);
+    ASSERT_EQ(2, e.states);
+    ASSERT_LE(e.final_nodes, e.peak_nodes);
+  }
+  ASSERT_EQ("abc", res[0].name);
+  // a and c are correlated, b is not: keeping a and c adjacent is better.
+  ASSERT_EQ(5u, res[0].final_nodes);
+  ASSERT_EQ(4u, res[1].final_nodes);
+
+  // The bound is respected.
+  const auto bounded = sdd::tools::evaluate_orders<conf>(candidates, model, 1);
+  ASSERT_EQ(1u, bounded[0].iterations);
+  ASSERT_FALSE(bounded[0].fixpoint);
+}
+
+/*------------------------------------------------------------------------------------------------*/
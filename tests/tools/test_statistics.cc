@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/manager.hh"
+#include "sdd/tools/arcs.hh"
+#include "sdd/tools/nodes.hh"
+#include "sdd/tools/sdd_statistics.hh"
+#include "sdd/tools/size.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct statistics_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  statistics_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(statistics_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(statistics_test, terminals)
+{
+  {
+    const auto stats = sdd::tools::statistics(zero);
+    ASSERT_EQ(std::make_pair(0u, 0u), stats.all_nodes());
+    ASSERT_EQ(std::make_pair(0u, 0u), stats.all_arcs());
+    ASSERT_EQ(sdd::tools::size(zero), stats.bytes());
+    ASSERT_TRUE(stats.variables().empty());
+  }
+  {
+    sdd::tools::statistics_request request;
+    request.paths = true;
+    const auto stats = sdd::tools::statistics(one, request);
+    ASSERT_EQ(std::make_pair(0u, 0u), stats.all_nodes());
+    ASSERT_EQ(sdd::tools::size(one), stats.bytes());
+    ASSERT_EQ(1, stats.paths());
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(statistics_test, flat_sdd)
+{
+  const SDD x = SDD(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one))))
+              + SDD(3, {0}, SDD(2, {1}, SDD(1, {1}, SDD(0, {0}, one))))
+              + SDD(3, {2}, SDD(2, {2}, SDD(1, {2}, SDD(0, {2}, one))))
+              + SDD(3, {2}, SDD(2, {3}, SDD(1, {3}, SDD(0, {2}, one))));
+  sdd::tools::statistics_request request;
+  request.paths = true;
+  const auto stats = sdd::tools::statistics(x, request);
+  ASSERT_EQ(sdd::tools::size(x), stats.bytes());
+  ASSERT_EQ(sdd::tools::nodes(x), stats.all_nodes());
+  ASSERT_EQ(sdd::tools::arcs(x), stats.arcs_frequency());
+  ASSERT_EQ(sdd::tools::number_of_arcs(sdd::tools::arcs(x)), stats.all_arcs());
+  ASSERT_EQ(x.size(), stats.paths());
+  ASSERT_EQ(4u, stats.variables().size());
+  ASSERT_EQ(std::make_pair(1u, 2u), stats.variables().at(3));
+  ASSERT_EQ(std::make_pair(2u, 4u), stats.variables().at(2));
+  ASSERT_EQ(std::make_pair(4u, 4u), stats.variables().at(1));
+  ASSERT_EQ(std::make_pair(2u, 2u), stats.variables().at(0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(statistics_test, hierarchical_sdd)
+{
+  const SDD nested0(3, {0}, SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one))));
+  const SDD nested1(3, {1}, SDD(2, {1}, SDD(1, {1}, SDD(0, {1}, one))));
+  const SDD x = SDD(1, nested0, SDD(0, nested0, one))
+              + SDD(1, nested1, SDD(0, nested1, one));
+  sdd::tools::statistics_request request;
+  request.paths = true;
+  const auto stats = sdd::tools::statistics(x, request);
+  ASSERT_EQ(sdd::tools::size(x), stats.bytes());
+  ASSERT_EQ(sdd::tools::nodes(x), stats.all_nodes());
+  ASSERT_EQ(sdd::tools::arcs(x), stats.arcs_frequency());
+  ASSERT_EQ(std::make_pair(8u, 4u), stats.all_arcs());
+  ASSERT_EQ(x.size(), stats.paths());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(statistics_test, request)
+{
+  const SDD x = SDD(1, {0}, SDD(0, {0}, one)) + SDD(1, {1}, SDD(0, {1}, one));
+  sdd::tools::statistics_request request;
+  request.bytes = false;
+  request.arcs = false;
+  request.variables = false;
+  const auto stats = sdd::tools::statistics(x, request);
+  ASSERT_EQ(0u, stats.bytes());
+  ASSERT_TRUE(stats.arcs_frequency().empty());
+  ASSERT_TRUE(stats.variables().empty());
+  ASSERT_EQ(0, stats.paths());
+  ASSERT_EQ(std::make_pair(3u, 0u), stats.all_nodes());
+  ASSERT_EQ(std::make_pair(4u, 0u), stats.all_arcs());
+}
+
+/*------------------------------------------------------------------------------------------------*/
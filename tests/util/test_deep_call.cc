@@ -0,0 +1,59 @@
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "sdd/util/deep_call.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using namespace sdd::util;
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+unsigned int
+depth(unsigned int n)
+{
+  return n == 0 ? 0 : 1 + deep_call([&]{return depth(n - 1);});
+}
+
+unsigned int
+throw_at_bottom(unsigned int n)
+{
+  if (n == 0)
+  {
+    throw std::runtime_error("bottom");
+  }
+  return 1 + deep_call([&]{return throw_at_bottom(n - 1);});
+}
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(deep_call_test, shallow)
+{
+  ASSERT_EQ(10u, depth(10));
+  ASSERT_EQ(nullptr, stack_segment_start());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(deep_call_test, deep)
+{
+  // Much deeper than the stack can hold.
+  ASSERT_EQ(1'000'000u, depth(1'000'000));
+  ASSERT_EQ(nullptr, stack_segment_start());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(deep_call_test, exception)
+{
+  ASSERT_THROW(throw_at_bottom(100'000), std::runtime_error);
+  ASSERT_EQ(nullptr, stack_segment_start());
+  ASSERT_EQ(100'000u, depth(100'000));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,145 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/util/trace.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using namespace sdd::trace;
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+std::size_t
+count(const std::string& str, const std::string& pattern)
+{
+  std::size_t res = 0;
+  for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+  {
+    ++res;
+  }
+  return res;
+}
+
+} // namespace anonymous
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(trace_test, ring_buffer)
+{
+  ring_buffer buffer(3); // rounded up to 4
+  for (auto i = 0u; i < 4; ++i)
+  {
+    ASSERT_TRUE(buffer.push({"e", 'i', i, nullptr, 0}));
+  }
+  ASSERT_FALSE(buffer.push({"e", 'i', 4, nullptr, 0}));
+
+  std::vector<std::uint64_t> dates;
+  buffer.drain([&](const event& e){dates.push_back(e.date);});
+  ASSERT_EQ((std::vector<std::uint64_t>{0, 1, 2, 3}), dates);
+
+  ASSERT_TRUE(buffer.push({"e", 'i', 5, nullptr, 0}));
+  dates.clear();
+  buffer.drain([&](const event& e){dates.push_back(e.date);});
+  ASSERT_EQ((std::vector<std::uint64_t>{5}), dates);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(trace_test, tracer)
+{
+  std::stringstream ss;
+  {
+    tracer t(ss);
+    ASSERT_EQ(&t, tracer::current().load());
+    ASSERT_THROW(tracer{ss}, std::runtime_error);
+    const auto outer = t.begin("outer", false, "variable", 3);
+    ASSERT_TRUE(outer);
+    t.instant("flush");
+    t.end("outer", outer, "rounds", 2);
+  }
+  ASSERT_EQ(nullptr, tracer::current().load());
+
+  const auto str = ss.str();
+  ASSERT_EQ(0u, str.find("{\"traceEvents\":["));
+  ASSERT_EQ(1u, count(str, "\"name\":\"outer\",\"ph\":\"B\""));
+  ASSERT_EQ(1u, count(str, "\"name\":\"outer\",\"ph\":\"E\""));
+  ASSERT_EQ(1u, count(str, "\"name\":\"flush\",\"ph\":\"i\""));
+  ASSERT_EQ(1u, count(str, "\"args\":{\"variable\":3}"));
+  ASSERT_EQ(1u, count(str, "\"args\":{\"rounds\":2}"));
+  ASSERT_EQ(1u, count(str, "\"dropped\":0"));
+  ASSERT_LT(str.find("\"ph\":\"B\""), str.find("\"ph\":\"E\""));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(trace_test, sampling_and_depth)
+{
+  std::stringstream ss;
+  {
+    tracer t(ss, 1024, 2 /* sampling */, 2 /* max depth */);
+    // Sampled spans: only one out of two is recorded.
+    for (auto i = 0u; i < 4; ++i)
+    {
+      t.end("sampled", t.begin("sampled", true, nullptr, 0), nullptr, 0);
+    }
+    // Depth limit.
+    const auto d1 = t.begin("d1", false, nullptr, 0);
+    const auto d2 = t.begin("d2", false, nullptr, 0);
+    const auto d3 = t.begin("d3", false, nullptr, 0);
+    ASSERT_TRUE(d1);
+    ASSERT_TRUE(d2);
+    ASSERT_FALSE(d3);
+    t.end("d3", d3, nullptr, 0);
+    t.end("d2", d2, nullptr, 0);
+    t.end("d1", d1, nullptr, 0);
+  }
+  const auto str = ss.str();
+  ASSERT_EQ(2u, count(str, "\"name\":\"sampled\",\"ph\":\"B\""));
+  ASSERT_EQ(2u, count(str, "\"name\":\"sampled\",\"ph\":\"E\""));
+  ASSERT_EQ(1u, count(str, "\"name\":\"d2\",\"ph\":\"E\""));
+  ASSERT_EQ(0u, count(str, "\"name\":\"d3\""));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(trace_test, dropped)
+{
+  std::stringstream ss;
+  {
+    // The background thread doesn't have time to empty the buffer.
+    tracer t(ss, 2, 1, 10, std::chrono::milliseconds(200));
+    for (auto i = 0u; i < 10; ++i)
+    {
+      t.instant("i");
+    }
+    ASSERT_LE(6u, t.dropped());
+  }
+  ASSERT_EQ(0u, count(ss.str(), "\"dropped\":0"));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+#ifdef LIBSDD_TRACE
+TEST(trace_test, scope)
+{
+  std::stringstream ss;
+  {
+    tracer t(ss);
+    {
+      scope s("span", false, "variable", 1);
+      s.result("iterations", 2);
+    }
+    instant("flush");
+  }
+  ASSERT_EQ(1u, count(ss.str(), "\"args\":{\"variable\":1}"));
+  ASSERT_EQ(1u, count(ss.str(), "\"args\":{\"iterations\":2}"));
+  ASSERT_EQ(1u, count(ss.str(), "\"name\":\"flush\""));
+}
+#endif
+
+/*------------------------------------------------------------------------------------------------*/